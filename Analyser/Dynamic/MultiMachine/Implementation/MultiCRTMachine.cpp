@@ -8,41 +8,49 @@
 
 #include "MultiCRTMachine.hpp"
 
-#include <condition_variable>
 #include <mutex>
+#include <thread>
 
 using namespace Analyser::Dynamic;
 
 MultiCRTMachine::MultiCRTMachine(const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines, std::recursive_mutex &machines_mutex) :
-	machines_(machines), machines_mutex_(machines_mutex), queues_(machines.size()) {
+	machines_(machines), machines_mutex_(machines_mutex), jobs_(machines.size()) {
 	speaker_ = MultiSpeaker::create(machines);
 }
 
-void MultiCRTMachine::perform_parallel(const std::function<void(::CRTMachine::Machine *)> &function) {
-	// Apply a blunt force parallelisation of the machines; each run_for is dispatched
-	// to a separate queue and this queue will block until all are done.
-	volatile std::size_t outstanding_machines;
-	std::condition_variable condition;
-	std::mutex mutex;
-	{
-		std::lock_guard<decltype(machines_mutex_)> machines_lock(machines_mutex_);
-		std::lock_guard<std::mutex> lock(mutex);
-		outstanding_machines = machines_.size();
-
-		for(std::size_t index = 0; index < machines_.size(); ++index) {
-			CRTMachine::Machine *crt_machine = machines_[index]->crt_machine();
-			queues_[index].enqueue([&mutex, &condition, crt_machine, function, &outstanding_machines]() {
-				if(crt_machine) function(crt_machine);
-
-				std::lock_guard<std::mutex> lock(mutex);
-				outstanding_machines--;
-				condition.notify_all();
-			});
+void MultiCRTMachine::perform_parallel(const std::vector<::CRTMachine::Machine *> &machines, const std::function<void(::CRTMachine::Machine *)> &function) {
+	// Dispatch all but the first machine to the shared thread pool, then perform the first on
+	// this thread and wait for the rest to finish. If there is only one machine, or only one
+	// processor, there's nothing to gain from other threads.
+	if(machines.size() < 2 || std::thread::hardware_concurrency() < 2) {
+		for(const auto machine: machines) {
+			function(machine);
 		}
+		return;
+	}
+
+	auto &pool = Concurrency::ThreadPool::shared();
+	std::atomic<std::size_t> outstanding_machines(machines.size() - 1);
+	for(std::size_t index = 1; index < machines.size(); ++index) {
+		MachineJob &job = jobs_[index];
+		job.machine = machines[index];
+		job.function = &function;
+		job.outstanding_machines = &outstanding_machines;
+		pool.schedule(&job);
 	}
 
-	std::unique_lock<std::mutex> lock(mutex);
-	condition.wait(lock, [&outstanding_machines] { return !outstanding_machines; });
+	function(machines.front());
+	pool.wait([&outstanding_machines] {
+		return !outstanding_machines.load(std::memory_order_acquire);
+	});
+}
+
+bool MultiCRTMachine::MachineJob::perform() {
+	(*function)(machine);
+	if(outstanding_machines->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		Concurrency::ThreadPool::shared().notify();
+	}
+	return false;
 }
 
 void MultiCRTMachine::perform_serial(const std::function<void (::CRTMachine::Machine *)> &function) {
@@ -64,9 +72,31 @@ Outputs::Speaker::Speaker *MultiCRTMachine::get_speaker() {
 	return speaker_;
 }
 
+void MultiCRTMachine::set_confidence_floor(float floor, Time::Seconds probation) {
+	confidence_floor_ = floor;
+	probation_ = probation;
+}
+
 void MultiCRTMachine::run_for(Time::Seconds duration) {
-	perform_parallel([=](::CRTMachine::Machine *machine) {
-		if(machine->get_confidence() >= 0.01f) machine->run_for(duration);
+	// Once the probationary period is over, machines other than the frontmost whose confidence has
+	// fallen below the floor are no longer run. As their confidence will then not change, they remain
+	// dropped unless and until they become the frontmost.
+	const bool is_pruning = time_run_ >= probation_;
+	time_run_ += duration;
+
+	{
+		std::lock_guard<decltype(machines_mutex_)> machines_lock(machines_mutex_);
+		running_machines_.clear();
+		for(std::size_t index = 0; index < machines_.size(); ++index) {
+			CRTMachine::Machine *const crt_machine = machines_[index]->crt_machine();
+			if(!crt_machine) continue;
+			if(index && is_pruning && crt_machine->get_confidence() < confidence_floor_) continue;
+			running_machines_.push_back(crt_machine);
+		}
+	}
+
+	perform_parallel(running_machines_, [=](::CRTMachine::Machine *machine) {
+		machine->run_for(duration);
 	});
 
 	if(delegate_) delegate_->multi_crt_did_run_machines();
@@ -9,12 +9,14 @@
 #ifndef MultiCRTMachine_hpp
 #define MultiCRTMachine_hpp
 
-#include "../../../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../../../Concurrency/ThreadPool.hpp"
 #include "../../../../Machines/CRTMachine.hpp"
 #include "../../../../Machines/DynamicMachine.hpp"
 
 #include "MultiSpeaker.hpp"
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -40,6 +42,18 @@ class MultiCRTMachine: public CRTMachine::Machine {
 		*/
 		void did_change_machine_order();
 
+		/// The default confidence below which a machine is dropped; see @c set_confidence_floor.
+		static constexpr float DefaultConfidenceFloor = 0.01f;
+
+		/// The default period for which all machines are run before any is dropped; see @c set_confidence_floor.
+		static constexpr Time::Seconds DefaultProbation = 0.5;
+
+		/*!
+			Sets the confidence below which a machine other than the frontmost is dropped, i.e. is
+			no longer run, once all machines have been run for at least @c probation seconds.
+		*/
+		void set_confidence_floor(float floor, Time::Seconds probation);
+
 		/*!
 			Provides a mechanism by which a delegate can be informed each time a call to run_for has
 			been received.
@@ -61,18 +75,38 @@ class MultiCRTMachine: public CRTMachine::Machine {
 		void run_for(const Cycles cycles) override {}
 		const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines_;
 		std::recursive_mutex &machines_mutex_;
-		std::vector<Concurrency::AsyncTaskQueue> queues_;
+
+		/*!
+			Applies a function to a single machine on the shared thread pool, decrementing a count of
+			outstanding machines once done.
+		*/
+		class MachineJob: public Concurrency::ThreadPool::Job {
+			public:
+				::CRTMachine::Machine *machine = nullptr;
+				const std::function<void(::CRTMachine::Machine *)> *function = nullptr;
+				std::atomic<std::size_t> *outstanding_machines = nullptr;
+
+			private:
+				bool perform() final;
+		};
+		std::vector<MachineJob> jobs_;
+
 		MultiSpeaker *speaker_ = nullptr;
 		Delegate *delegate_ = nullptr;
 		Outputs::Display::ScanTarget *scan_target_ = nullptr;
 
+		float confidence_floor_ = DefaultConfidenceFloor;
+		Time::Seconds probation_ = DefaultProbation;
+		Time::Seconds time_run_ = 0.0;
+		std::vector<::CRTMachine::Machine *> running_machines_;
+
 		/*!
-			Performs a parallel for operation across all machines, performing the supplied
+			Performs a parallel for operation across @c machines, performing the supplied
 			function on each and returning only once all applications have completed.
 
 			No guarantees are extended as to which thread operations will occur on.
 		*/
-		void perform_parallel(const std::function<void(::CRTMachine::Machine *)> &);
+		void perform_parallel(const std::vector<::CRTMachine::Machine *> &machines, const std::function<void(::CRTMachine::Machine *)> &);
 
 		/*!
 			Performs a serial for operation across all machines, performing the supplied
@@ -23,6 +23,10 @@ MultiMachine::MultiMachine(std::vector<std::unique_ptr<DynamicMachine>> &&machin
 	crt_machine_.set_delegate(this);
 }
 
+void MultiMachine::set_confidence_floor(float floor, Time::Seconds probation) {
+	crt_machine_.set_confidence_floor(floor, probation);
+}
+
 Activity::Source *MultiMachine::activity_source() {
 	return nullptr; // TODO
 }
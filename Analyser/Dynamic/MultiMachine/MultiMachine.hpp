@@ -36,7 +36,9 @@ namespace Dynamic {
 	confidence.
 
 	If confidence for any machine becomes disproportionately low compared to
-	the others in the set, that machine stops running.
+	the others in the set, that machine stops running. Machines other than the
+	frontmost also stop running if their confidence falls below a floor after
+	a short probationary period; see @c set_confidence_floor.
 */
 class MultiMachine: public ::Machine::DynamicMachine, public MultiCRTMachine::Delegate {
 	public:
@@ -50,6 +52,12 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiCRTMachine::De
 		static bool would_collapse(const std::vector<std::unique_ptr<DynamicMachine>> &machines);
 		MultiMachine(std::vector<std::unique_ptr<DynamicMachine>> &&machines);
 
+		/*!
+			Sets the confidence below which a machine other than the frontmost stops running, once
+			all machines have been run for at least @c probation seconds.
+		*/
+		void set_confidence_floor(float floor, Time::Seconds probation = MultiCRTMachine::DefaultProbation);
+
 		Activity::Source *activity_source() override;
 		Configurable::Device *configurable_device() override;
 		CRTMachine::Machine *crt_machine() override;
@@ -7,11 +7,17 @@
 //
 
 #include "StaticAnalyser.hpp"
+#include "TargetCache.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iterator>
+#include <mutex>
+
+#include "../../Concurrency/ThreadPool.hpp"
 
 // Analysers
 #include "Acorn/StaticAnalyser.hpp"
@@ -68,6 +74,69 @@
 
 using namespace Analyser::Static;
 
+namespace {
+
+/*!
+	Gives an analyser read-only access to a disk that other analysers may be inspecting at the same time.
+	Each track is supplied as a private copy, so that reading it doesn't move a cursor that other
+	readers share, and calls into the underlying disk are serialised.
+*/
+class SharedDiskView: public Storage::Disk::Disk {
+	public:
+		SharedDiskView(const std::shared_ptr<Storage::Disk::Disk> &disk, std::mutex &mutex) : disk_(disk), mutex_(mutex) {}
+
+		Storage::Disk::HeadPosition get_maximum_head_position() final {
+			std::lock_guard<std::mutex> lock_guard(mutex_);
+			return disk_->get_maximum_head_position();
+		}
+
+		int get_head_count() final {
+			std::lock_guard<std::mutex> lock_guard(mutex_);
+			return disk_->get_head_count();
+		}
+
+		std::shared_ptr<Storage::Disk::Track> get_track_at_position(Storage::Disk::Track::Address address) final {
+			std::lock_guard<std::mutex> lock_guard(mutex_);
+			const auto track = disk_->get_track_at_position(address);
+			return track ? std::shared_ptr<Storage::Disk::Track>(track->clone()) : nullptr;
+		}
+
+		void set_track_at_position(Storage::Disk::Track::Address, const std::shared_ptr<Storage::Disk::Track> &) final {}
+		void flush_tracks() final {}
+		bool get_is_read_only() final {
+			return true;
+		}
+
+	private:
+		std::shared_ptr<Storage::Disk::Disk> disk_;
+		std::mutex &mutex_;
+};
+
+/*!
+	Runs a single platform's analyser on the shared thread pool, decrementing @c remaining once done.
+*/
+class AnalysisJob: public Concurrency::ThreadPool::Job {
+	public:
+		AnalysisJob(const std::function<TargetList(const Media &)> &analyser, Media &&media, std::atomic<size_t> &remaining) :
+			media(std::move(media)), analyser_(analyser), remaining_(remaining) {}
+
+		const Media media;
+		TargetList targets;
+
+	private:
+		bool perform() final {
+			targets = analyser_(media);
+			--remaining_;
+			Concurrency::ThreadPool::shared().notify();
+			return false;
+		}
+
+		const std::function<TargetList(const Media &)> &analyser_;
+		std::atomic<size_t> &remaining_;
+};
+
+}
+
 static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::IntType &potential_platforms) {
 	Media result;
 
@@ -176,12 +245,20 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 	TargetPlatform::IntType potential_platforms = 0;
 	Media media = GetMediaAndPlatforms(file_name, potential_platforms);
 
+	// If this file has been analysed before, reuse that result.
+	auto &cache = TargetCache::shared();
+	const std::string cache_key = cache.key(file_name);
+	if(cache.get(cache_key, media, targets)) {
+		return targets;
+	}
+
 	// Hand off to platform-specific determination of whether these things are actually compatible and,
 	// if so, how to load them.
-	#define Append(x) {\
-		auto new_targets = x::GetTargets(media, file_name, potential_platforms);\
-		std::move(new_targets.begin(), new_targets.end(), std::back_inserter(targets));\
-	}
+	std::vector<std::function<TargetList(const Media &)>> analysers;
+	#define Append(x) \
+		analysers.push_back([&file_name, potential_platforms] (const Media &media) {\
+			return x::GetTargets(media, file_name, potential_platforms);\
+		});
 	if(potential_platforms & TargetPlatform::Acorn)			Append(Acorn);
 	if(potential_platforms & TargetPlatform::AmstradCPC)	Append(AmstradCPC);
 	if(potential_platforms & TargetPlatform::AppleII)		Append(AppleII);
@@ -197,6 +274,48 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 	if(potential_platforms & TargetPlatform::ZX8081)		Append(ZX8081);
 	#undef Append
 
+	// If there are several candidate platforms and more than one core, analyse them concurrently.
+	// Disks and cartridges can be shared between analysers, the former via a private view per analyser;
+	// tapes and mass-storage devices can't, as reading them moves a cursor that all readers share.
+	const bool is_concurrent =
+		analysers.size() > 1 &&
+		Concurrency::ThreadPool::shared().thread_count() > 1 &&
+		media.tapes.empty() && media.mass_storage_devices.empty();
+	if(is_concurrent) {
+		std::vector<std::mutex> disk_mutexes(media.disks.size());
+		std::atomic<size_t> remaining(analysers.size());
+		std::vector<std::unique_ptr<AnalysisJob>> jobs;
+		for(const auto &analyser: analysers) {
+			Media view = media;
+			for(size_t c = 0; c < view.disks.size(); ++c) {
+				view.disks[c] = std::make_shared<SharedDiskView>(media.disks[c], disk_mutexes[c]);
+			}
+			jobs.push_back(std::make_unique<AnalysisJob>(analyser, std::move(view), remaining));
+			Concurrency::ThreadPool::shared().schedule(jobs.back().get());
+		}
+		Concurrency::ThreadPool::shared().wait([&remaining] {
+			return !remaining;
+		});
+
+		// Collect results in the original platform order, so that the stable sort below is unaffected,
+		// substituting the original disks for any views.
+		for(auto &job: jobs) {
+			for(auto &target: job->targets) {
+				for(auto &disk: target->media.disks) {
+					const auto &views = job->media.disks;
+					const auto view = std::find(views.begin(), views.end(), disk);
+					if(view != views.end()) disk = media.disks[size_t(view - views.begin())];
+				}
+			}
+			std::move(job->targets.begin(), job->targets.end(), std::back_inserter(targets));
+		}
+	} else {
+		for(const auto &analyser: analysers) {
+			auto new_targets = analyser(media);
+			std::move(new_targets.begin(), new_targets.end(), std::back_inserter(targets));
+		}
+	}
+
 	// Reset any tapes to their initial position
 	for(const auto &target : targets) {
 		for(auto &tape : target->media.tapes) {
@@ -211,5 +330,7 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 			return a->confidence > b->confidence;
 		});
 
+	cache.put(cache_key, targets, media);
+
 	return targets;
 }
@@ -0,0 +1,404 @@
+//
+//  TargetCache.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#include "TargetCache.hpp"
+
+#include "Acorn/Target.hpp"
+#include "AmstradCPC/Target.hpp"
+#include "AppleII/Target.hpp"
+#include "Atari2600/Target.hpp"
+#include "AtariST/Target.hpp"
+#include "Commodore/Target.hpp"
+#include "Macintosh/Target.hpp"
+#include "MSX/Target.hpp"
+#include "Oric/Target.hpp"
+#include "Sega/Target.hpp"
+#include "ZX8081/Target.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <typeinfo>
+
+using namespace Analyser::Static;
+
+namespace {
+
+constexpr char Magic[4] = {'C', 'L', 'K', 'T'};
+
+/// Appends values to a byte stream, little endian.
+class Writer {
+	public:
+		std::vector<uint8_t> data;
+
+		void operator()(bool &value) {
+			data.push_back(value ? 1 : 0);
+		}
+		void operator()(std::string &value) {
+			uint32_t length = uint32_t(value.size());
+			(*this)(length);
+			data.insert(data.end(), value.begin(), value.end());
+		}
+		void operator()(float &value) {
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			(*this)(bits);
+		}
+		template <typename T> void operator()(T &value) {
+			uint32_t integer = uint32_t(value);
+			for(int c = 0; c < 4; ++c) {
+				data.push_back(uint8_t(integer));
+				integer >>= 8;
+			}
+		}
+};
+
+/// Reads values from a byte stream, as written by @c Writer; sets @c failed rather than overrunning.
+class Reader {
+	public:
+		Reader(const std::vector<uint8_t> &data) : data_(data) {}
+		bool failed = false;
+
+		void operator()(bool &value) {
+			value = byte();
+		}
+		void operator()(std::string &value) {
+			uint32_t length = 0;
+			(*this)(length);
+			if(failed || length > data_.size() - offset_) {
+				failed = true;
+				return;
+			}
+			value.assign(reinterpret_cast<const char *>(&data_[offset_]), length);
+			offset_ += length;
+		}
+		void operator()(float &value) {
+			uint32_t bits = 0;
+			(*this)(bits);
+			std::memcpy(&value, &bits, sizeof(bits));
+		}
+		template <typename T> void operator()(T &value) {
+			uint32_t integer = 0;
+			for(int c = 0; c < 4; ++c) {
+				integer |= uint32_t(byte()) << (c * 8);
+			}
+			value = T(integer);
+		}
+
+		bool is_at_end() const {
+			return offset_ == data_.size();
+		}
+
+	private:
+		const std::vector<uint8_t> &data_;
+		size_t offset_ = 0;
+
+		uint8_t byte() {
+			if(offset_ == data_.size()) {
+				failed = true;
+				return 0;
+			}
+			return data_[offset_++];
+		}
+};
+
+/// @returns A new, default-initialised target of the type used for @c machine.
+std::unique_ptr<Target> make_target(Analyser::Machine machine) {
+	using Machine = Analyser::Machine;
+	switch(machine) {
+		case Machine::AmstradCPC:	return std::make_unique<AmstradCPC::Target>();
+		case Machine::AppleII:		return std::make_unique<AppleII::Target>();
+		case Machine::Atari2600:	return std::make_unique<Atari2600::Target>();
+		case Machine::AtariST:		return std::make_unique<AtariST::Target>();
+		case Machine::ColecoVision:	return std::make_unique<Target>();
+		case Machine::Electron:		return std::make_unique<Acorn::Target>();
+		case Machine::Macintosh:	return std::make_unique<Macintosh::Target>();
+		case Machine::MasterSystem:	return std::make_unique<Sega::Target>();
+		case Machine::MSX:			return std::make_unique<MSX::Target>();
+		case Machine::Oric:			return std::make_unique<Oric::Target>();
+		case Machine::Vic20:		return std::make_unique<Commodore::Target>();
+		case Machine::ZX8081:		return std::make_unique<ZX8081::Target>();
+	}
+	return nullptr;
+}
+
+/*!
+	Applies @c visitor to each machine-specific field of @c target, which is used both to
+	serialise and to deserialise.
+
+	@returns @c true if @c target is of the type expected for its machine; @c false otherwise.
+*/
+template <typename Visitor> bool visit_fields(Visitor &visitor, Target &target) {
+#define Cast(x)	\
+	auto *const specific = dynamic_cast<x::Target *>(&target);	\
+	if(!specific) return false;
+
+	using Machine = Analyser::Machine;
+	switch(target.machine) {
+		case Machine::AmstradCPC: {
+			Cast(AmstradCPC);
+			visitor(specific->model);
+			visitor(specific->loading_command);
+		} break;
+		case Machine::AppleII: {
+			Cast(AppleII);
+			visitor(specific->model);
+			visitor(specific->disk_controller);
+		} break;
+		case Machine::Atari2600: {
+			Cast(Atari2600);
+			visitor(specific->paging_model);
+			visitor(specific->uses_superchip);
+		} break;
+		case Machine::AtariST: {
+			Cast(AtariST);
+		} break;
+		case Machine::ColecoVision:
+			// ColecoVision targets have no further fields; neither is a subclass used.
+			if(typeid(target) != typeid(Target)) return false;
+		break;
+		case Machine::Electron: {
+			Cast(Acorn);
+			visitor(specific->has_adfs);
+			visitor(specific->has_dfs);
+			visitor(specific->should_shift_restart);
+			visitor(specific->loading_command);
+		} break;
+		case Machine::Macintosh: {
+			Cast(Macintosh);
+			visitor(specific->model);
+		} break;
+		case Machine::MasterSystem: {
+			Cast(Sega);
+			visitor(specific->model);
+			visitor(specific->region);
+			visitor(specific->paging_scheme);
+		} break;
+		case Machine::MSX: {
+			Cast(MSX);
+			visitor(specific->has_disk_drive);
+			visitor(specific->loading_command);
+			visitor(specific->region);
+		} break;
+		case Machine::Oric: {
+			Cast(Oric);
+			visitor(specific->rom);
+			visitor(specific->disk_interface);
+			visitor(specific->loading_command);
+			visitor(specific->should_start_jasmin);
+		} break;
+		case Machine::Vic20: {
+			Cast(Commodore);
+			visitor(specific->enabled_ram.bank0);
+			visitor(specific->enabled_ram.bank1);
+			visitor(specific->enabled_ram.bank2);
+			visitor(specific->enabled_ram.bank3);
+			visitor(specific->enabled_ram.bank5);
+			visitor(specific->region);
+			visitor(specific->has_c1540);
+			visitor(specific->loading_command);
+		} break;
+		case Machine::ZX8081: {
+			Cast(ZX8081);
+			visitor(specific->memory_model);
+			visitor(specific->is_ZX81);
+			visitor(specific->ZX80_uses_ZX81_ROM);
+			visitor(specific->loading_command);
+		} break;
+	}
+
+#undef Cast
+	return true;
+}
+
+/*!
+	Writes the index within @c media of each item in @c items to @c writer.
+
+	@returns @c true if every item was found; @c false otherwise.
+*/
+template <typename T> bool write_indices(
+	Writer &writer,
+	const std::vector<std::shared_ptr<T>> &items,
+	const Media &media,
+	std::vector<std::shared_ptr<T>> Media::*list) {
+	uint32_t count = uint32_t(items.size());
+	writer(count);
+
+	const auto &candidates = media.*list;
+	for(const auto &item: items) {
+		const auto position = std::find(candidates.begin(), candidates.end(), item);
+		if(position == candidates.end()) return false;
+
+		uint32_t index = uint32_t(position - candidates.begin());
+		writer(index);
+	}
+	return true;
+}
+
+/*!
+	Reads a list of indices from @c reader and appends the corresponding members of @c media to @c items.
+
+	@returns @c true if all indices were valid; @c false otherwise.
+*/
+template <typename T> bool read_indices(
+	Reader &reader,
+	std::vector<std::shared_ptr<T>> &items,
+	const Media &media,
+	std::vector<std::shared_ptr<T>> Media::*list) {
+	uint32_t count = 0;
+	reader(count);
+
+	const auto &candidates = media.*list;
+	while(count-- && !reader.failed) {
+		uint32_t index = 0;
+		reader(index);
+		if(index >= candidates.size()) return false;
+		items.push_back(candidates[index]);
+	}
+	return !reader.failed;
+}
+
+}
+
+TargetCache &TargetCache::shared() {
+	static TargetCache cache;
+	return cache;
+}
+
+void TargetCache::set_directory(const std::string &directory) {
+	std::lock_guard<std::mutex> lock_guard(mutex_);
+	directory_ = directory;
+}
+
+std::string TargetCache::key(const std::string &file_name) {
+	{
+		std::lock_guard<std::mutex> lock_guard(mutex_);
+		if(directory_.empty()) return "";
+	}
+
+	FILE *const file = std::fopen(file_name.c_str(), "rb");
+	if(!file) return "";
+
+	// FNV-1a over the contents of the file; some analysers also consider the file's name, so that is included too.
+	uint64_t hash = 14695981039346656037u;
+	const auto append = [&hash] (const uint8_t *data, size_t length) {
+		while(length--) {
+			hash = (hash ^ *data) * 1099511628211u;
+			++data;
+		}
+	};
+
+	uint8_t buffer[65536];
+	size_t read;
+	while((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		append(buffer, read);
+	}
+	const bool did_fail = std::ferror(file);
+	std::fclose(file);
+	if(did_fail) return "";
+
+	const auto separator = file_name.find_last_of("/\\");
+	const std::string leaf_name = (separator == std::string::npos) ? file_name : file_name.substr(separator + 1);
+	append(reinterpret_cast<const uint8_t *>(leaf_name.data()), leaf_name.size());
+
+	char key[32];
+	std::snprintf(key, sizeof(key), "%016llx-%u", static_cast<unsigned long long>(hash), AnalyserVersion);
+	return key;
+}
+
+bool TargetCache::get(const std::string &key, const Media &media, TargetList &targets) {
+	if(key.empty()) return false;
+
+	std::string path;
+	{
+		std::lock_guard<std::mutex> lock_guard(mutex_);
+		if(directory_.empty()) return false;
+		path = directory_ + key;
+	}
+
+	FILE *const file = std::fopen(path.c_str(), "rb");
+	if(!file) return false;
+
+	std::vector<uint8_t> data;
+	std::fseek(file, 0, SEEK_END);
+	const long size = std::ftell(file);
+	std::fseek(file, 0, SEEK_SET);
+	if(size > 0) {
+		data.resize(size_t(size));
+		data.resize(std::fread(data.data(), 1, data.size(), file));
+	}
+	std::fclose(file);
+
+	if(data.size() < sizeof(Magic) || std::memcmp(data.data(), Magic, sizeof(Magic))) return false;
+	data.erase(data.begin(), data.begin() + sizeof(Magic));
+
+	Reader reader(data);
+	uint32_t count = 0;
+	reader(count);
+
+	TargetList results;
+	while(count-- && !reader.failed) {
+		uint32_t machine = 0;
+		reader(machine);
+		auto target = make_target(Analyser::Machine(machine));
+		if(!target) return false;
+
+		target->machine = Analyser::Machine(machine);
+		reader(target->confidence);
+		if(
+			!read_indices(reader, target->media.disks, media, &Media::disks) ||
+			!read_indices(reader, target->media.tapes, media, &Media::tapes) ||
+			!read_indices(reader, target->media.cartridges, media, &Media::cartridges) ||
+			!read_indices(reader, target->media.mass_storage_devices, media, &Media::mass_storage_devices)
+		) return false;
+
+		visit_fields(reader, *target);
+		results.push_back(std::move(target));
+	}
+	if(reader.failed || !reader.is_at_end()) return false;
+
+	targets = std::move(results);
+	return true;
+}
+
+void TargetCache::put(const std::string &key, const TargetList &targets, const Media &media) {
+	if(key.empty()) return;
+
+	Writer writer;
+	writer.data.insert(writer.data.end(), std::begin(Magic), std::end(Magic));
+
+	uint32_t count = uint32_t(targets.size());
+	writer(count);
+	for(const auto &target: targets) {
+		writer(target->machine);
+		writer(target->confidence);
+		if(
+			!write_indices(writer, target->media.disks, media, &Media::disks) ||
+			!write_indices(writer, target->media.tapes, media, &Media::tapes) ||
+			!write_indices(writer, target->media.cartridges, media, &Media::cartridges) ||
+			!write_indices(writer, target->media.mass_storage_devices, media, &Media::mass_storage_devices) ||
+			!visit_fields(writer, *target)
+		) return;
+	}
+
+	std::string path;
+	{
+		std::lock_guard<std::mutex> lock_guard(mutex_);
+		if(directory_.empty()) return;
+		path = directory_ + key;
+	}
+
+	// Write to a temporary file and then rename it, so that no reader can observe a partial result.
+	const std::string temporary_path = path + ".tmp";
+	FILE *const file = std::fopen(temporary_path.c_str(), "wb");
+	if(!file) return;
+	const bool did_write = std::fwrite(writer.data.data(), 1, writer.data.size(), file) == writer.data.size();
+	if(std::fclose(file) || !did_write || std::rename(temporary_path.c_str(), path.c_str())) {
+		std::remove(temporary_path.c_str());
+	}
+}
@@ -0,0 +1,73 @@
+//
+//  TargetCache.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#ifndef TargetCache_hpp
+#define TargetCache_hpp
+
+#include "StaticAnalyser.hpp"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Analyser {
+namespace Static {
+
+/*!
+	An optional on-disk cache of static analysis results, allowing a file that has been analysed
+	before to skip analysis entirely.
+
+	Results are keyed on the contents and name of the file, plus the analyser version, so any change to
+	the file or to the analysers will cause it to be reanalysed. Only the targets themselves are stored;
+	a cached result refers to media by index and is reconstituted against freshly-parsed media, so results
+	in which an analyser manufactured media of its own are not cached.
+
+	The cache is disabled until a directory is supplied.
+*/
+class TargetCache {
+	public:
+		/// Increment this whenever a change to any analyser could alter its results.
+		static constexpr uint32_t AnalyserVersion = 1;
+
+		/// @returns The process-wide cache.
+		static TargetCache &shared();
+
+		/// Sets the directory in which results are stored, which should end with a path separator; use an empty string to disable the cache.
+		void set_directory(const std::string &directory);
+
+		/// @returns The key under which results for @c file_name are stored, or an empty string if the cache is disabled or the file can't be read.
+		std::string key(const std::string &file_name);
+
+		/*!
+			Looks up previously-stored results.
+
+			@param key A key obtained from @c key.
+			@param media The media contained in the file, as obtained by a fresh parse.
+			@param targets Receives the stored targets, referring to @c media, if any are found.
+			@returns @c true if results were found; @c false otherwise.
+		*/
+		bool get(const std::string &key, const Media &media, TargetList &targets);
+
+		/*!
+			Stores the results of analysis.
+
+			@param key A key obtained from @c key.
+			@param targets The results of analysis.
+			@param media The media that @c targets refer to.
+		*/
+		void put(const std::string &key, const TargetList &targets, const Media &media);
+
+	private:
+		std::mutex mutex_;
+		std::string directory_;
+};
+
+}
+}
+
+#endif /* TargetCache_hpp */
@@ -114,6 +114,13 @@ template <class T> class MOS6522: public MOS6522Storage {
 		/// @returns @c true if the IRQ line is currently active; @c false otherwise.
 		bool get_interrupt_line();
 
+		/// @returns A lower bound on the number of cycles until the IRQ line might next become active
+		/// of the 6522's own accord, i.e. upon expiry of a timer, or @c Cycles(-1) if it can't do so
+		/// without further input. @c Cycles(0) is returned if the shift register might cause an interrupt
+		/// while clocked internally; changes on the control lines, including CB1 as a shift clock, are
+		/// the caller's responsibility.
+		Cycles get_next_sequence_point() const;
+
 		/// Updates the port handler to the current time and then requests that it flush.
 		void flush();
 
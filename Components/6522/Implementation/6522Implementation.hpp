@@ -388,6 +388,32 @@ template <typename T> bool MOS6522<T>::get_interrupt_line() {
 	return !!interrupt_status;
 }
 
+template <typename T> Cycles MOS6522<T>::get_next_sequence_point() const {
+	// A shift register clocked by CB1 is driven by input; otherwise it might be about to complete a byte.
+	const auto mode = shift_mode();
+	if(
+		mode != ShiftMode::Disabled && mode != ShiftMode::InUnderCB1 && mode != ShiftMode::OutUnderCB1 &&
+		(registers_.interrupt_enable & InterruptFlag::ShiftRegister)
+	) {
+		return Cycles(0);
+	}
+
+	int next = -1;
+	for(int c = 0; c < 2; ++c) {
+		if(!timer_is_running_[c] || !(registers_.interrupt_enable & (c ? InterruptFlag::Timer2 : InterruptFlag::Timer1))) continue;
+
+		// A timer signals its interrupt in the half-cycle after it has counted down through zero,
+		// so no sooner than the number of cycles indicated by whichever value it holds or will next
+		// hold — unless it has just counted through zero.
+		if(registers_.timer[c] == 0xffff && !registers_.last_timer[c]) return Cycles(0);
+		const int value =
+			(registers_.next_timer[c] >= 0) ? registers_.next_timer[c] :
+				((!c && registers_.timer_needs_reload) ? registers_.timer_latch[0] : registers_.timer[c]);
+		if(next < 0 || value < next) next = value;
+	}
+	return Cycles(next);
+}
+
 template <typename T> void MOS6522<T>::evaluate_cb2_output() {
 	// CB2 is a special case, being both the line the shift register can output to,
 	// and one that can be used as an input or handshaking output according to the
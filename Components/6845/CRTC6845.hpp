@@ -164,6 +164,11 @@ template <class T> class CRTC6845 {
 			return bus_state_;
 		}
 
+		/// @returns The number of characters in a complete line, as currently programmed.
+		int get_characters_per_line() const {
+			return registers_[0] + 1;
+		}
+
 	private:
 		inline void perform_bus_cycle_phase1() {
 			// Skew theory of operation: keep a history of the last three states, and apply whichever is selected.
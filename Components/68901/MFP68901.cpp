@@ -208,7 +208,22 @@ void MFP68901::run_for(HalfCycles time) {
 }
 
 HalfCycles MFP68901::get_next_sequence_point() {
-	return HalfCycles(-1);
+	// Of the things that might change the interrupt line, only the timers do so
+	// of their own accord; find whichever enabled timer will next expire. Event-count
+	// timers are clocked by the owner, so are its responsibility.
+	constexpr int timer_interrupts[] = {Interrupt::TimerA, Interrupt::TimerB, Interrupt::TimerC, Interrupt::TimerD};
+
+	int cycles_until_expiry = -1;
+	for(int c = 0; c < 4; ++c) {
+		if(timers_[c].mode < TimerMode::Delay || !(interrupt_enable_ & timer_interrupts[c])) continue;
+
+		const int decrements = timers_[c].value ? timers_[c].value : 256;
+		const int cycles = (decrements - 1) * timers_[c].prescale + std::max(timers_[c].prescale - timers_[c].prescale_count, 1);
+		if(cycles_until_expiry < 0 || cycles < cycles_until_expiry) cycles_until_expiry = cycles;
+	}
+
+	if(cycles_until_expiry < 0) return HalfCycles(-1);
+	return HalfCycles(cycles_until_expiry * 2) - cycles_left_;
 }
 
 // MARK: - Timers
@@ -36,10 +36,12 @@ class MFP68901: public ClockingHint::Source {
 		void run_for(HalfCycles);
 
 		/// @returns the number of cycles until the next possible sequence point — the next time
-		/// at which the interrupt line _might_ change. This object conforms to ClockingHint::Source
-		/// so that mechanism can also be used to reduce the quantity of calls into this class.
+		/// at which the interrupt line _might_ change, or @c HalfCycles(-1) if it can't change without
+		/// further input. This object conforms to ClockingHint::Source so that mechanism can also
+		/// be used to reduce the quantity of calls into this class.
 		///
-		/// @discussion TODO, alas.
+		/// @discussion Only the timers are considered; the owner is responsible for changes in GPIP
+		/// input, and for clocking event-count timers.
 		HalfCycles get_next_sequence_point();
 
 		/// Sets the current level of either of the timer event inputs — TAI and TBI in datasheet terms.
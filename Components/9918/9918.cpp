@@ -413,13 +413,16 @@ void TMS9918::run_for(const HalfCycles cycles) {
 							);
 						}
 
-						if(pixel_target_) {
+						// Sprites are processed even if there's nowhere to draw them, as they may collide.
+						{
 							const int relative_start = start - line_buffer.first_pixel_output_column;
 							const int relative_end = end - line_buffer.first_pixel_output_column;
 							switch(line_buffer.line_mode) {
 								case LineMode::SMS:			draw_sms(relative_start, relative_end, cram_value);		break;
 								case LineMode::Character:	draw_tms_character(relative_start, relative_end);		break;
-								case LineMode::Text:		draw_tms_text(relative_start, relative_end);			break;
+								case LineMode::Text:
+									if(pixel_target_) draw_tms_text(relative_start, relative_end);
+								break;
 
 								case LineMode::Refresh:		break;	/* Dealt with elsewhere. */
 							}
@@ -772,44 +775,46 @@ bool TMS9918::get_interrupt_line() {
 void Base::draw_tms_character(int start, int end) {
 	LineBuffer &line_buffer = line_buffers_[read_pointer_.row];
 
-	// Paint the background tiles.
+	// Paint the background tiles, if there's anywhere to paint them; sprites are processed regardless.
 	const int pixels_left = end - start;
-	if(screen_mode_ == ScreenMode::MultiColour) {
-		for(int c = start; c < end; ++c) {
-			pixel_target_[c] = palette[
-				(line_buffer.patterns[c >> 3][0] >> (((c & 4)^4))) & 15
-			];
-		}
-	} else {
-		const int shift = start & 7;
-		int byte_column = start >> 3;
-
-		int length = std::min(pixels_left, 8 - shift);
-
-		int pattern = reverse_table.map[line_buffer.patterns[byte_column][0]] >> shift;
-		uint8_t colour = line_buffer.patterns[byte_column][1];
-		uint32_t colours[2] = {
-			palette[(colour & 15) ? (colour & 15) : background_colour_],
-			palette[(colour >> 4) ? (colour >> 4) : background_colour_]
-		};
-
-		int background_pixels_left = pixels_left;
-		while(true) {
-			background_pixels_left -= length;
-			for(int c = 0; c < length; ++c) {
-				pixel_target_[c] = colours[pattern&0x01];
-				pattern >>= 1;
+	if(pixel_target_) {
+		if(screen_mode_ == ScreenMode::MultiColour) {
+			for(int c = start; c < end; ++c) {
+				pixel_target_[c] = palette[
+					(line_buffer.patterns[c >> 3][0] >> (((c & 4)^4))) & 15
+				];
 			}
-			pixel_target_ += length;
+		} else {
+			const int shift = start & 7;
+			int byte_column = start >> 3;
+
+			int length = std::min(pixels_left, 8 - shift);
+
+			int pattern = reverse_table.map[line_buffer.patterns[byte_column][0]] >> shift;
+			uint8_t colour = line_buffer.patterns[byte_column][1];
+			uint32_t colours[2] = {
+				palette[(colour & 15) ? (colour & 15) : background_colour_],
+				palette[(colour >> 4) ? (colour >> 4) : background_colour_]
+			};
+
+			int background_pixels_left = pixels_left;
+			while(true) {
+				background_pixels_left -= length;
+				for(int c = 0; c < length; ++c) {
+					pixel_target_[c] = colours[pattern&0x01];
+					pattern >>= 1;
+				}
+				pixel_target_ += length;
 
-			if(!background_pixels_left) break;
-			length = std::min(8, background_pixels_left);
-			byte_column++;
+				if(!background_pixels_left) break;
+				length = std::min(8, background_pixels_left);
+				byte_column++;
 
-			pattern = reverse_table.map[line_buffer.patterns[byte_column][0]];
-			colour = line_buffer.patterns[byte_column][1];
-			colours[0] = palette[(colour & 15) ? (colour & 15) : background_colour_];
-			colours[1] = palette[(colour >> 4) ? (colour >> 4) : background_colour_];
+				pattern = reverse_table.map[line_buffer.patterns[byte_column][0]];
+				colour = line_buffer.patterns[byte_column][1];
+				colours[0] = palette[(colour & 15) ? (colour & 15) : background_colour_];
+				colours[1] = palette[(colour >> 4) ? (colour >> 4) : background_colour_];
+			}
 		}
 	}
 
@@ -848,9 +853,11 @@ void Base::draw_tms_character(int start, int end) {
 
 					// ... but a sprite with the transparent colour won't actually be visible.
 					sprite_colour &= colour_masks[sprite.image[2]&15];
-					pixel_origin_[c] =
-						(pixel_origin_[c] & sprite_colour_selection_masks[sprite_colour^1]) |
-						(palette[sprite.image[2]&15] & sprite_colour_selection_masks[sprite_colour]);
+					if(pixel_origin_) {
+						pixel_origin_[c] =
+							(pixel_origin_[c] & sprite_colour_selection_masks[sprite_colour^1]) |
+							(palette[sprite.image[2]&15] & sprite_colour_selection_masks[sprite_colour]);
+					}
 
 					sprite.shift_position += shift_advance;
 				}
@@ -889,75 +896,78 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 	LineBuffer &line_buffer = line_buffers_[read_pointer_.row];
 	int colour_buffer[256];
 
-	/*
-		Add extra border for any pixels that fall before the fine scroll.
-	*/
-	int tile_start = start, tile_end = end;
-	int tile_offset = start;
-	if(read_pointer_.row >= 16 || !master_system_.horizontal_scroll_lock) {
-		for(int c = start; c < (line_buffer.latched_horizontal_scroll & 7); ++c) {
-			colour_buffer[c] = 16 + background_colour_;
-			++tile_offset;
+	// Tiles are needed only for output; sprites are processed regardless, for collision detection.
+	if(pixel_target_) {
+		/*
+			Add extra border for any pixels that fall before the fine scroll.
+		*/
+		int tile_start = start, tile_end = end;
+		int tile_offset = start;
+		if(read_pointer_.row >= 16 || !master_system_.horizontal_scroll_lock) {
+			for(int c = start; c < (line_buffer.latched_horizontal_scroll & 7); ++c) {
+				colour_buffer[c] = 16 + background_colour_;
+				++tile_offset;
+			}
+
+			// Remove the border area from that to which tiles will be drawn.
+			tile_start = std::max(start - (line_buffer.latched_horizontal_scroll & 7), 0);
+			tile_end = std::max(end - (line_buffer.latched_horizontal_scroll & 7), 0);
 		}
 
-		// Remove the border area from that to which tiles will be drawn.
-		tile_start = std::max(start - (line_buffer.latched_horizontal_scroll & 7), 0);
-		tile_end = std::max(end - (line_buffer.latched_horizontal_scroll & 7), 0);
-	}
 
+		uint32_t pattern;
+		uint8_t *const pattern_index = reinterpret_cast<uint8_t *>(&pattern);
 
-	uint32_t pattern;
-	uint8_t *const pattern_index = reinterpret_cast<uint8_t *>(&pattern);
+		/*
+			Add background tiles; these will fill the colour_buffer with values in which
+			the low five bits are a palette index, and bit six is set if this tile has
+			priority over sprites.
+		*/
+		if(tile_start < end) {
+			const int shift = tile_start & 7;
+			int byte_column = tile_start >> 3;
+			int pixels_left = tile_end - tile_start;
+			int length = std::min(pixels_left, 8 - shift);
 
-	/*
-		Add background tiles; these will fill the colour_buffer with values in which
-		the low five bits are a palette index, and bit six is set if this tile has
-		priority over sprites.
-	*/
-	if(tile_start < end) {
-		const int shift = tile_start & 7;
-		int byte_column = tile_start >> 3;
-		int pixels_left = tile_end - tile_start;
-		int length = std::min(pixels_left, 8 - shift);
-
-		pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
-		if(line_buffer.names[byte_column].flags&2)
-			pattern >>= shift;
-		else
-			pattern <<= shift;
-
-		while(true) {
-			const int palette_offset = (line_buffer.names[byte_column].flags&0x18) << 1;
-			if(line_buffer.names[byte_column].flags&2) {
-				for(int c = 0; c < length; ++c) {
-					colour_buffer[tile_offset] =
-						((pattern_index[3] & 0x01) << 3) |
-						((pattern_index[2] & 0x01) << 2) |
-						((pattern_index[1] & 0x01) << 1) |
-						((pattern_index[0] & 0x01) << 0) |
-						palette_offset;
-					++tile_offset;
-					pattern >>= 1;
-				}
-			} else {
-				for(int c = 0; c < length; ++c) {
-					colour_buffer[tile_offset] =
-						((pattern_index[3] & 0x80) >> 4) |
-						((pattern_index[2] & 0x80) >> 5) |
-						((pattern_index[1] & 0x80) >> 6) |
-						((pattern_index[0] & 0x80) >> 7) |
-						palette_offset;
-					++tile_offset;
-					pattern <<= 1;
+			pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
+			if(line_buffer.names[byte_column].flags&2)
+				pattern >>= shift;
+			else
+				pattern <<= shift;
+
+			while(true) {
+				const int palette_offset = (line_buffer.names[byte_column].flags&0x18) << 1;
+				if(line_buffer.names[byte_column].flags&2) {
+					for(int c = 0; c < length; ++c) {
+						colour_buffer[tile_offset] =
+							((pattern_index[3] & 0x01) << 3) |
+							((pattern_index[2] & 0x01) << 2) |
+							((pattern_index[1] & 0x01) << 1) |
+							((pattern_index[0] & 0x01) << 0) |
+							palette_offset;
+						++tile_offset;
+						pattern >>= 1;
+					}
+				} else {
+					for(int c = 0; c < length; ++c) {
+						colour_buffer[tile_offset] =
+							((pattern_index[3] & 0x80) >> 4) |
+							((pattern_index[2] & 0x80) >> 5) |
+							((pattern_index[1] & 0x80) >> 6) |
+							((pattern_index[0] & 0x80) >> 7) |
+							palette_offset;
+						++tile_offset;
+						pattern <<= 1;
+					}
 				}
-			}
 
-			pixels_left -= length;
-			if(!pixels_left) break;
+				pixels_left -= length;
+				if(!pixels_left) break;
 
-			length = std::min(8, pixels_left);
-			byte_column++;
-			pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
+				length = std::min(8, pixels_left);
+				byte_column++;
+				pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
+			}
 		}
 	}
 
@@ -1007,17 +1017,21 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 
 		// Draw the sprite buffer onto the colour buffer, wherever the tile map doesn't have
 		// priority (or is transparent).
-		for(int c = start; c < end; ++c) {
-			if(
-				sprite_buffer[c] &&
-				(!(colour_buffer[c]&0x20) || !(colour_buffer[c]&0xf))
-			) colour_buffer[c] = sprite_buffer[c];
+		if(pixel_target_) {
+			for(int c = start; c < end; ++c) {
+				if(
+					sprite_buffer[c] &&
+					(!(colour_buffer[c]&0x20) || !(colour_buffer[c]&0xf))
+				) colour_buffer[c] = sprite_buffer[c];
+			}
 		}
 
 		if(sprite_collision)
 			status_ |= StatusSpriteCollision;
 	}
 
+	if(!pixel_target_) return;
+
 	// Map from the 32-colour buffer to real output pixels, applying the specific CRAM dot if any.
 	pixel_target_[start] = master_system_.colour_ram[colour_buffer[start] & 0x1f] | cram_dot;
 	for(int c = start+1; c < end; ++c) {
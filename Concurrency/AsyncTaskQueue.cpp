@@ -10,36 +10,13 @@
 
 using namespace Concurrency;
 
-AsyncTaskQueue::AsyncTaskQueue()
-#ifndef __APPLE__
-	: should_destruct_(false)
-#endif
-{
+AsyncTaskQueue::AsyncTaskQueue() {
 #ifdef __APPLE__
 	serial_dispatch_queue_ = dispatch_queue_create("com.thomasharte.clocksignal.asyntaskqueue", DISPATCH_QUEUE_SERIAL);
 #else
-	thread_ = std::make_unique<std::thread>([this]() {
-		while(!should_destruct_) {
-			std::function<void(void)> next_function;
-
-			// Take lock, check for a new task
-			std::unique_lock<std::mutex> lock(queue_mutex_);
-			if(!pending_tasks_.empty()) {
-				next_function = pending_tasks_.front();
-				pending_tasks_.pop_front();
-			}
-
-			if(next_function) {
-				// If there is a task, release lock and perform it
-				lock.unlock();
-				next_function();
-			} else {
-				// If there isn't a task, atomically block on the processing condition and release the lock
-				// until there's something pending (and then release it again via scope)
-				processing_condition_.wait(lock);
-			}
-		}
-	});
+	for(size_t c = 0; c < RingSize; ++c) {
+		ring_[c].sequence.store(c, std::memory_order_relaxed);
+	}
 #endif
 }
 
@@ -49,20 +26,151 @@ AsyncTaskQueue::~AsyncTaskQueue() {
 	dispatch_release(serial_dispatch_queue_);
 	serial_dispatch_queue_ = nullptr;
 #else
-	should_destruct_ = true;
-	enqueue([](){});
-	thread_->join();
-	thread_.reset();
+	// Wait until no pool thread holds a reference to this queue; as per flush, don't perform other
+	// jobs meanwhile.
+	ThreadPool::shared().wait_without_performing([this] {
+		std::lock_guard<std::mutex> lock(idle_mutex_);
+		return !is_scheduled_;
+	});
 #endif
 }
 
-void AsyncTaskQueue::enqueue(std::function<void(void)> function) {
+#ifndef __APPLE__
+bool AsyncTaskQueue::push(Task &task) {
+	size_t position = write_position_.load(std::memory_order_relaxed);
+	while(true) {
+		Slot &slot = ring_[position % RingSize];
+		const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+		const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+		if(!difference) {
+			// The slot is free; attempt to claim it.
+			if(write_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				slot.task = std::move(task);
+				slot.sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		} else if(difference < 0) {
+			// The slot still holds a task from the previous lap; the ring is full.
+			return false;
+		} else {
+			// Another producer claimed this position first.
+			position = write_position_.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool AsyncTaskQueue::has_pending() const {
+	const size_t position = read_position_.load(std::memory_order_relaxed);
+	return ring_[position % RingSize].sequence.load(std::memory_order_acquire) == position + 1;
+}
+
+bool AsyncTaskQueue::has_any_pending() const {
+	return has_pending() || is_overflowing_.load(std::memory_order_seq_cst);
+}
+
+void AsyncTaskQueue::add(Task &task) {
+	if(!is_overflowing_.load(std::memory_order_acquire) && push(task)) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(overflow_mutex_);
+	overflow_.push_back(std::move(task));
+	is_overflowing_.store(true, std::memory_order_seq_cst);
+}
+
+bool AsyncTaskQueue::take_overflow() {
+	if(!is_overflowing_.load(std::memory_order_acquire)) return false;
+
+	// Everything in the overflow list was added after everything in the ring, including any slot
+	// that has been claimed but not yet filled, so the ring must be empty first.
+	if(read_position_.load(std::memory_order_relaxed) != write_position_.load(std::memory_order_acquire)) return false;
+
+	overflow_batch_.clear();
+	overflow_position_ = 0;
+
+	std::lock_guard<std::mutex> lock(overflow_mutex_);
+	std::swap(overflow_, overflow_batch_);
+	is_overflowing_.store(false, std::memory_order_release);
+	return !overflow_batch_.empty();
+}
+
+void AsyncTaskQueue::schedule() {
+	if(!is_scheduled_.exchange(true)) {
+		ThreadPool::shared().schedule(&job_);
+	}
+}
+
+bool AsyncTaskQueue::perform_tasks() {
+	// Perform at most a ring's worth of tasks, so that a queue that is being continuously
+	// fed doesn't monopolise a thread. Any overflow batch is older than the ring's contents.
+	bool did_perform = false;
+	for(size_t c = 0; c < RingSize; ++c) {
+		if(overflow_position_ < overflow_batch_.size()) {
+			Task &task = overflow_batch_[overflow_position_];
+			++overflow_position_;
+			task();
+			task.reset();
+			did_perform = true;
+			continue;
+		}
+
+		if(has_pending()) {
+			const size_t position = read_position_.load(std::memory_order_relaxed);
+			Slot &slot = ring_[position % RingSize];
+			slot.task();
+			slot.task.reset();
+			slot.sequence.store(position + RingSize, std::memory_order_release);
+			read_position_.store(position + 1, std::memory_order_relaxed);
+			did_perform = true;
+			continue;
+		}
+
+		if(!take_overflow()) break;
+	}
+	return did_perform;
+}
+
+bool AsyncTaskQueue::perform_pending() {
+	{
+		std::lock_guard<std::mutex> lock(perform_mutex_);
+		perform_tasks();
+
+		// Remain scheduled if there's more of the overflow batch to perform.
+		if(overflow_position_ < overflow_batch_.size()) {
+			return true;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(idle_mutex_);
+		is_scheduled_ = false;
+
+		// A producer that added a task after the check above, but before is_scheduled_ was cleared,
+		// won't have scheduled this queue; so check again.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(has_any_pending() && !is_scheduled_.exchange(true)) {
+			return true;
+		}
+	}
+
+	// This queue is no longer scheduled, so may already have been destroyed; announce that to
+	// anything waiting without touching it.
+	ThreadPool::shared().notify();
+	return false;
+}
+#endif
+
+void AsyncTaskQueue::enqueue(Task &&function) {
 #ifdef __APPLE__
-	dispatch_async(serial_dispatch_queue_, ^{function();});
+	dispatch_async_f(serial_dispatch_queue_, new Task(std::move(function)), [] (void *context) {
+		const auto task = static_cast<Task *>(context);
+		(*task)();
+		delete task;
+	});
 #else
-	std::lock_guard<std::mutex> lock(queue_mutex_);
-	pending_tasks_.push_back(function);
-	processing_condition_.notify_all();
+	add(function);
+	schedule();
 #endif
 }
 
@@ -70,14 +178,29 @@ void AsyncTaskQueue::flush() {
 #ifdef __APPLE__
 	dispatch_sync(serial_dispatch_queue_, ^{});
 #else
-	auto flush_mutex = std::make_shared<std::mutex>();
-	auto flush_condition = std::make_shared<std::condition_variable>();
-	std::unique_lock<std::mutex> lock(*flush_mutex);
-	enqueue([=] () {
-		std::unique_lock<std::mutex> inner_lock(*flush_mutex);
-		flush_condition->notify_all();
+	std::atomic<bool> has_flushed = false;
+	enqueue([&has_flushed] {
+		has_flushed.store(true, std::memory_order_release);
+		ThreadPool::shared().notify();
+	});
+
+	// Helping the pool with arbitrary jobs while waiting could mean performing one that waits upon
+	// something further up this thread's stack, such as a queue whose task is calling flush. So help
+	// only with this queue's own tasks, and only if no pool thread is already performing them.
+	if(perform_mutex_.try_lock()) {
+		while(!has_flushed.load(std::memory_order_acquire) && perform_tasks()) {}
+
+		// Don't leave part of an overflow batch behind; the pool thread that performs this queue
+		// next may already have decided that there's nothing left to do.
+		while(overflow_position_ < overflow_batch_.size()) {
+			perform_tasks();
+		}
+		perform_mutex_.unlock();
+	}
+
+	ThreadPool::shared().wait_without_performing([&has_flushed] {
+		return has_flushed.load(std::memory_order_acquire);
 	});
-	flush_condition->wait(lock);
 #endif
 }
 
@@ -86,20 +209,26 @@ DeferringAsyncTaskQueue::~DeferringAsyncTaskQueue() {
 	flush();
 }
 
-void DeferringAsyncTaskQueue::defer(std::function<void(void)> function) {
-	if(!deferred_tasks_) {
-		deferred_tasks_ = std::make_shared<std::list<std::function<void(void)>>>();
-	}
-	deferred_tasks_->push_back(function);
+void DeferringAsyncTaskQueue::defer(Task &&function) {
+	deferred_tasks_.push_back(std::move(function));
 }
 
 void DeferringAsyncTaskQueue::perform() {
-	if(!deferred_tasks_) return;
-	std::shared_ptr<std::list<std::function<void(void)>>> deferred_tasks = deferred_tasks_;
-	deferred_tasks_.reset();
-	enqueue([deferred_tasks] {
-		for(const auto &function : *deferred_tasks) {
+	if(deferred_tasks_.empty()) return;
+
+#ifdef __APPLE__
+	enqueue([deferred_tasks = std::move(deferred_tasks_)] () mutable {
+		for(auto &function : deferred_tasks) {
 			function();
 		}
 	});
+	deferred_tasks_.clear();
+#else
+	// Add all deferred tasks to the ring, but schedule the queue only once.
+	for(auto &function : deferred_tasks_) {
+		add(function);
+	}
+	deferred_tasks_.clear();
+	schedule();
+#endif
 }
@@ -11,21 +11,142 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #ifdef __APPLE__
 #include <dispatch/dispatch.h>
+#else
+#include "ThreadPool.hpp"
 #endif
 
 namespace Concurrency {
 
+/*!
+	A move-only void(void) closure. Closures with captures of up to a few words are stored in place
+	so that constructing, moving and performing a Task doesn't touch the heap; larger closures are
+	stored on the heap.
+*/
+class Task {
+	public:
+		Task() noexcept = default;
+
+		template <typename Function, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, Task>>>
+		Task(Function &&function) {
+			using Stored = std::decay_t<Function>;
+			if constexpr (IsInPlace<Stored>) {
+				new (&storage_) Stored(std::forward<Function>(function));
+			} else {
+				*reinterpret_cast<Stored **>(&storage_) = new Stored(std::forward<Function>(function));
+			}
+			operations_ = &operations<Stored>;
+		}
+
+		Task(Task &&rhs) noexcept {
+			take(rhs);
+		}
+
+		Task &operator =(Task &&rhs) noexcept {
+			if(this != &rhs) {
+				reset();
+				take(rhs);
+			}
+			return *this;
+		}
+
+		~Task() {
+			reset();
+		}
+
+		/// Performs this task, which must not be empty.
+		void operator()() {
+			operations_->perform(&storage_);
+		}
+
+		/// @returns @c true if this task is not empty.
+		explicit operator bool() const {
+			return operations_;
+		}
+
+		/// Destroys the closure held by this task, if any, leaving it empty.
+		void reset() {
+			if(operations_) {
+				operations_->destroy(&storage_);
+				operations_ = nullptr;
+			}
+		}
+
+	private:
+		using Storage = std::aligned_storage_t<6 * sizeof(void *), alignof(std::max_align_t)>;
+		Storage storage_;
+
+		template <typename Stored> static constexpr bool IsInPlace =
+			sizeof(Stored) <= sizeof(Storage) &&
+			alignof(Stored) <= alignof(Storage) &&
+			std::is_nothrow_move_constructible_v<Stored>;
+
+		template <typename Stored> static Stored &stored(void *storage) {
+			if constexpr (IsInPlace<Stored>) {
+				return *reinterpret_cast<Stored *>(storage);
+			} else {
+				return **reinterpret_cast<Stored **>(storage);
+			}
+		}
+
+		struct Operations {
+			void (*perform)(void *);
+			void (*move)(void *source, void *destination);
+			void (*destroy)(void *);
+		};
+		template <typename Stored> static constexpr Operations operations = {
+			[] (void *storage) {
+				stored<Stored>(storage)();
+			},
+			[] (void *source, void *destination) {
+				if constexpr (IsInPlace<Stored>) {
+					new (destination) Stored(std::move(stored<Stored>(source)));
+					stored<Stored>(source).~Stored();
+				} else {
+					*reinterpret_cast<Stored **>(destination) = *reinterpret_cast<Stored **>(source);
+				}
+			},
+			[] (void *storage) {
+				if constexpr (IsInPlace<Stored>) {
+					stored<Stored>(storage).~Stored();
+				} else {
+					delete *reinterpret_cast<Stored **>(storage);
+				}
+			},
+		};
+		const Operations *operations_ = nullptr;
+
+		void take(Task &rhs) {
+			operations_ = rhs.operations_;
+			if(operations_) {
+				operations_->move(&rhs.storage_, &storage_);
+				rhs.operations_ = nullptr;
+			}
+		}
+};
+
 /*!
 	An async task queue allows a caller to enqueue void(void) functions. Those functions are guaranteed
 	to be performed serially and asynchronously from the caller. A caller may also request to flush,
 	causing it to block until all previously-enqueued functions are complete.
+
+	Other than on Apple platforms, where each queue is a serial dispatch queue, queues do not own threads;
+	all queues share the process-wide ThreadPool, each queue acting as a strand: it is scheduled onto the
+	pool whenever it has work pending, and is never being performed by more than one thread at a time.
+	Pending tasks are held in a fixed-size lock-free ring, so enqueuing neither takes a lock nor allocates
+	unless the ring is full, in which case further tasks are held in a list until it has drained.
 */
 class AsyncTaskQueue {
 	public:
@@ -36,13 +157,16 @@ class AsyncTaskQueue {
 			Adds @c function to the queue.
 
 			@discussion Functions will be performed serially and asynchronously. This method is safe to
-			call from multiple threads.
+			call from multiple threads, including from a function on this queue, and never blocks.
 			@parameter function The function to enqueue.
 		*/
-		void enqueue(std::function<void(void)> function);
+		void enqueue(Task &&function);
 
 		/*!
 			Blocks the caller until all previously-enqueud functions have completed.
+
+			@discussion Other than on Apple platforms, the caller may perform some of this queue's functions
+			itself while it waits, but never those of any other queue.
 		*/
 		void flush();
 
@@ -50,19 +174,84 @@ class AsyncTaskQueue {
 #ifdef __APPLE__
 		dispatch_queue_t serial_dispatch_queue_;
 #else
-		std::unique_ptr<std::thread> thread_;
+		friend class DeferringAsyncTaskQueue;
+
+		// A bounded multiple-producer, single-consumer ring of pending tasks. Each slot's sequence
+		// number indicates whether it is free for the producer that claims position n, in which case
+		// it is n, or holds a task for the consumer at position n, in which case it is n+1.
+		static constexpr size_t RingSize = 128;
+		struct Slot {
+			std::atomic<size_t> sequence;
+			Task task;
+		};
+		Slot ring_[RingSize];
+		std::atomic<size_t> write_position_ = 0;
+
+		// Written only by whichever thread is performing this queue, but may be read by the
+		// thread that has just relinquished it, hence atomic.
+		std::atomic<size_t> read_position_ = 0;
+
+		/// Attempts to add @c task to the ring, returning @c true on success or @c false if the ring is full.
+		bool push(Task &task);
+
+		// Tasks that didn't fit into the ring, in order. While there are any, new tasks are added here too
+		// so that order is preserved, and they are taken only once all tasks in the ring have been performed.
+		std::mutex overflow_mutex_;
+		std::vector<Task> overflow_;
+		std::atomic<bool> is_overflowing_ = false;
+
+		// Overflow tasks taken for performance, and the index of the next to perform; accessed only
+		// by whichever thread is performing this queue.
+		std::vector<Task> overflow_batch_;
+		size_t overflow_position_ = 0;
+
+		/// Adds @c task to the ring or, if the ring is full or has overflowed, to the overflow list.
+		void add(Task &task);
+
+		/// Moves the overflow list to the overflow batch, returning @c true if there was anything to move.
+		bool take_overflow();
+
+		/// @returns @c true if the ring contains a task ready to be performed.
+		bool has_pending() const;
+
+		/// @returns @c true if the ring or overflow list contains a task ready to be performed; this may be
+		/// called by a thread that has just relinquished this queue.
+		bool has_any_pending() const;
+
+		/// Schedules this queue onto the pool if it isn't already scheduled.
+		void schedule();
+
+		// Set while this queue is either waiting for, or being performed by, a pool thread.
+		std::atomic<bool> is_scheduled_ = false;
+
+		// Held while is_scheduled_ is being cleared, and while checking whether it has been, so that a
+		// queue isn't destroyed while the thread that last performed it is still inspecting it.
+		std::mutex idle_mutex_;
+
+		// Held by whichever thread is performing this queue's tasks: either the pool thread performing
+		// job_, or a thread that is performing them itself while it flushes.
+		std::mutex perform_mutex_;
+
+		/// Performs up to a ring's worth of pending tasks, returning @c true if any were performed.
+		/// The caller must hold perform_mutex_.
+		bool perform_tasks();
+
+		/// Performs all tasks currently pending, returning @c true if more arrived meanwhile.
+		bool perform_pending();
 
-		std::mutex queue_mutex_;
-		std::list<std::function<void(void)>> pending_tasks_;
-		std::condition_variable processing_condition_;
-		std::atomic_bool should_destruct_;
+		struct Job: public ThreadPool::Job {
+			Job(AsyncTaskQueue &queue) : queue_(queue) {}
+			bool perform() final {
+				return queue_.perform_pending();
+			}
+			AsyncTaskQueue &queue_;
+		} job_{*this};
 #endif
 };
 
 /*!
 	A deferring async task queue is one that accepts a list of functions to be performed but defers
-	any action until told to perform. It performs them by enquing a single asynchronous task that will
-	perform the deferred tasks in order.
+	any action until told to perform, at which point it enqueues all deferred tasks at once.
 
 	It therefore offers similar semantics to an asynchronous task queue, but allows for management of
 	synchronisation costs, since neither defer nor perform make any effort to be thread safe.
@@ -76,20 +265,18 @@ class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 
 			This is not thread safe; it should be serialised with other calls to itself and to perform.
 		*/
-		void defer(std::function<void(void)> function);
+		void defer(Task &&function);
 
 		/*!
-			Enqueues a function that will perform all currently deferred functions, in the
-			order that they were deferred.
+			Enqueues all currently deferred functions, to be performed in the order that they were deferred.
 
 			This is not thread safe; it should be serialised with other calls to itself and to defer.
 		*/
 		void perform();
 
 	private:
-		// TODO: this is a shared_ptr because of the issues capturing moveables in C++11;
-		// switch to a unique_ptr if/when adapting to C++14
-		std::shared_ptr<std::list<std::function<void(void)>>> deferred_tasks_;
+		// Retained between calls to perform, so that its storage is reused.
+		std::vector<Task> deferred_tasks_;
 };
 
 }
@@ -0,0 +1,230 @@
+//
+//  ThreadPool.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace Concurrency;
+
+thread_local int ThreadPool::worker_index_ = -1;
+
+ThreadPool &ThreadPool::shared() {
+	// The pool is deliberately never destroyed, so that it remains available to anything
+	// that is itself being destroyed during static destruction.
+	static ThreadPool *const pool = new ThreadPool;
+	return *pool;
+}
+
+ThreadPool::ThreadPool() :
+	thread_count_(std::max(2u, std::thread::hardware_concurrency())),
+	deques_(new Deque[thread_count_]) {
+	for(size_t c = 0; c < thread_count_; ++c) {
+		std::thread([this, c] {
+			worker_index_ = int(c);
+			while(true) {
+				if(Job *const job = find_job()) {
+					perform(job);
+					continue;
+				}
+
+				const uint32_t epoch = work_event_.prepare_wait();
+				if(Job *const job = find_job()) {
+					work_event_.cancel_wait();
+					perform(job);
+					continue;
+				}
+				work_event_.commit_wait(epoch);
+			}
+		}).detach();
+	}
+}
+
+// MARK: - Scheduling.
+
+void ThreadPool::schedule(Job *job) {
+	if(worker_index_ < 0 || !deques_[size_t(worker_index_)].push(job)) {
+		inject(job);
+	}
+	work_event_.notify_one();
+}
+
+void ThreadPool::notify() {
+	notify_event_.notify_all();
+	if(pool_waiters_.load(std::memory_order_seq_cst)) {
+		work_event_.notify_all();
+	}
+}
+
+void ThreadPool::inject(Job *job) {
+	Job *next = injected_.load(std::memory_order_relaxed);
+	do {
+		job->next_ = next;
+	} while(!injected_.compare_exchange_weak(next, job, std::memory_order_seq_cst, std::memory_order_relaxed));
+}
+
+ThreadPool::Job *ThreadPool::take_injected() {
+	if(!injected_.load(std::memory_order_relaxed)) return nullptr;
+	Job *job = injected_.exchange(nullptr, std::memory_order_acquire);
+	if(!job) return nullptr;
+
+	// Restore scheduling order, keep the oldest job and move the rest to this thread's deque,
+	// from where other threads can steal them.
+	Job *oldest = nullptr;
+	while(job) {
+		Job *const next = job->next_;
+		job->next_ = oldest;
+		oldest = job;
+		job = next;
+	}
+
+	auto &deque = deques_[size_t(worker_index_)];
+	for(Job *other = oldest->next_; other;) {
+		Job *const next = other->next_;
+		if(!deque.push(other)) inject(other);
+		other = next;
+	}
+	if(oldest->next_) work_event_.notify_one();
+	return oldest;
+}
+
+ThreadPool::Job *ThreadPool::find_job() {
+	// Prefer this thread's own work, then anything injected, then steal from the other threads,
+	// starting with the next in sequence so that thieves spread out.
+	const size_t index = size_t(worker_index_);
+	if(Job *const job = deques_[index].take()) return job;
+	if(Job *const job = take_injected()) return job;
+	for(size_t c = 1; c < thread_count_; ++c) {
+		if(Job *const job = deques_[(index + c) % thread_count_].take()) return job;
+	}
+	return nullptr;
+}
+
+bool ThreadPool::has_work() const {
+	if(injected_.load(std::memory_order_seq_cst)) return true;
+	for(size_t c = 0; c < thread_count_; ++c) {
+		if(!deques_[c].empty()) return true;
+	}
+	return false;
+}
+
+bool ThreadPool::perform_one() {
+	Job *const job = find_job();
+	if(!job) return false;
+	perform(job);
+	return true;
+}
+
+void ThreadPool::perform(Job *job) {
+	if(job->perform()) {
+		schedule(job);
+	}
+}
+
+// MARK: - Deque.
+
+bool ThreadPool::Deque::push(Job *job) {
+	const int64_t back = back_.load(std::memory_order_relaxed);
+	if(back - front_.load(std::memory_order_acquire) >= Capacity) return false;
+
+	jobs_[back % Capacity].store(job, std::memory_order_relaxed);
+	back_.store(back + 1, std::memory_order_seq_cst);
+	return true;
+}
+
+ThreadPool::Job *ThreadPool::Deque::take() {
+	int64_t front = front_.load(std::memory_order_acquire);
+	while(front < back_.load(std::memory_order_seq_cst)) {
+		// The slot may be overwritten by the owner once another thread has taken it, in which case
+		// the compare-and-swap below will fail; so the job is only used if it succeeds.
+		Job *const job = jobs_[front % Capacity].load(std::memory_order_relaxed);
+		if(front_.compare_exchange_weak(front, front + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+bool ThreadPool::Deque::empty() const {
+	return front_.load(std::memory_order_seq_cst) >= back_.load(std::memory_order_seq_cst);
+}
+
+// MARK: - Event.
+
+#ifdef __linux__
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+namespace {
+
+void futex(std::atomic<uint32_t> &word, int operation, uint32_t value) {
+	syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), operation, value, nullptr, nullptr, 0);
+}
+
+}
+#endif
+
+uint32_t ThreadPool::Event::prepare_wait() {
+	waiters_.fetch_add(1, std::memory_order_seq_cst);
+	return epoch_.load(std::memory_order_seq_cst);
+}
+
+void ThreadPool::Event::cancel_wait() {
+	waiters_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void ThreadPool::Event::commit_wait(uint32_t epoch) {
+#ifdef __linux__
+	while(epoch_.load(std::memory_order_seq_cst) == epoch) {
+		futex(epoch_, FUTEX_WAIT_PRIVATE, epoch);
+	}
+#else
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		condition_.wait(lock, [this, epoch] {
+			return epoch_.load(std::memory_order_seq_cst) != epoch;
+		});
+	}
+#endif
+	waiters_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void ThreadPool::Event::notify_one() {
+	epoch_.fetch_add(1, std::memory_order_seq_cst);
+	if(!waiters_.load(std::memory_order_seq_cst)) return;
+
+#ifdef __linux__
+	futex(epoch_, FUTEX_WAKE_PRIVATE, 1);
+#else
+	// Acquiring the mutex ensures that any thread that has checked the epoch is now waiting.
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+	}
+	condition_.notify_one();
+#endif
+}
+
+void ThreadPool::Event::notify_all() {
+	epoch_.fetch_add(1, std::memory_order_seq_cst);
+	if(!waiters_.load(std::memory_order_seq_cst)) return;
+
+#ifdef __linux__
+	futex(epoch_, FUTEX_WAKE_PRIVATE, INT32_MAX);
+#else
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+	}
+	condition_.notify_all();
+#endif
+}
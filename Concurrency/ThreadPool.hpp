@@ -0,0 +1,201 @@
+//
+//  ThreadPool.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace Concurrency {
+
+/*!
+	A process-wide, work-stealing pool of threads, one per core.
+
+	Each thread has a deque of its own. Jobs scheduled by one of the pool's threads are added to that
+	thread's deque; those scheduled by any other thread are added to a shared injection list. A thread
+	that has run out of work takes from the injection list and then steals from the other threads,
+	sleeping only once there is nothing left to take.
+
+	Scheduling neither takes a lock nor allocates. Sleeping threads are woken via a futex where one
+	is available, and scheduling makes a system call only if there are sleeping threads to wake.
+*/
+class ThreadPool {
+	public:
+		/*!
+			A unit of work that can be scheduled onto the pool. Jobs are linked intrusively, so that
+			scheduling one needn't allocate.
+		*/
+		class Job {
+			protected:
+				~Job() = default;
+
+				/*!
+					Performs some or all of this job.
+
+					@returns @c true if this job should be scheduled again, e.g. because it performed only
+					a bounded amount of work and more remains.
+				*/
+				virtual bool perform() = 0;
+
+			private:
+				friend class ThreadPool;
+				Job *next_ = nullptr;
+		};
+
+		/// @returns The process-wide pool.
+		static ThreadPool &shared();
+
+		/*!
+			Schedules @c job to be performed by one of the pool's threads. A job must not be scheduled
+			again until it has begun to be performed.
+		*/
+		void schedule(Job *job);
+
+		/*!
+			Blocks the caller until @c predicate returns @c true. The predicate is reevaluated whenever
+			@c notify is called, so whatever makes it true should subsequently call @c notify.
+
+			If called from one of the pool's own threads, other jobs are performed while waiting, so that
+			a job that waits upon another can't exhaust the pool.
+		*/
+		template <typename Predicate> void wait(Predicate predicate) {
+			if(worker_index_ < 0) {
+				wait_without_performing(predicate);
+				return;
+			}
+
+			// Pool threads sleep only when there's nothing else to do, and so must be woken either
+			// by a notification or by new work.
+			pool_waiters_.fetch_add(1, std::memory_order_seq_cst);
+			while(!predicate()) {
+				if(perform_one()) continue;
+
+				const uint32_t epoch = work_event_.prepare_wait();
+				if(predicate() || has_work()) {
+					work_event_.cancel_wait();
+					continue;
+				}
+				work_event_.commit_wait(epoch);
+			}
+			pool_waiters_.fetch_sub(1, std::memory_order_seq_cst);
+
+			// If this thread was woken for new work but is returning instead, pass the wakeup on.
+			if(has_work()) work_event_.notify_one();
+		}
+
+		/*!
+			Blocks the caller until @c predicate returns @c true, as per @c wait, but never performs other
+			jobs meanwhile, even if called from one of the pool's own threads. This is for waits that could
+			otherwise end up performing a job that waits upon something further up the caller's stack.
+		*/
+		template <typename Predicate> void wait_without_performing(Predicate predicate) {
+			while(!predicate()) {
+				const uint32_t epoch = notify_event_.prepare_wait();
+				if(predicate()) {
+					notify_event_.cancel_wait();
+					break;
+				}
+				notify_event_.commit_wait(epoch);
+			}
+		}
+
+		/*!
+			Wakes all threads that are blocked in @c wait or @c wait_without_performing, so that they
+			reevaluate their predicates.
+		*/
+		void notify();
+
+		/// @returns The number of threads in the pool.
+		size_t thread_count() const {
+			return thread_count_;
+		}
+
+	private:
+		ThreadPool();
+
+		/*!
+			A single-producer, multiple-consumer queue of jobs; the thread that owns it adds to the back
+			and any thread may take from the front, the owner included, so that a job that reschedules
+			itself goes behind any others.
+		*/
+		class Deque {
+			public:
+				/// Adds @c job to the back of the deque, returning @c false if the deque is full. Owner only.
+				bool push(Job *job);
+
+				/// @returns The job at the front of the deque, or @c nullptr if it is empty.
+				Job *take();
+
+				/// @returns @c true if the deque appeared to be empty when checked.
+				bool empty() const;
+
+			private:
+				static constexpr int64_t Capacity = 1024;
+				alignas(64) std::atomic<int64_t> front_ = 0;
+				alignas(64) std::atomic<int64_t> back_ = 0;
+				std::atomic<Job *> jobs_[Capacity];
+		};
+
+		/*!
+			An event count: a thread that wishes to sleep until some condition is met calls @c prepare_wait,
+			checks the condition and then either calls @c cancel_wait, if it is met, or @c commit_wait with
+			the value returned by @c prepare_wait. Any notification after @c prepare_wait wakes it.
+
+			Notifications are a single atomic increment if there are no waiters.
+		*/
+		class Event {
+			public:
+				uint32_t prepare_wait();
+				void cancel_wait();
+				void commit_wait(uint32_t epoch);
+
+				void notify_one();
+				void notify_all();
+
+			private:
+				std::atomic<uint32_t> epoch_ = 0;
+				std::atomic<uint32_t> waiters_ = 0;
+
+#ifndef __linux__
+				std::mutex mutex_;
+				std::condition_variable condition_;
+#endif
+		};
+
+		const size_t thread_count_;
+		std::unique_ptr<Deque[]> deques_;
+
+		// Jobs scheduled from outside of the pool, most recent first; a thread that takes from
+		// this list takes all of it at once, so that a job is never popped from under another.
+		std::atomic<Job *> injected_ = nullptr;
+
+		// work_event_ is signalled when a job is scheduled; it is waited upon by idle pool threads, and by
+		// pool threads that are within wait. notify_event_ is signalled by notify, and waited upon by
+		// other threads within wait.
+		Event work_event_;
+		Event notify_event_;
+		std::atomic<int> pool_waiters_ = 0;
+
+		static thread_local int worker_index_;
+
+		void inject(Job *job);
+		Job *take_injected();
+		Job *find_job();
+		bool has_work() const;
+		bool perform_one();
+		void perform(Job *job);
+};
+
+}
+
+#endif /* ThreadPool_hpp */
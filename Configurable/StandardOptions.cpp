@@ -43,6 +43,8 @@ std::vector<std::unique_ptr<Configurable::Option>> Configurable::standard_option
 	}
 	if(mask & AutomaticTapeMotorControl)	options.emplace_back(new Configurable::BooleanOption("Automatic Tape Motor Control", "autotapemotor"));
 	if(mask & QuickBoot)					options.emplace_back(new Configurable::BooleanOption("Boot Quickly", "quickboot"));
+	if(mask & QuickProcessor)				options.emplace_back(new Configurable::BooleanOption("Run Processor Quickly", "quickprocessor"));
+	if(mask & QuickType)					options.emplace_back(new Configurable::BooleanOption("Type Quickly", "quicktype"));
 	return options;
 }
 
@@ -71,6 +73,14 @@ void Configurable::append_quick_boot_selection(Configurable::SelectionSet &selec
 	append_bool(selection_set, "quickboot", selection);
 }
 
+void Configurable::append_quick_processor_selection(Configurable::SelectionSet &selection_set, bool selection) {
+	append_bool(selection_set, "quickprocessor", selection);
+}
+
+void Configurable::append_quick_type_selection(Configurable::SelectionSet &selection_set, bool selection) {
+	append_bool(selection_set, "quicktype", selection);
+}
+
 // MARK: - Selection parsers
 bool Configurable::get_quick_load_tape(const Configurable::SelectionSet &selections_by_option, bool &result) {
 	return get_bool(selections_by_option, "quickload", result);
@@ -106,3 +116,11 @@ bool Configurable::get_display(const Configurable::SelectionSet &selections_by_o
 bool Configurable::get_quick_boot(const Configurable::SelectionSet &selections_by_option, bool &result) {
 	return get_bool(selections_by_option, "quickboot", result);
 }
+
+bool Configurable::get_quick_processor(const Configurable::SelectionSet &selections_by_option, bool &result) {
+	return get_bool(selections_by_option, "quickprocessor", result);
+}
+
+bool Configurable::get_quick_type(const Configurable::SelectionSet &selections_by_option, bool &result) {
+	return get_bool(selections_by_option, "quicktype", result);
+}
@@ -21,6 +21,8 @@ enum StandardOptions {
 	QuickLoadTape				= (1 << 4),
 	AutomaticTapeMotorControl	= (1 << 5),
 	QuickBoot					= (1 << 6),
+	QuickProcessor				= (1 << 7),
+	QuickType					= (1 << 8),
 };
 
 enum class Display {
@@ -55,6 +57,16 @@ void append_display_selection(SelectionSet &selection_set, Display selection);
 */
 void append_quick_boot_selection(SelectionSet &selection_set, bool selection);
 
+/*!
+	Appends to @c selection_set a selection of @c selection for QuickProcessor.
+*/
+void append_quick_processor_selection(SelectionSet &selection_set, bool selection);
+
+/*!
+	Appends to @c selection_set a selection of @c selection for QuickType.
+*/
+void append_quick_type_selection(SelectionSet &selection_set, bool selection);
+
 /*!
 	Attempts to discern a QuickLoadTape selection from @c selections_by_option.
  
@@ -91,6 +103,24 @@ bool get_display(const SelectionSet &selections_by_option, Display &result);
 */
 bool get_quick_boot(const SelectionSet &selections_by_option, bool &result);
 
+/*!
+	Attempts to discern a QuickProcessor selection from @c selections_by_option.
+
+	@param selections_by_option The user selections.
+	@param result The location to which the selection will be stored if found.
+	@returns @c true if a selection is found; @c false otherwise.
+*/
+bool get_quick_processor(const SelectionSet &selections_by_option, bool &result);
+
+/*!
+	Attempts to discern a QuickType selection from @c selections_by_option.
+
+	@param selections_by_option The user selections.
+	@param result The location to which the selection will be stored if found.
+	@returns @c true if a selection is found; @c false otherwise.
+*/
+bool get_quick_type(const SelectionSet &selections_by_option, bool &result);
+
 }
 
 #endif /* StandardOptions_hpp */
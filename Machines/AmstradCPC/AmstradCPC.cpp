@@ -34,6 +34,7 @@
 
 #include "../../Analyser/Static/AmstradCPC/Target.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -41,7 +42,7 @@ namespace AmstradCPC {
 
 std::vector<std::unique_ptr<Configurable::Option>> get_options() {
 	return Configurable::standard_options(
-		Configurable::StandardOptions(Configurable::DisplayRGB | Configurable::DisplayCompositeColour)
+		Configurable::StandardOptions(Configurable::DisplayRGB | Configurable::DisplayCompositeColour | Configurable::QuickProcessor | Configurable::QuickType)
 	);
 }
 
@@ -103,6 +104,18 @@ class InterruptTimer {
 			return last_interrupt_request_ != interrupt_request_;
 		}
 
+		/// @returns @c true if an interrupt is currently requested; @c false otherwise. Doesn't affect @c request_has_changed.
+		inline bool is_requesting() const {
+			return interrupt_request_;
+		}
+
+		/// @returns A lower bound on the number of further hsyncs that will occur before an interrupt is next requested.
+		inline int get_minimum_hsyncs_until_request() const {
+			// Either the counter will reach 52 or else a vsync, which might occur at any time, will
+			// be followed two hsyncs later by a request if the counter has by then reached 32.
+			return std::min(52 - timer_, reset_counter_ ? reset_counter_ : std::max(2, 32 - timer_));
+		}
+
 		/// Resets the timer.
 		inline void reset_count() {
 			timer_ = 0;
@@ -582,12 +595,23 @@ class KeyboardState: public GI::AY38910::PortHandler {
 		*/
 		uint8_t get_port_input(bool port_b) {
 			if(!port_b && row_ < sizeof(rows_)) {
+				read_row_ = int(row_);
 				return (row_ == 6) ? rows_[row_] & joy2_state_ : rows_[row_];
 			}
 
 			return 0xff;
 		}
 
+		/*!
+			@returns The row most recently reported to the AY, or -1 if none has been reported since
+			this was last called.
+		*/
+		int take_read_row() {
+			const int row = read_row_;
+			read_row_ = -1;
+			return row;
+		}
+
 		/*!
 			Sets whether @c key on line @c line is currently pressed.
 		*/
@@ -612,6 +636,7 @@ class KeyboardState: public GI::AY38910::PortHandler {
 		uint8_t joy2_state_ = 0xff;
 		uint8_t rows_[10] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
 		size_t row_ = 0;
+		int read_row_ = -1;
 		std::vector<std::unique_ptr<Inputs::Joystick>> joysticks_;
 
 		class Joystick: public Inputs::ConcreteJoystick {
@@ -942,12 +967,18 @@ template <bool has_fdc> class ConcreteMachine:
 					}
 				break;
 				case CPU::Z80::PartialMachineCycle::Input:
+					did_perform_input_ = true;
+
 					// Default to nothing answering
 					*cycle.value = 0xff;
 
 					// Check for a PIO access
 					if(!(address & 0x800)) {
 						*cycle.value &= i8255_.read((address >> 8) & 3);
+
+						// If that read a keyboard row, let the typer know.
+						const int row = key_state_.take_read_row();
+						if(typer_ && row >= 0) typer_->did_read_keyboard_line(row);
 					}
 
 					// Check for an FDC access
@@ -994,6 +1025,31 @@ template <bool has_fdc> class ConcreteMachine:
 		}
 
 		/// Another Z80 entry point; indicates that a partcular run request has concluded.
+		HalfCycles skip_idle_loop(HalfCycles iteration_length, HalfCycles available) {
+			// A loop that performs input might see the keyboard, tape, FDC or CRTC change at any time; a loop
+			// that reads only memory can't see anything change until the next interrupt. So, while nothing is
+			// being typed, such loops may be skipped up until just before the interrupt timer could next fire.
+			// Only whole multiples of the four-cycle bus phase are skipped, to retain the current wait pattern.
+			if(did_perform_input_) {
+				did_perform_input_ = false;
+				return HalfCycles(0);
+			}
+			if(typer_ || interrupt_timer_.is_requesting() || (iteration_length.as_integral() & 7)) return HalfCycles(0);
+
+			// The CRTC is clocked once every eight half cycles.
+			const auto limit = std::min(
+				available.as_integral(),
+				HalfCycles::IntType(interrupt_timer_.get_minimum_hsyncs_until_request() - 1) * crtc_.get_characters_per_line() * 8
+			);
+			if(limit <= 1) return HalfCycles(0);
+
+			const HalfCycles skipped = HalfCycles(((limit - 1) / iteration_length.as_integral()) * iteration_length.as_integral());
+			if(skipped > HalfCycles(0)) {
+				perform_machine_cycle(CPU::Z80::PartialMachineCycle(CPU::Z80::PartialMachineCycle::Internal, skipped, nullptr, nullptr, false));
+			}
+			return skipped;
+		}
+
 		void flush() {
 			// Just flush the AY.
 			ay_.update();
@@ -1057,6 +1113,10 @@ template <bool has_fdc> class ConcreteMachine:
 			return Cycles(160000);	// Type one character per frame.
 		}
 
+		int get_typer_keyboard_lines() override final {
+			return use_quick_typing_ ? 10 : 0;
+		}
+
 		// See header; sets a key as either pressed or released.
 		void set_key_state(uint16_t key, bool isPressed) override final {
 			key_state_.set_is_pressed(isPressed, key >> 4, key & 7);
@@ -1086,17 +1146,35 @@ template <bool has_fdc> class ConcreteMachine:
 			if(Configurable::get_display(selections_by_option, display)) {
 				set_video_signal_configurable(display);
 			}
+
+			// All memory accesses can be performed directly by the Z80; the paging registers are accessed via
+			// the I/O space and the read and write pointers are updated in place. The wait line is kept
+			// accurate because the Z80 announces direct time before sampling it.
+			bool quick_processor;
+			if(Configurable::get_quick_processor(selections_by_option, quick_processor)) {
+				z80_.set_memory_map(quick_processor ? read_pointers_ : nullptr, write_pointers_, 14);
+				z80_.set_idle_loop_detection_enabled(quick_processor);
+			}
+
+			bool quick_type;
+			if(Configurable::get_quick_type(selections_by_option, quick_type)) {
+				use_quick_typing_ = quick_type;
+			}
 		}
 
 		Configurable::SelectionSet get_accurate_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_display_selection(selection_set, Configurable::Display::RGB);
+			Configurable::append_quick_processor_selection(selection_set, false);
+			Configurable::append_quick_type_selection(selection_set, false);
 			return selection_set;
 		}
 
 		Configurable::SelectionSet get_user_friendly_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_display_selection(selection_set, Configurable::Display::RGB);
+			Configurable::append_quick_processor_selection(selection_set, false);
+			Configurable::append_quick_type_selection(selection_set, false);
 			return selection_set;
 		}
 
@@ -1151,7 +1229,7 @@ template <bool has_fdc> class ConcreteMachine:
 			}
 		}
 
-		CPU::Z80::Processor<ConcreteMachine, false, true> z80_;
+		CPU::Z80::Processor<ConcreteMachine, false, true, true> z80_;
 
 		CRTCBusHandler crtc_bus_handler_;
 		Motorola::CRTC::CRTC6845<CRTCBusHandler> crtc_;
@@ -1183,6 +1261,7 @@ template <bool has_fdc> class ConcreteMachine:
 
 		bool fdc_is_sleeping_;
 		bool tape_player_is_sleeping_;
+		bool did_perform_input_ = false;
 		bool has_128k_;
 
 		enum ROMType: int {
@@ -1198,6 +1277,7 @@ template <bool has_fdc> class ConcreteMachine:
 
 		KeyboardState key_state_;
 		AmstradCPC::KeyboardMapper keyboard_mapper_;
+		bool use_quick_typing_ = false;
 };
 
 }
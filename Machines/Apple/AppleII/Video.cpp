@@ -8,6 +8,8 @@
 
 #include "Video.hpp"
 
+#include <cstring>
+
 using namespace Apple::II::Video;
 
 VideoBase::VideoBase(bool is_iie, std::function<void(Cycles)> &&target) :
@@ -162,6 +164,100 @@ void VideoBase::set_character_rom(const std::vector<uint8_t> &character_rom) {
 	}
 }
 
+namespace {
+
+/*!
+	Holds the pixel patterns produced by each of the video modes, for every possible input, so that
+	each column can be output with a single copy rather than a pixel at a time. Each pattern is
+	exactly what the corresponding mode would produce, i.e. the relevant bit of the source is
+	retained in its original position rather than being normalised.
+*/
+struct ExpansionTables {
+	/// Indexed by source byte, with bit 7 indicating the delay; the first sample of delayed patterns
+	/// should be replaced with the graphics carry.
+	uint8_t high_resolution[256][16];
+
+	/// Indexed by seven-bit pattern; output LSB first as a single 7-sample run.
+	uint8_t double_high_resolution[128][8];
+
+	/// Indexed by seven-bit character pattern; output MSB first, with each pixel doubled for 40 columns.
+	uint8_t text[128][16];
+	uint8_t double_text[128][8];
+
+	/// Indexed by column parity and then colour nibble.
+	uint8_t low_resolution[2][16][16];
+	uint8_t fat_low_resolution[16][16];
+
+	/// Indexed by column parity and then colour nibble; this is the auxiliary half of each column,
+	/// the main half being the second half of the corresponding low-resolution pattern.
+	uint8_t double_low_resolution[2][16][8];
+
+	ExpansionTables() {
+		for(int c = 0; c < 256; ++c) {
+			uint8_t *const target = high_resolution[c];
+			if(c & 0x80) {
+				target[0] = 0;
+				target[1] = target[2] = c & 0x01;
+				target[3] = target[4] = c & 0x02;
+				target[5] = target[6] = c & 0x04;
+				target[7] = target[8] = c & 0x08;
+				target[9] = target[10] = c & 0x10;
+				target[11] = target[12] = c & 0x20;
+				target[13] = c & 0x40;
+			} else {
+				target[0] = target[1] = c & 0x01;
+				target[2] = target[3] = c & 0x02;
+				target[4] = target[5] = c & 0x04;
+				target[6] = target[7] = c & 0x08;
+				target[8] = target[9] = c & 0x10;
+				target[10] = target[11] = c & 0x20;
+				target[12] = target[13] = c & 0x40;
+			}
+		}
+
+		for(int c = 0; c < 128; ++c) {
+			for(int bit = 0; bit < 7; ++bit) {
+				double_high_resolution[c][bit] = uint8_t(c & (0x01 << bit));
+				double_text[c][bit] = text[c][bit*2] = text[c][bit*2 + 1] = uint8_t(c & (0x40 >> bit));
+			}
+		}
+
+		for(int c = 0; c < 16; ++c) {
+			uint8_t *target = low_resolution[0][c];
+			target[0] = target[4] = target[8] = target[12] = c & 1;
+			target[1] = target[5] = target[9] = target[13] = c & 2;
+			target[2] = target[6] = target[10] = c & 4;
+			target[3] = target[7] = target[11] = c & 8;
+
+			target = low_resolution[1][c];
+			target[0] = target[4] = target[8] = target[12] = c & 4;
+			target[1] = target[5] = target[9] = target[13] = c & 8;
+			target[2] = target[6] = target[10] = c & 1;
+			target[3] = target[7] = target[11] = c & 2;
+
+			target = fat_low_resolution[c];
+			target[0] = target[1] = target[8] = target[9] = c & 1;
+			target[2] = target[3] = target[10] = target[11] = c & 2;
+			target[4] = target[5] = target[12] = target[13] = c & 4;
+			target[6] = target[7] = c & 8;
+
+			target = double_low_resolution[0][c];
+			target[0] = target[4] = c & 8;
+			target[1] = target[5] = c & 1;
+			target[2] = target[6] = c & 2;
+			target[3] = c & 4;
+
+			target = double_low_resolution[1][c];
+			target[0] = target[4] = c & 2;
+			target[1] = target[5] = c & 4;
+			target[2] = target[6] = c & 8;
+			target[3] = c & 1;
+		}
+	}
+} expansion_tables;
+
+}
+
 void VideoBase::output_text(uint8_t *target, const uint8_t *const source, size_t length, size_t pixel_row) const {
 	for(size_t c = 0; c < length; ++c) {
 		const int character = source[c] & character_zones[source[c] >> 6].address_mask;
@@ -170,13 +266,7 @@ void VideoBase::output_text(uint8_t *target, const uint8_t *const source, size_t
 		const uint8_t character_pattern = character_rom_[character_address] ^ xor_mask;
 
 		// The character ROM is output MSB to LSB rather than LSB to MSB.
-		target[0] = target[1] = character_pattern & 0x40;
-		target[2] = target[3] = character_pattern & 0x20;
-		target[4] = target[5] = character_pattern & 0x10;
-		target[6] = target[7] = character_pattern & 0x08;
-		target[8] = target[9] = character_pattern & 0x04;
-		target[10] = target[11] = character_pattern & 0x02;
-		target[12] = target[13] = character_pattern & 0x01;
+		memcpy(target, expansion_tables.text[character_pattern & 0x7f], 14);
 		graphics_carry_ = character_pattern & 0x01;
 		target += 14;
 	}
@@ -203,20 +293,8 @@ void VideoBase::output_double_text(uint8_t *target, const uint8_t *const source,
 		};
 
 		// The character ROM is output MSB to LSB rather than LSB to MSB.
-		target[0] = character_patterns[0] & 0x40;
-		target[1] = character_patterns[0] & 0x20;
-		target[2] = character_patterns[0] & 0x10;
-		target[3] = character_patterns[0] & 0x08;
-		target[4] = character_patterns[0] & 0x04;
-		target[5] = character_patterns[0] & 0x02;
-		target[6] = character_patterns[0] & 0x01;
-		target[7] = character_patterns[1] & 0x40;
-		target[8] = character_patterns[1] & 0x20;
-		target[9] = character_patterns[1] & 0x10;
-		target[10] = character_patterns[1] & 0x08;
-		target[11] = character_patterns[1] & 0x04;
-		target[12] = character_patterns[1] & 0x02;
-		target[13] = character_patterns[1] & 0x01;
+		memcpy(&target[0], expansion_tables.double_text[character_patterns[0] & 0x7f], 7);
+		memcpy(&target[7], expansion_tables.double_text[character_patterns[1] & 0x7f], 7);
 		graphics_carry_ = character_patterns[1] & 0x01;
 		target += 14;
 	}
@@ -227,19 +305,10 @@ void VideoBase::output_low_resolution(uint8_t *target, const uint8_t *const sour
 	for(size_t c = 0; c < length; ++c) {
 		// Low-resolution graphics mode shifts the colour code on a loop, but has to account for whether this
 		// 14-sample output window is starting at the beginning of a colour cycle or halfway through.
-		if((column + static_cast<int>(c))&1) {
-			target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 4;
-			target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 8;
-			target[2] = target[6] = target[10] = (source[c] >> row_shift) & 1;
-			target[3] = target[7] = target[11] = (source[c] >> row_shift) & 2;
-			graphics_carry_ = (source[c] >> row_shift) & 8;
-		} else {
-			target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 1;
-			target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 2;
-			target[2] = target[6] = target[10] = (source[c] >> row_shift) & 4;
-			target[3] = target[7] = target[11] = (source[c] >> row_shift) & 8;
-			graphics_carry_ = (source[c] >> row_shift) & 2;
-		}
+		const int parity = (column + static_cast<int>(c))&1;
+		const int colour = (source[c] >> row_shift) & 15;
+		memcpy(target, expansion_tables.low_resolution[parity][colour], 14);
+		graphics_carry_ = colour & (parity ? 8 : 2);
 		target += 14;
 	}
 }
@@ -249,11 +318,9 @@ void VideoBase::output_fat_low_resolution(uint8_t *target, const uint8_t *const
 	for(size_t c = 0; c < length; ++c) {
 		// Fat low-resolution mode appears not to do anything to try to make odd and
 		// even columns compatible.
-		target[0] = target[1] = target[8] = target[9] = (source[c] >> row_shift) & 1;
-		target[2] = target[3] = target[10] = target[11] = (source[c] >> row_shift) & 2;
-		target[4] = target[5] = target[12] = target[13] = (source[c] >> row_shift) & 4;
-		target[6] = target[7] = (source[c] >> row_shift) & 8;
-		graphics_carry_ = (source[c] >> row_shift) & 4;
+		const int colour = (source[c] >> row_shift) & 15;
+		memcpy(target, expansion_tables.fat_low_resolution[colour], 14);
+		graphics_carry_ = colour & 4;
 		target += 14;
 	}
 }
@@ -261,29 +328,11 @@ void VideoBase::output_fat_low_resolution(uint8_t *target, const uint8_t *const
 void VideoBase::output_double_low_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length, int column, int row) const {
 	const int row_shift = row&4;
 	for(size_t c = 0; c < length; ++c) {
-		if((column + static_cast<int>(c))&1) {
-			target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 2;
-			target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 4;
-			target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 8;
-			target[3] = (auxiliary_source[c] >> row_shift) & 1;
-
-			target[8] = target[12] = (source[c] >> row_shift) & 4;
-			target[9] = target[13] = (source[c] >> row_shift) & 8;
-			target[10] = (source[c] >> row_shift) & 1;
-			target[7] = target[11] = (source[c] >> row_shift) & 2;
-			graphics_carry_ = (source[c] >> row_shift) & 8;
-		} else {
-			target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 8;
-			target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 1;
-			target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 2;
-			target[3] = (auxiliary_source[c] >> row_shift) & 4;
-
-			target[8] = target[12] = (source[c] >> row_shift) & 1;
-			target[9] = target[13] = (source[c] >> row_shift) & 2;
-			target[10] = (source[c] >> row_shift) & 4;
-			target[7] = target[11] = (source[c] >> row_shift) & 8;
-			graphics_carry_ = (source[c] >> row_shift) & 2;
-		}
+		const int parity = (column + static_cast<int>(c))&1;
+		const int colour = (source[c] >> row_shift) & 15;
+		memcpy(&target[0], expansion_tables.double_low_resolution[parity][(auxiliary_source[c] >> row_shift) & 15], 7);
+		memcpy(&target[7], expansion_tables.low_resolution[parity][colour] + 7, 7);
+		graphics_carry_ = colour & (parity ? 8 : 2);
 		target += 14;
 	}
 }
@@ -294,24 +343,9 @@ void VideoBase::output_high_resolution(uint8_t *target, const uint8_t *const sou
 		// If there is a delay, the previous output level is held to bridge the gap.
 		// Delays may be ignored on a IIe if Annunciator 3 is set; that's the state that
 		// high_resolution_mask_ models.
-		if(source[c] & high_resolution_mask_ & 0x80) {
-			target[0] = graphics_carry_;
-			target[1] = target[2] = source[c] & 0x01;
-			target[3] = target[4] = source[c] & 0x02;
-			target[5] = target[6] = source[c] & 0x04;
-			target[7] = target[8] = source[c] & 0x08;
-			target[9] = target[10] = source[c] & 0x10;
-			target[11] = target[12] = source[c] & 0x20;
-			target[13] = source[c] & 0x40;
-		} else {
-			target[0] = target[1] = source[c] & 0x01;
-			target[2] = target[3] = source[c] & 0x02;
-			target[4] = target[5] = source[c] & 0x04;
-			target[6] = target[7] = source[c] & 0x08;
-			target[8] = target[9] = source[c] & 0x10;
-			target[10] = target[11] = source[c] & 0x20;
-			target[12] = target[13] = source[c] & 0x40;
-		}
+		const uint8_t delayed = source[c] & high_resolution_mask_ & 0x80;
+		memcpy(target, expansion_tables.high_resolution[(source[c] & 0x7f) | delayed], 14);
+		if(delayed) target[0] = graphics_carry_;
 		graphics_carry_ = source[c] & 0x40;
 		target += 14;
 	}
@@ -319,20 +353,8 @@ void VideoBase::output_high_resolution(uint8_t *target, const uint8_t *const sou
 
 void VideoBase::output_double_high_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length) const {
 	for(size_t c = 0; c < length; ++c) {
-		target[0] = auxiliary_source[c] & 0x01;
-		target[1] = auxiliary_source[c] & 0x02;
-		target[2] = auxiliary_source[c] & 0x04;
-		target[3] = auxiliary_source[c] & 0x08;
-		target[4] = auxiliary_source[c] & 0x10;
-		target[5] = auxiliary_source[c] & 0x20;
-		target[6] = auxiliary_source[c] & 0x40;
-		target[7] = source[c] & 0x01;
-		target[8] = source[c] & 0x02;
-		target[9] = source[c] & 0x04;
-		target[10] = source[c] & 0x08;
-		target[11] = source[c] & 0x10;
-		target[12] = source[c] & 0x20;
-		target[13] = source[c] & 0x40;
+		memcpy(&target[0], expansion_tables.double_high_resolution[auxiliary_source[c] & 0x7f], 7);
+		memcpy(&target[7], expansion_tables.double_high_resolution[source[c] & 0x7f], 7);
 
 		graphics_carry_ = auxiliary_source[c] & 0x40;
 		target += 14;
@@ -369,8 +369,9 @@ template <class BusHandler, bool is_iie> class Video: public VideoBase {
 					const GraphicsMode line_mode = graphics_mode(row_);
 
 					// Determine whether there's any fetching to do. Fetching occurs during the first
-					// 40 columns of rows prior to 192.
-					if(row_ < 192 && column_ < 40) {
+					// 40 columns of rows prior to 192, and has no side effects, so is skipped if
+					// output is disabled.
+					if(row_ < 192 && column_ < 40 && !crt_.is_output_disabled()) {
 						const int character_row = row_ >> 3;
 						const uint16_t row_address = static_cast<uint16_t>((character_row >> 3) * 40 + ((character_row&7) << 7));
 
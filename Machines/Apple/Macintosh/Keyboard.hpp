@@ -132,8 +132,28 @@ class Keyboard {
 			return !!(response_ & 0x80);
 		}
 
+		/*!
+			@returns A lower bound on the number of ticks until this keyboard might next change its outputs,
+				or @c HalfCycles(-1) if it won't do so without further input. A key event that arrives
+				during an inquiry is picked up at the end of the current @c run_for.
+		*/
+		HalfCycles get_next_sequence_point() const {
+			switch(mode_) {
+				default:
+				case Mode::Waiting:					return HalfCycles(-1);
+				case Mode::AwaitingEndOfCommand:	return HalfCycles(1000 - phase_);
+
+				// An inquiry that has already found no key transition to report will next time out.
+				case Mode::PerformingCommand:		return HalfCycles((command_ == 0x10 && phase_) ? 25000 - phase_ : 0);
+
+				case Mode::AcceptingCommand:
+				case Mode::SendingResponse:			return HalfCycles(0);
+			}
+		}
+
 		/*!
 			The keyboard expects ~10 µs-frequency ticks, i.e. a clock rate of just around 100 kHz.
+			Timeouts honour multiple ticks per call; while shifting, each call is a single tick.
 		*/
 		void run_for(HalfCycles cycle) {
 			switch(mode_) {
@@ -165,8 +185,8 @@ class Keyboard {
 				case Mode::AwaitingEndOfCommand:
 					// Time out if the end-of-command seems not to be forthcoming.
 					// This is an elaboration on my part; a guess.
-					++phase_;
-					if(phase_ == 1000) {
+					phase_ += int(cycle.as_integral());
+					if(phase_ >= 1000) {
 						clock_output_ = false;
 						mode_ = Mode::Waiting;
 						phase_ = 0;
@@ -177,8 +197,8 @@ class Keyboard {
 					response_ = perform_command(command_);
 
 					// Inquiry has a 0.25-second timeout; everything else is instant.
-					++phase_;
-					if(phase_ == 25000 || command_ != 0x10 || response_ != 0x7b) {
+					phase_ += int(cycle.as_integral());
+					if(phase_ >= 25000 || command_ != 0x10 || response_ != 0x7b) {
 						mode_ = Mode::SendingResponse;
 						phase_ = 0;
 					}
@@ -8,6 +8,7 @@
 
 #include "Macintosh.hpp"
 
+#include <algorithm>
 #include <array>
 
 #include "DeferredAudio.hpp"
@@ -58,7 +59,7 @@ namespace Macintosh {
 
 std::vector<std::unique_ptr<Configurable::Option>> get_options() {
 	return Configurable::standard_options(
-		static_cast<Configurable::StandardOptions>(Configurable::QuickBoot)
+		static_cast<Configurable::StandardOptions>(Configurable::QuickBoot | Configurable::QuickProcessor)
 	);
 }
 
@@ -219,6 +220,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				return delay;
 
 				case BusDevice::VIA: {
+					did_perform_io_ = true;
 					if(*cycle.address & 1) {
 						fill_unmapped(cycle);
 					} else {
@@ -237,6 +239,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				} return delay;
 
 				case BusDevice::PhaseRead: {
+					did_perform_io_ = true;
 					if(cycle.operation & Microcycle::Read) {
 						cycle.value->halves.low = phase_ & 7;
 					}
@@ -245,6 +248,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				} return delay;
 
 				case BusDevice::IWM: {
+					did_perform_io_ = true;
 					if(*cycle.address & 1) {
 						const int register_address = word_address >> 8;
 
@@ -262,6 +266,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				} return delay;
 
 				case BusDevice::SCSI: {
+					did_perform_io_ = true;
 					const int register_address = word_address >> 3;
 					const bool dma_acknowledge = word_address & 0x100;
 
@@ -292,6 +297,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				} return delay;
 
 				case BusDevice::SCCReadResetPhase: {
+					did_perform_io_ = true;
 					// Any word access here adjusts phase.
 					if(cycle.operation & Microcycle::SelectWord) {
 						adjust_phase();
@@ -313,6 +319,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				} return delay;
 
 				case BusDevice::SCCWrite: {
+					did_perform_io_ = true;
 					// Any word access here adjusts phase.
 					if(cycle.operation & Microcycle::SelectWord) {
 						adjust_phase();
@@ -384,6 +391,44 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			return delay;
 		}
 
+		HalfCycles skip_idle_loop(HalfCycles iteration_length, HalfCycles available) {
+			// A loop that touches IO might see any of the peripherals change at any time; a loop that touches
+			// only memory can't see anything change until the next interrupt. So, while the mouse and SCSI bus
+			// are inactive, such loops may be skipped up until just before the next video event, real-time clock
+			// tick, VIA timer expiry or keyboard output change.
+			//
+			// RAM contention isn't reapplied across the skipped period, so the next interrupt may be taken
+			// at a slightly different point within the loop than otherwise; total elapsed time is exact.
+			if(did_perform_io_) {
+				did_perform_io_ = false;
+				return HalfCycles(0);
+			}
+			if(mouse_.has_steps() || scsi_bus_is_clocked_) return HalfCycles(0);
+
+			auto limit = std::min({
+				available.as_integral(),
+				(time_until_video_event_ - time_since_video_update_).as_integral(),
+				(HalfCycles(CLOCK_RATE * 2) - real_time_clock_).as_integral()
+			});
+
+			const auto via_sequence_point = via_.get_next_sequence_point();
+			if(via_sequence_point >= Cycles(0)) {
+				limit = std::min(limit, via_sequence_point.as_integral() * 10 - via_clock_.as_integral());
+			}
+
+			const auto keyboard_sequence_point = keyboard_.get_next_sequence_point();
+			if(keyboard_sequence_point >= HalfCycles(0)) {
+				limit = std::min(limit, keyboard_sequence_point.as_integral() * (CLOCK_RATE / 100000) - keyboard_clock_.as_integral());
+			}
+			if(limit <= 1) return HalfCycles(0);
+
+			const HalfCycles skipped = HalfCycles(((limit - 1) / iteration_length.as_integral()) * iteration_length.as_integral());
+			if(skipped > HalfCycles(0)) {
+				advance_time(skipped);
+			}
+			return skipped;
+		}
+
 		void flush() {
 			// Flush the video before the audio queue; in a Mac the
 			// video is responsible for providing part of the
@@ -534,17 +579,24 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 					ram_[0x02b0 >> 1] = 0x00;
 				}
 			}
+
+			bool quick_processor;
+			if(Configurable::get_quick_processor(selections_by_option, quick_processor)) {
+				mc68000_.set_idle_loop_detection_enabled(quick_processor);
+			}
 		}
 
 		Configurable::SelectionSet get_accurate_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_boot_selection(selection_set, false);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
 		Configurable::SelectionSet get_user_friendly_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_boot_selection(selection_set, true);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
@@ -800,6 +852,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 		bool ROM_is_overlay_ = true;
 		int phase_ = 1;
 		int ram_subcycle_ = 0;
+		bool did_perform_io_ = false;
 
 		DoubleDensityDrive drives_[2];
 		Inputs::QuadratureMouse mouse_;
@@ -9,9 +9,28 @@
 #include "Video.hpp"
 
 #include <algorithm>
+#include <cstring>
 
 using namespace Apple::Macintosh;
 
+namespace {
+
+/// Maps each byte of video data to the eight Luminance1 samples it produces, MSB first,
+/// so that a fetched word can be output with two copies rather than a pixel at a time.
+struct PixelTable {
+	uint8_t map[256][8];
+
+	PixelTable() {
+		for(int c = 0; c < 256; ++c) {
+			for(int bit = 0; bit < 8; ++bit) {
+				map[c][bit] = uint8_t(c & (0x80 >> bit));
+			}
+		}
+	}
+} pixel_table;
+
+}
+
 // Re: CRT timings, see the Apple Guide to the Macintosh Hardware Family,
 // bottom of page 400:
 //
@@ -77,30 +96,17 @@ void Video::run_for(HalfCycles duration) {
 
 					if(pixel_buffer_) {
 						for(int c = first_word; c < final_pixel_word; ++c) {
-							uint16_t pixels = ram_[video_base + video_address_] ^ 0xffff;
+							const uint16_t pixels = ram_[video_base + video_address_] ^ 0xffff;
 							++video_address_;
 
-							pixel_buffer_[15] = pixels & 0x01;
-							pixel_buffer_[14] = pixels & 0x02;
-							pixel_buffer_[13] = pixels & 0x04;
-							pixel_buffer_[12] = pixels & 0x08;
-							pixel_buffer_[11] = pixels & 0x10;
-							pixel_buffer_[10] = pixels & 0x20;
-							pixel_buffer_[9] = pixels & 0x40;
-							pixel_buffer_[8] = pixels & 0x80;
-
-							pixels >>= 8;
-							pixel_buffer_[7] = pixels & 0x01;
-							pixel_buffer_[6] = pixels & 0x02;
-							pixel_buffer_[5] = pixels & 0x04;
-							pixel_buffer_[4] = pixels & 0x08;
-							pixel_buffer_[3] = pixels & 0x10;
-							pixel_buffer_[2] = pixels & 0x20;
-							pixel_buffer_[1] = pixels & 0x40;
-							pixel_buffer_[0] = pixels & 0x80;
+							memcpy(&pixel_buffer_[0], pixel_table.map[pixels >> 8], 8);
+							memcpy(&pixel_buffer_[8], pixel_table.map[pixels & 0xff], 8);
 
 							pixel_buffer_ += 16;
 						}
+					} else {
+						// Keep the fetch address in step even if there's nowhere to put pixels.
+						video_address_ += size_t(final_pixel_word - first_word);
 					}
 
 					if(final_pixel_word == 32) {
@@ -39,12 +39,14 @@
 #include "../../Utility/MemoryPacker.hpp"
 #include "../../Utility/MemoryFuzzer.hpp"
 
+#include <algorithm>
+
 namespace Atari {
 namespace ST {
 
 std::vector<std::unique_ptr<Configurable::Option>> get_options() {
 	return Configurable::standard_options(
-		static_cast<Configurable::StandardOptions>(Configurable::DisplayRGB | Configurable::DisplayCompositeColour | Configurable::QuickLoadTape)
+		static_cast<Configurable::StandardOptions>(Configurable::DisplayRGB | Configurable::DisplayCompositeColour | Configurable::QuickLoadTape | Configurable::QuickProcessor)
 	);
 }
 
@@ -264,6 +266,7 @@ class ConcreteMachine:
 				return delay;
 
 				case BusDevice::IO:
+					did_perform_io_ = true;
 					switch(address & 0xfffe) {	// TODO: surely it's going to be even less precise than this?
 						default:
 //							assert(false);
@@ -420,6 +423,32 @@ class ConcreteMachine:
 			return HalfCycles(0);
 		}
 
+		HalfCycles skip_idle_loop(HalfCycles iteration_length, HalfCycles available) {
+			// A loop that touches IO might see any of the peripherals change at any time; a loop that touches
+			// only memory can't see anything change until the next interrupt. So, while the keyboard and
+			// disk aren't busy, such loops may be skipped up until just before the next video event or
+			// MFP timer expiry.
+			if(did_perform_io_) {
+				did_perform_io_ = false;
+				return HalfCycles(0);
+			}
+			if(keyboard_needs_clock_ || !may_defer_acias_ || dma_is_realtime_) return HalfCycles(0);
+
+			auto limit = std::min(available, cycles_until_video_event_).as_integral();
+			const auto mfp_sequence_point = mfp_->get_next_sequence_point();
+			if(mfp_sequence_point >= HalfCycles(0)) {
+				// Convert from MFP time to CPU time, allowing for any fractional part held by mfp_.
+				limit = std::min(limit, (mfp_sequence_point.as_integral() - 1) * 2673749 / 819200);
+			}
+			if(limit <= 1) return HalfCycles(0);
+
+			const HalfCycles skipped = HalfCycles(((limit - 1) / iteration_length.as_integral()) * iteration_length.as_integral());
+			if(skipped > HalfCycles(0)) {
+				advance_time(skipped);
+			}
+			return skipped;
+		}
+
 		void flush() {
 			dma_.flush();
 			mfp_.flush();
@@ -479,6 +508,7 @@ class ConcreteMachine:
 
 		CPU::MC68000::Processor<ConcreteMachine, true> mc68000_;
 		HalfCycles bus_phase_;
+		bool did_perform_io_ = false;
 
 		JustInTimeActor<Video> video_;
 		HalfCycles cycles_until_video_event_;
@@ -678,17 +708,24 @@ class ConcreteMachine:
 			if(Configurable::get_display(selections_by_option, display)) {
 				set_video_signal_configurable(display);
 			}
+
+			bool quick_processor;
+			if(Configurable::get_quick_processor(selections_by_option, quick_processor)) {
+				mc68000_.set_idle_loop_detection_enabled(quick_processor);
+			}
 		}
 
 		Configurable::SelectionSet get_accurate_selections() final {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_display_selection(selection_set, Configurable::Display::CompositeColour);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
 		Configurable::SelectionSet get_user_friendly_selections() final {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_display_selection(selection_set, Configurable::Display::RGB);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 };
@@ -621,6 +621,24 @@ namespace {
 #else
 	constexpr int upper = 1;
 #endif
+
+/*!
+	Maps a byte of a single bitplane to eight bytes, in memory order, each of which is 1 if the
+	corresponding pixel is set and 0 otherwise. So OR-ing together the shifted results for several
+	bitplanes produces the palette indices for eight pixels at once.
+*/
+struct PlaneTable {
+	uint64_t map[256];
+
+	PlaneTable() {
+		for(int c = 0; c < 256; ++c) {
+			uint8_t *const pixels = reinterpret_cast<uint8_t *>(&map[c]);
+			for(int bit = 0; bit < 8; ++bit) {
+				pixels[bit] = uint8_t((c >> (7 - bit)) & 1);
+			}
+		}
+	}
+} plane_table;
 }
 
 void Video::VideoStream::shift(int duration) {
@@ -629,6 +647,11 @@ void Video::VideoStream::shift(int duration) {
 			output_shifter_ <<= (duration << 1);
 		break;
 		case OutputBpp::Two:
+			while(duration >= 8) {
+				shifter_halves_[upper] = ((shifter_halves_[upper] << 8) & 0xff00ff00) | ((shifter_halves_[upper^1] & 0xff00ff00) >> 8);
+				shifter_halves_[upper^1] = (shifter_halves_[upper^1] << 8) & 0xff00ff00;
+				duration -= 8;
+			}
 			while(duration--) {
 				shifter_halves_[upper] = (shifter_halves_[upper] << 1) & 0xfffefffe;
 				shifter_halves_[upper] |= (shifter_halves_[upper^1] & 0x80008000) >> 15;
@@ -636,6 +659,10 @@ void Video::VideoStream::shift(int duration) {
 			}
 		break;
 		case OutputBpp::Four:
+			while(duration >= 16) {
+				output_shifter_ = (output_shifter_ << 8) & 0xff00ff00ff00ff00;
+				duration -= 16;
+			}
 			while(duration) {
 				output_shifter_ = (output_shifter_ << 1) & 0xfffefffefffefffe;
 				duration -= 2;
@@ -656,7 +683,8 @@ void Video::VideoStream::output_pixels(int duration) {
 		case OutputBpp::Four: pixels >>= 1;	break;
 	}
 
-	while(pixels) {
+	// If output is disabled, skip straight to the shifting below.
+	while(pixels && !crt_.is_output_disabled()) {
 		// If no buffer is currently available, attempt to allocate one.
 		if(!pixel_buffer_) {
 			pixel_buffer_ = reinterpret_cast<uint16_t *>(crt_.begin_data(allocation_size, 2));
@@ -668,8 +696,21 @@ void Video::VideoStream::output_pixels(int duration) {
 		int pixels_to_draw = std::min(allocation_size - pixel_pointer_, pixels);
 		pixels -= pixels_to_draw;
 
+		// Whole groups of eight pixels are converted by table lookup, the bitplanes then
+		// being shifted in a single step; anything left over is serialised one pixel at a time.
 		switch(bpp_) {
 			case OutputBpp::One:
+				while(pixels_to_draw >= 8) {
+					const uint64_t pixels = plane_table.map[output_shifter_ >> 56];
+					const uint8_t *const pixel = reinterpret_cast<const uint8_t *>(&pixels);
+					for(int c = 0; c < 8; ++c) {
+						pixel_buffer_[pixel_pointer_ + c] = pixel[c] * 0xffff;
+					}
+					output_shifter_ <<= 8;
+
+					pixel_pointer_ += 8;
+					pixels_to_draw -= 8;
+				}
 				while(pixels_to_draw--) {
 					pixel_buffer_[pixel_pointer_] = ((output_shifter_ >> 63) & 1) * 0xffff;
 					output_shifter_ <<= 1;
@@ -679,6 +720,20 @@ void Video::VideoStream::output_pixels(int duration) {
 			break;
 
 			case OutputBpp::Two:
+				while(pixels_to_draw >= 8) {
+					const uint64_t indices =
+						plane_table.map[output_shifter_ >> 56] |
+						(plane_table.map[(output_shifter_ >> 40) & 0xff] << 1);
+					const uint8_t *const index = reinterpret_cast<const uint8_t *>(&indices);
+					for(int c = 0; c < 8; ++c) {
+						pixel_buffer_[pixel_pointer_ + c] = palette_[index[c]];
+					}
+					shifter_halves_[upper] = ((shifter_halves_[upper] << 8) & 0xff00ff00) | ((shifter_halves_[upper^1] & 0xff00ff00) >> 8);
+					shifter_halves_[upper^1] = (shifter_halves_[upper^1] << 8) & 0xff00ff00;
+
+					pixel_pointer_ += 8;
+					pixels_to_draw -= 8;
+				}
 				while(pixels_to_draw--) {
 					pixel_buffer_[pixel_pointer_] = palette_[
 						((output_shifter_ >> 63) & 1) |
@@ -696,6 +751,21 @@ void Video::VideoStream::output_pixels(int duration) {
 			break;
 
 			case OutputBpp::Four:
+				while(pixels_to_draw >= 8) {
+					const uint64_t indices =
+						plane_table.map[output_shifter_ >> 56] |
+						(plane_table.map[(output_shifter_ >> 40) & 0xff] << 1) |
+						(plane_table.map[(output_shifter_ >> 24) & 0xff] << 2) |
+						(plane_table.map[(output_shifter_ >> 8) & 0xff] << 3);
+					const uint8_t *const index = reinterpret_cast<const uint8_t *>(&indices);
+					for(int c = 0; c < 8; ++c) {
+						pixel_buffer_[pixel_pointer_ + c] = palette_[index[c]];
+					}
+					output_shifter_ = (output_shifter_ << 8) & 0xff00ff00ff00ff00;
+
+					pixel_pointer_ += 8;
+					pixels_to_draw -= 8;
+				}
 				while(pixels_to_draw--) {
 					pixel_buffer_[pixel_pointer_] = palette_[
 						((output_shifter_ >> 63) & 1) |
@@ -716,8 +786,8 @@ void Video::VideoStream::output_pixels(int duration) {
 		}
 	}
 
-	// If duration remains, that implies no buffer was available, so
-	// just do the corresponding shifting and provide proper timing to the CRT.
+	// If duration remains, that implies no buffer was available or output is disabled,
+	// so just do the corresponding shifting and provide proper timing to the CRT.
 	if(pixels) {
 		int leftover_duration = pixels;
 		switch(bpp_) {
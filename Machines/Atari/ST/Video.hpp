@@ -225,6 +225,8 @@ class Video {
 				// Internal state for handling output serialisation.
 				uint16_t *pixel_buffer_ = nullptr;
 				int pixel_pointer_ = 0;
+
+				friend class ::VideoTester;
 		} video_stream_;
 
 		/// Contains copies of the various observeable fields, after the relevant propagation delay.
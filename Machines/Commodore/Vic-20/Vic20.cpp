@@ -51,7 +51,7 @@ enum ROMSlot {
 
 std::vector<std::unique_ptr<Configurable::Option>> get_options() {
 	return Configurable::standard_options(
-		static_cast<Configurable::StandardOptions>(Configurable::DisplaySVideo | Configurable::DisplayCompositeColour | Configurable::QuickLoadTape)
+		static_cast<Configurable::StandardOptions>(Configurable::DisplaySVideo | Configurable::DisplayCompositeColour | Configurable::QuickLoadTape | Configurable::QuickProcessor)
 	);
 }
 
@@ -501,6 +501,7 @@ class ConcreteMachine:
 			if(isReadOperation(operation)) {
 				uint8_t result = processor_read_memory_map_[address >> 10] ? processor_read_memory_map_[address >> 10][address & 0x3ff] : 0xff;
 				if((address&0xfc00) == 0x9000) {
+					did_perform_io_ = true;
 					if(!(address&0x100)) {
 						update_video();
 						result &= mos6560_.read(address);
@@ -587,6 +588,7 @@ class ConcreteMachine:
 				}
 				// Anything between 0x9000 and 0x9400 is the IO area.
 				if((address&0xfc00) == 0x9000) {
+					did_perform_io_ = true;
 					// The VIC is selected by bit 8 = 0
 					if(!(address&0x100)) {
 						update_video();
@@ -605,6 +607,7 @@ class ConcreteMachine:
 				if(!typer_->type_next_character()) {
 					clear_all_keys();
 					typer_.reset();
+					update_processor_memory_map();
 				}
 			}
 			if(!tape_is_sleeping_ && !hold_tape_) tape_->run_for(Cycles(1));
@@ -613,6 +616,42 @@ class ConcreteMachine:
 			return Cycles(1);
 		}
 
+		/*!
+			Performs time that the 6502 has spent on accesses to the direct memory map, if enabled. Writes
+			to RAM made in that time will be visible to the 6560 up to an instruction early.
+		*/
+		forceinline void perform_direct_cycles(Cycles cycles) {
+			cycles_since_mos6560_update_ += cycles;
+			user_port_via_.run_for(cycles);
+			keyboard_via_.run_for(cycles);
+			if(!tape_is_sleeping_ && !hold_tape_) tape_->run_for(cycles);
+			if(c1540_) c1540_->run_for(cycles);
+		}
+
+		Cycles skip_idle_loop(Cycles iteration_length, Cycles available) {
+			// A loop that touches IO might see the keyboard, joysticks or serial bus change at any time; a loop
+			// that touches only memory can't see anything change until the next interrupt. So, while the tape
+			// isn't playing and nothing is being typed, such loops may be skipped up until just before either
+			// VIA's timers next allow an interrupt.
+			if(did_perform_io_) {
+				did_perform_io_ = false;
+				return Cycles(0);
+			}
+			if(typer_ || !tape_is_sleeping_) return Cycles(0);
+
+			auto limit = available.as_integral();
+			for(const auto &next_interrupt: {user_port_via_.get_next_sequence_point(), keyboard_via_.get_next_sequence_point()}) {
+				if(next_interrupt >= Cycles(0)) limit = std::min(limit, next_interrupt.as_integral());
+			}
+			if(limit <= 1) return Cycles(0);
+
+			const Cycles skipped = Cycles(((limit - 1) / iteration_length.as_integral()) * iteration_length.as_integral());
+			if(skipped > Cycles(0)) {
+				perform_direct_cycles(skipped);
+			}
+			return skipped;
+		}
+
 		void flush() {
 			update_video();
 			mos6560_.flush();
@@ -641,6 +680,7 @@ class ConcreteMachine:
 
 		void type_string(const std::string &string) override final {
 			Utility::TypeRecipient::add_typer(string, std::make_unique<CharacterMapper>());
+			update_processor_memory_map();
 		}
 
 		void tape_did_change_input(Storage::Tape::BinaryTapePlayer *tape) override final {
@@ -667,12 +707,20 @@ class ConcreteMachine:
 			if(Configurable::get_display(selections_by_option, display)) {
 				set_video_signal_configurable(display);
 			}
+
+			bool quick_processor;
+			if(Configurable::get_quick_processor(selections_by_option, quick_processor)) {
+				use_quick_processor_ = quick_processor;
+				update_processor_memory_map();
+				m6502_.set_idle_loop_detection_enabled(quick_processor);
+			}
 		}
 
 		Configurable::SelectionSet get_accurate_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_load_tape_selection(selection_set, false);
 			Configurable::append_display_selection(selection_set, Configurable::Display::CompositeColour);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
@@ -680,6 +728,7 @@ class ConcreteMachine:
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_load_tape_selection(selection_set, true);
 			Configurable::append_display_selection(selection_set, Configurable::Display::SVideo);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
@@ -697,7 +746,7 @@ class ConcreteMachine:
 		void update_video() {
 			mos6560_.run_for(cycles_since_mos6560_update_.flush<Cycles>());
 		}
-		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, ConcreteMachine, false> m6502_;
+		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, ConcreteMachine, false, true> m6502_;
 
 		std::vector<uint8_t>  character_rom_;
 		std::vector<uint8_t>  basic_rom_;
@@ -720,6 +769,26 @@ class ConcreteMachine:
 			}
 		}
 
+		// The memory map offered to the 6502 for whole-instruction execution, if enabled; it omits
+		// any page that contains an address trapped in perform_bus_operation.
+		bool use_quick_processor_ = false;
+		bool did_perform_io_ = false;
+		uint8_t *direct_read_memory_map_[64];
+		void update_processor_memory_map() {
+			if(!use_quick_processor_) {
+				m6502_.set_memory_map(nullptr, nullptr, 10);
+				return;
+			}
+
+			memcpy(direct_read_memory_map_, processor_read_memory_map_, sizeof(direct_read_memory_map_));
+			if(typer_) direct_read_memory_map_[0xeb1e >> 10] = nullptr;
+			if(use_fast_tape_hack_) {
+				direct_read_memory_map_[0xf7b2 >> 10] = nullptr;
+				direct_read_memory_map_[0xf90b >> 10] = nullptr;
+			}
+			m6502_.set_memory_map(direct_read_memory_map_, processor_write_memory_map_, 10);
+		}
+
 		Commodore::Vic20::KeyboardMapper keyboard_mapper_;
 		std::vector<std::unique_ptr<Inputs::Joystick>> joysticks_;
 
@@ -742,6 +811,7 @@ class ConcreteMachine:
 		bool tape_is_sleeping_ = true;
 		void set_use_fast_tape() {
 			use_fast_tape_hack_ = !tape_is_sleeping_ && allow_fast_tape_hack_ && tape_->has_tape();
+			update_processor_memory_map();
 		}
 
 		// Disk
@@ -34,7 +34,7 @@ namespace Electron {
 
 std::vector<std::unique_ptr<Configurable::Option>> get_options() {
 	return Configurable::standard_options(
-		static_cast<Configurable::StandardOptions>(Configurable::DisplayRGB | Configurable::DisplayCompositeColour | Configurable::QuickLoadTape)
+		static_cast<Configurable::StandardOptions>(Configurable::DisplayRGB | Configurable::DisplayCompositeColour | Configurable::QuickLoadTape | Configurable::QuickType | Configurable::QuickProcessor)
 	);
 }
 
@@ -168,6 +168,7 @@ class ConcreteMachine:
 				// it's also accessible only outside of the pixel regions
 				cycles += video_output_.get_cycles_until_next_ram_availability(int(cycles_since_display_update_.as_integral()) + 1);
 			} else {
+				if(address >= 0xfc00 && address < 0xff00) did_perform_io_ = true;
 				switch(address & 0xff0f) {
 					case 0xfe00:
 						if(isReadOperation(operation)) {
@@ -295,6 +296,7 @@ class ConcreteMachine:
 																						// allow the PC read to return an RTS.
 									)
 								) {
+									did_perform_io_ = true;
 									uint8_t service_call = static_cast<uint8_t>(m6502_.get_value_of_register(CPU::MOS6502::Register::X));
 									if(address == 0xf0a8) {
 										if(!ram_[0x247] && service_call == 14) {
@@ -330,10 +332,19 @@ class ConcreteMachine:
 							if(isReadOperation(operation)) {
 								*value = roms_[active_rom_][address & 16383];
 								if(keyboard_is_active_) {
+									did_perform_io_ = true;
 									*value &= 0xf0;
+									int selected_line = 0, selected_lines = 0;
 									for(int address_line = 0; address_line < 14; address_line++) {
-										if(!(address&(1 << address_line))) *value |= key_states_[address_line];
+										if(!(address&(1 << address_line))) {
+											*value |= key_states_[address_line];
+											selected_line = address_line;
+											++selected_lines;
+										}
 									}
+
+									// Reads of individual lines are taken to be part of a keyboard scan.
+									if(typer_ && selected_lines == 1) typer_->did_read_keyboard_line(selected_line);
 								}
 								if(basic_is_active_) {
 									*value &= roms_[static_cast<int>(ROM::BASIC)][address & 16383];
@@ -346,31 +357,32 @@ class ConcreteMachine:
 				}
 			}
 
-			cycles_since_display_update_ += Cycles(static_cast<int>(cycles));
-			cycles_since_audio_update_ += Cycles(static_cast<int>(cycles));
-			if(cycles_since_audio_update_ > Cycles(16384)) update_audio();
-			tape_.run_for(Cycles(static_cast<int>(cycles)));
+			advance_time(cycles);
+			return Cycles(static_cast<int>(cycles));
+		}
 
-			cycles_until_display_interrupt_ -= cycles;
-			if(cycles_until_display_interrupt_ < 0) {
-				signal_interrupt(next_display_interrupt_);
-				update_display();
-				queue_next_display_interrupt();
+		Cycles skip_idle_loop(Cycles iteration_length, Cycles available) {
+			// A loop that touches IO or the keyboard might see something change at any time; a loop that
+			// touches only memory can't see anything change until the next interrupt. So, while the tape
+			// isn't clocking and nothing is being typed, such loops may be skipped up until just before the
+			// next display interrupt.
+			//
+			// RAM contention isn't reapplied across the skipped period, so the next interrupt may be taken
+			// at a slightly different point within the loop than otherwise; total elapsed time is exact.
+			if(did_perform_io_) {
+				did_perform_io_ = false;
+				return Cycles(0);
 			}
+			if(typer_ || shift_restart_counter_ || tape_.is_clocking()) return Cycles(0);
 
-			if(typer_) typer_->run_for(Cycles(static_cast<int>(cycles)));
-			if(plus3_) plus3_->run_for(Cycles(4*static_cast<int>(cycles)));
-			if(shift_restart_counter_) {
-				shift_restart_counter_ -= cycles;
-				if(shift_restart_counter_ <= 0) {
-					shift_restart_counter_ = 0;
-					m6502_.set_power_on(true);
-					set_key_state(KeyShift, true);
-					is_holding_shift_ = true;
-				}
-			}
+			const auto limit = std::min(available.as_integral(), Cycles::IntType(cycles_until_display_interrupt_));
+			if(limit <= 1) return Cycles(0);
 
-			return Cycles(static_cast<int>(cycles));
+			const Cycles skipped = Cycles(((limit - 1) / iteration_length.as_integral()) * iteration_length.as_integral());
+			if(skipped > Cycles(0)) {
+				advance_time(static_cast<unsigned int>(skipped.as_integral()));
+			}
+			return skipped;
 		}
 
 		forceinline void flush() {
@@ -408,6 +420,10 @@ class ConcreteMachine:
 			return Cycles(625*128*2);	// accept a new character every two frames
 		}
 
+		int get_typer_keyboard_lines() override final {
+			return use_quick_typing_ ? 14 : 0;
+		}
+
 		void type_string(const std::string &string) override final {
 			Utility::TypeRecipient::add_typer(string, std::make_unique<CharacterMapper>());
 		}
@@ -432,12 +448,24 @@ class ConcreteMachine:
 			if(Configurable::get_display(selections_by_option, display)) {
 				set_video_signal_configurable(display);
 			}
+
+			bool quick_type;
+			if(Configurable::get_quick_type(selections_by_option, quick_type)) {
+				use_quick_typing_ = quick_type;
+			}
+
+			bool quick_processor;
+			if(Configurable::get_quick_processor(selections_by_option, quick_processor)) {
+				m6502_.set_idle_loop_detection_enabled(quick_processor);
+			}
 		}
 
 		Configurable::SelectionSet get_accurate_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_load_tape_selection(selection_set, false);
 			Configurable::append_display_selection(selection_set, Configurable::Display::CompositeColour);
+			Configurable::append_quick_type_selection(selection_set, false);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
@@ -445,6 +473,8 @@ class ConcreteMachine:
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_load_tape_selection(selection_set, true);
 			Configurable::append_display_selection(selection_set, Configurable::Display::RGB);
+			Configurable::append_quick_type_selection(selection_set, false);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
@@ -506,6 +536,33 @@ class ConcreteMachine:
 				rom_inserted_[static_cast<int>(slot)] = true;
 		}
 
+		// MARK: - Time advancement.
+		forceinline void advance_time(unsigned int cycles) {
+			cycles_since_display_update_ += Cycles(static_cast<int>(cycles));
+			cycles_since_audio_update_ += Cycles(static_cast<int>(cycles));
+			if(cycles_since_audio_update_ > Cycles(16384)) update_audio();
+			tape_.run_for(Cycles(static_cast<int>(cycles)));
+
+			cycles_until_display_interrupt_ -= cycles;
+			if(cycles_until_display_interrupt_ < 0) {
+				signal_interrupt(next_display_interrupt_);
+				update_display();
+				queue_next_display_interrupt();
+			}
+
+			if(typer_) typer_->run_for(Cycles(static_cast<int>(cycles)));
+			if(plus3_) plus3_->run_for(Cycles(4*static_cast<int>(cycles)));
+			if(shift_restart_counter_) {
+				shift_restart_counter_ -= cycles;
+				if(shift_restart_counter_ <= 0) {
+					shift_restart_counter_ = 0;
+					m6502_.set_power_on(true);
+					set_key_state(KeyShift, true);
+					is_holding_shift_ = true;
+				}
+			}
+		}
+
 		// MARK: - Work deferral updates.
 		inline void update_display() {
 			if(cycles_since_display_update_ > 0) {
@@ -555,11 +612,13 @@ class ConcreteMachine:
 		int active_rom_ = static_cast<int>(ROM::Slot0);
 		bool keyboard_is_active_ = false;
 		bool basic_is_active_ = false;
+		bool did_perform_io_ = false;
 
 		// Interrupt and keyboard state
 		uint8_t interrupt_status_ = Interrupt::PowerOnReset | Interrupt::TransmitDataEmpty | 0x80;
 		uint8_t interrupt_control_ = 0;
 		uint8_t key_states_[14];
+		bool use_quick_typing_ = false;
 		Electron::KeyboardMapper keyboard_mapper_;
 
 		// Counters related to simultaneous subsystems
@@ -44,6 +44,9 @@ class Tape:
 		inline void set_is_enabled(bool is_enabled) { is_enabled_ = is_enabled; }
 		void set_is_in_input_mode(bool is_in_input_mode);
 
+		/// @returns @c true if time passing may change the tape's interrupt status; @c false otherwise.
+		inline bool is_clocking() const { return is_enabled_ && (is_running_ || !is_in_input_mode_); }
+
 		void acorn_shifter_output_bit(int value);
 
 	private:
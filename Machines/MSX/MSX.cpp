@@ -53,7 +53,7 @@ namespace MSX {
 
 std::vector<std::unique_ptr<Configurable::Option>> get_options() {
 	return Configurable::standard_options(
-		static_cast<Configurable::StandardOptions>(Configurable::DisplayRGB | Configurable::DisplaySVideo | Configurable::DisplayCompositeColour | Configurable::QuickLoadTape)
+		static_cast<Configurable::StandardOptions>(Configurable::DisplayRGB | Configurable::DisplaySVideo | Configurable::DisplayCompositeColour | Configurable::QuickLoadTape | Configurable::QuickProcessor)
 	);
 }
 
@@ -333,6 +333,7 @@ class ConcreteMachine:
 						break;
 					}
 				}
+				update_z80_memory_map();
 			}
 
 			if(!media.tapes.empty()) {
@@ -500,6 +501,10 @@ class ConcreteMachine:
 
 						int slot_hit = (paged_memory_ >> ((address >> 14) * 2)) & 3;
 						if(memory_slots_[slot_hit].handler) {
+							// Opcode fetches aren't necessarily seen if the Z80 is using its memory map; the page
+							// that the program counter is now in will almost always be that of the current instruction.
+							if(use_quick_processor_) pc_address_ = z80_.get_value_of_register(CPU::Z80::Register::ProgramCounter);
+
 							update_audio();
 							memory_slots_[slot_hit].handler->run_for(memory_slots_[slot_hit].cycles_since_update.flush<HalfCycles>());
 							memory_slots_[slot_hit].handler->write(address, *cycle.value, read_pointers_[pc_address_ >> 13] != memory_slots_[0].read_pointers[pc_address_ >> 13]);
@@ -654,12 +659,19 @@ class ConcreteMachine:
 			if(Configurable::get_display(selections_by_option, display)) {
 				set_video_signal_configurable(display);
 			}
+
+			bool quick_processor;
+			if(Configurable::get_quick_processor(selections_by_option, quick_processor)) {
+				use_quick_processor_ = quick_processor;
+				update_z80_memory_map();
+			}
 		}
 
 		Configurable::SelectionSet get_accurate_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_load_tape_selection(selection_set, false);
 			Configurable::append_display_selection(selection_set, Configurable::Display::CompositeColour);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
@@ -667,6 +679,7 @@ class ConcreteMachine:
 			Configurable::SelectionSet selection_set;
 			Configurable::append_quick_load_tape_selection(selection_set, true);
 			Configurable::append_display_selection(selection_set, Configurable::Display::RGB);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
@@ -751,7 +764,7 @@ class ConcreteMachine:
 				Activity::Observer *activity_observer_ = nullptr;
 		};
 
-		CPU::Z80::Processor<ConcreteMachine, false, false> z80_;
+		CPU::Z80::Processor<ConcreteMachine, false, false, true> z80_;
 		JustInTimeActor<TI::TMS::TMS9918> vdp_;
 		Intel::i8255::i8255<i8255PortHandler> i8255_;
 
@@ -768,6 +781,7 @@ class ConcreteMachine:
 		bool use_fast_tape_ = false;
 		void set_use_fast_tape() {
 			use_fast_tape_ = !tape_player_is_sleeping_ && allow_fast_tape_ && tape_player_.has_tape() && !(paged_memory_&3);
+			update_z80_memory_map();
 		}
 
 		i8255PortHandler i8255_port_handler_;
@@ -796,6 +810,29 @@ class ConcreteMachine:
 		uint8_t scratch_[8192];
 		uint8_t unpopulated_[8192];
 
+		// The memory map offered to the Z80, if enabled. Reads of unpopulated pages, writes to any slot
+		// that has a handler and, while the fast tape hack is in use, the BIOS page that contains the
+		// tape routines are all left to perform_machine_cycle.
+		bool use_quick_processor_ = false;
+		const uint8_t *z80_read_pointers_[8];
+		uint8_t *z80_write_pointers_[8];
+		void update_z80_memory_map() {
+			if(!use_quick_processor_) {
+				z80_.set_memory_map(nullptr, nullptr, 13);
+				return;
+			}
+
+			for(int c = 0; c < 8; ++c) {
+				const int slot = (paged_memory_ >> ((c >> 1) * 2)) & 3;
+				z80_read_pointers_[c] = (read_pointers_[c] == unpopulated_) ? nullptr : read_pointers_[c];
+				z80_write_pointers_[c] = memory_slots_[slot].handler ? nullptr : write_pointers_[c];
+			}
+			if(use_fast_tape_) z80_read_pointers_[0] = nullptr;
+
+			// Each opcode fetch is extended by one cycle.
+			z80_.set_memory_map(z80_read_pointers_, z80_write_pointers_, 13, nullptr, HalfCycles(2));
+		}
+
 		HalfCycles time_since_ay_update_;
 		HalfCycles time_until_interrupt_;
 
@@ -37,7 +37,7 @@ namespace MasterSystem {
 
 std::vector<std::unique_ptr<Configurable::Option>> get_options() {
 	return Configurable::standard_options(
-		static_cast<Configurable::StandardOptions>(Configurable::DisplayRGB | Configurable::DisplayCompositeColour)
+		static_cast<Configurable::StandardOptions>(Configurable::DisplayRGB | Configurable::DisplayCompositeColour | Configurable::QuickProcessor)
 	);
 }
 
@@ -158,6 +158,13 @@ class ConcreteMachine:
 				map(write_pointers_, ram_, 1024, 0xc000, 0x10000);
 			}
 
+			// Prepare the map that the Z80 may use to perform memory accesses directly; it omits
+			// writes to the page that contains the Sega paging registers.
+			std::copy(std::begin(write_pointers_), std::end(write_pointers_), std::begin(z80_write_pointers_));
+			if(paging_scheme_ == Target::PagingScheme::Sega) {
+				z80_write_pointers_[0xfffd >> 10] = nullptr;
+			}
+
 			// Apple a relatively low low-pass filter. More guidance needed here.
 			speaker_.set_high_frequency_cutoff(8000);
 
@@ -224,6 +231,7 @@ class ConcreteMachine:
 					break;
 
 					case CPU::Z80::PartialMachineCycle::Input:
+						did_perform_input_ = true;
 						switch(address & 0xc1) {
 							case 0x00:
 								LOG("TODO: [input] memory control");
@@ -334,6 +342,28 @@ class ConcreteMachine:
 			return HalfCycles(0);
 		}
 
+		HalfCycles skip_idle_loop(HalfCycles iteration_length, HalfCycles available) {
+			// A loop that reads IO might see the VDP's counters or status, or the inputs, change at
+			// any time; a loop that reads only memory can't see anything change until the next interrupt
+			// or pause-button debounce, so may be skipped up until just before either.
+			if(did_perform_input_) {
+				did_perform_input_ = false;
+				return HalfCycles(0);
+			}
+
+			auto limit = std::min(available.as_integral(), time_until_debounce_.as_integral());
+			if(time_until_interrupt_ > HalfCycles(0)) {
+				limit = std::min(limit, time_until_interrupt_.as_integral());
+			}
+			if(limit <= 1) return HalfCycles(0);
+
+			const HalfCycles skipped = HalfCycles(((limit - 1) / iteration_length.as_integral()) * iteration_length.as_integral());
+			if(skipped > HalfCycles(0)) {
+				perform_machine_cycle(CPU::Z80::PartialMachineCycle(CPU::Z80::PartialMachineCycle::Internal, skipped, nullptr, nullptr, false));
+			}
+			return skipped;
+		}
+
 		void flush() {
 			vdp_.flush();
 			update_audio();
@@ -370,17 +400,25 @@ class ConcreteMachine:
 			if(Configurable::get_display(selections_by_option, display)) {
 				set_video_signal_configurable(display);
 			}
+
+			bool quick_processor;
+			if(Configurable::get_quick_processor(selections_by_option, quick_processor)) {
+				z80_.set_memory_map(quick_processor ? read_pointers_ : nullptr, z80_write_pointers_, 10);
+				z80_.set_idle_loop_detection_enabled(quick_processor);
+			}
 		}
 
 		Configurable::SelectionSet get_accurate_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_display_selection(selection_set, Configurable::Display::CompositeColour);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
 		Configurable::SelectionSet get_user_friendly_selections() override {
 			Configurable::SelectionSet selection_set;
 			Configurable::append_display_selection(selection_set, Configurable::Display::RGB);
+			Configurable::append_quick_processor_selection(selection_set, false);
 			return selection_set;
 		}
 
@@ -413,7 +451,7 @@ class ConcreteMachine:
 		Target::Model model_;
 		Target::Region region_;
 		Target::PagingScheme paging_scheme_;
-		CPU::Z80::Processor<ConcreteMachine, false, false> z80_;
+		CPU::Z80::Processor<ConcreteMachine, false, false, true> z80_;
 		JustInTimeActor<TI::TMS::TMS9918> vdp_;
 
 		Concurrency::DeferringAsyncTaskQueue audio_queue_;
@@ -427,6 +465,7 @@ class ConcreteMachine:
 		HalfCycles time_since_sn76489_update_;
 		HalfCycles time_until_interrupt_;
 		HalfCycles time_until_debounce_;
+		bool did_perform_input_ = false;
 
 		uint8_t ram_[8*1024];
 		uint8_t bios_[8*1024];
@@ -437,6 +476,7 @@ class ConcreteMachine:
 		// The memory map has a 1kb granularity; this is determined by the SG1000's 1kb of RAM.
 		const uint8_t *read_pointers_[64];
 		uint8_t *write_pointers_[64];
+		uint8_t *z80_write_pointers_[64];
 		template <typename T> void map(T **target, uint8_t *source, size_t size, size_t start_address, size_t end_address = 0) {
 			if(!end_address) end_address = start_address + size;
 			for(auto address = start_address; address < end_address; address += 1024) {
@@ -22,8 +22,14 @@
 #include "../ZX8081/ZX8081.hpp"
 
 #include "../../Analyser/Dynamic/MultiMachine/MultiMachine.hpp"
+#include "../../Concurrency/ThreadPool.hpp"
 #include "TypedDynamicMachine.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace {
 
 ::Machine::DynamicMachine *MachineForTarget(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher, Machine::Error &error) {
@@ -66,6 +72,30 @@ namespace {
 	return machine;
 }
 
+/*!
+	Constructs the machine for a single target on the shared thread pool, decrementing @c remaining once done.
+*/
+class ConstructionJob: public Concurrency::ThreadPool::Job {
+	public:
+		ConstructionJob(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher, std::atomic<size_t> &remaining) :
+			target_(target), rom_fetcher_(rom_fetcher), remaining_(remaining) {}
+
+		Machine::DynamicMachine *machine = nullptr;
+		Machine::Error error = Machine::Error::None;
+
+	private:
+		bool perform() final {
+			machine = MachineForTarget(target_, rom_fetcher_, error);
+			--remaining_;
+			Concurrency::ThreadPool::shared().notify();
+			return false;
+		}
+
+		const Analyser::Static::Target *const target_;
+		const ROMMachine::ROMFetcher &rom_fetcher_;
+		std::atomic<size_t> &remaining_;
+};
+
 }
 
 ::Machine::DynamicMachine *::Machine::MachineForTargets(const Analyser::Static::TargetList &targets, const ROMMachine::ROMFetcher &rom_fetcher, Error &error) {
@@ -77,16 +107,56 @@ namespace {
 
 	// If there's more than one target, get all the machines and combine them into a multimachine.
 	if(targets.size() > 1) {
-		std::vector<std::unique_ptr<Machine::DynamicMachine>> machines;
-		for(const auto &target: targets) {
-			machines.emplace_back(MachineForTarget(target.get(), rom_fetcher, error));
+		// Construct the machines concurrently if that's likely to help. Fetchers aren't
+		// required to be thread safe, so calls to the fetcher are serialised.
+		std::mutex fetcher_mutex;
+		const ROMMachine::ROMFetcher serialised_fetcher = [&rom_fetcher, &fetcher_mutex] (const std::vector<ROMMachine::ROM> &roms) {
+			std::lock_guard<std::mutex> lock_guard(fetcher_mutex);
+			return rom_fetcher(roms);
+		};
+
+		auto &pool = Concurrency::ThreadPool::shared();
+		std::atomic<size_t> remaining(targets.size() - 1);
+		std::vector<std::unique_ptr<ConstructionJob>> jobs;
+		if(std::thread::hardware_concurrency() > 1) {
+			for(size_t c = 1; c < targets.size(); ++c) {
+				jobs.push_back(std::make_unique<ConstructionJob>(targets[c].get(), serialised_fetcher, remaining));
+				pool.schedule(jobs.back().get());
+			}
+		}
 
-			// Exit early if any errors have occurred.
-			if(error != Error::None) {
-				return nullptr;
+		// Collect machines in target order, keeping the first error if any occurred.
+		std::vector<std::unique_ptr<Machine::DynamicMachine>> machines;
+		Error first_error = Error::None;
+		const auto append = [&machines, &first_error] (Machine::DynamicMachine *machine, Error machine_error) {
+			machines.emplace_back(machine);
+			if(first_error == Error::None) first_error = machine_error;
+		};
+
+		Error machine_error;
+		Machine::DynamicMachine *machine = MachineForTarget(targets.front().get(), serialised_fetcher, machine_error);
+		append(machine, machine_error);
+		if(jobs.empty()) {
+			for(size_t c = 1; c < targets.size(); ++c) {
+				// Exit early if any errors have occurred.
+				if(first_error != Error::None) break;
+				machine = MachineForTarget(targets[c].get(), serialised_fetcher, machine_error);
+				append(machine, machine_error);
+			}
+		} else {
+			pool.wait([&remaining] {
+				return !remaining;
+			});
+			for(const auto &job: jobs) {
+				append(job->machine, job->error);
 			}
 		}
 
+		if(first_error != Error::None) {
+			error = first_error;
+			return nullptr;
+		}
+
 		// If a multimachine would just instantly collapse the list to a single machine, do
 		// so without the ongoing baggage of a multimachine.
 		if(Analyser::Dynamic::MultiMachine::would_collapse(machines)) {
@@ -0,0 +1,105 @@
+//
+//  ROMStore.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#include "ROMStore.hpp"
+
+#include "../../Numeric/CRC.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace ROMMachine;
+
+Store &Store::shared() {
+	static Store store;
+	return store;
+}
+
+void Store::set_search_paths(const std::vector<std::string> &paths) {
+	std::lock_guard<std::mutex> lock_guard(mutex_);
+	if(paths == paths_) return;
+
+	// Anything previously sought, found or not, may now resolve differently.
+	paths_ = paths;
+	records_.clear();
+}
+
+bool Store::is_present(const ROM &rom) {
+	return record(rom).is_present;
+}
+
+bool Store::is_known_image(const ROM &rom) {
+	const Record stored = record(rom);
+	return stored.is_present && std::find(rom.crc32s.begin(), rom.crc32s.end(), stored.crc32) != rom.crc32s.end();
+}
+
+ROMFetcher Store::fetcher() {
+	return [this] (const std::vector<ROM> &roms) {
+		std::vector<std::unique_ptr<std::vector<uint8_t>>> results;
+		for(const auto &rom: roms) {
+			results.push_back(load(rom));
+		}
+		return results;
+	};
+}
+
+Store::Record Store::record(const ROM &rom) {
+	{
+		std::lock_guard<std::mutex> lock_guard(mutex_);
+		const auto existing = records_.find(std::make_pair(rom.machine_name, rom.file_name));
+		if(existing != records_.end()) return existing->second;
+	}
+
+	// The image itself isn't needed, only the record made of it.
+	load(rom);
+
+	// If the search paths changed meanwhile then there'll be no record, and nothing is yet known.
+	std::lock_guard<std::mutex> lock_guard(mutex_);
+	const auto loaded = records_.find(std::make_pair(rom.machine_name, rom.file_name));
+	return loaded != records_.end() ? loaded->second : Record();
+}
+
+std::unique_ptr<std::vector<uint8_t>> Store::load(const ROM &rom) {
+	const auto key = std::make_pair(rom.machine_name, rom.file_name);
+	std::vector<std::string> paths;
+	bool is_recorded;
+	{
+		std::lock_guard<std::mutex> lock_guard(mutex_);
+		paths = paths_;
+		is_recorded = records_.find(key) != records_.end();
+	}
+
+	// Files are read without holding the lock, so that machines being constructed
+	// in parallel can fetch their ROMs in parallel.
+	std::unique_ptr<std::vector<uint8_t>> data;
+	for(const auto &path: paths) {
+		const std::string local_path = path + rom.machine_name + "/" + rom.file_name;
+		FILE *const file = std::fopen(local_path.c_str(), "rb");
+		if(!file) continue;
+
+		data = std::make_unique<std::vector<uint8_t>>();
+		std::fseek(file, 0, SEEK_END);
+		data->resize(size_t(std::ftell(file)));
+		std::fseek(file, 0, SEEK_SET);
+		const size_t read = std::fread(data->data(), 1, data->size(), file);
+		std::fclose(file);
+		if(read != data->size()) data.reset();
+		break;
+	}
+
+	// Compute the CRC32 only upon the first sighting of each image.
+	if(is_recorded) return data;
+
+	Record record;
+	record.is_present = bool(data);
+	if(data) record.crc32 = CRC::CRC32().compute_crc(*data);
+
+	std::lock_guard<std::mutex> lock_guard(mutex_);
+	if(paths == paths_) records_.emplace(key, record);
+	return data;
+}
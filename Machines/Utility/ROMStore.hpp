@@ -0,0 +1,73 @@
+//
+//  ROMStore.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#ifndef ROMStore_hpp
+#define ROMStore_hpp
+
+#include "../ROMMachine.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ROMMachine {
+
+/*!
+	A process-wide record of ROM images: where they are sought, whether each was found, and if so
+	its CRC32, which is computed once per image no matter how many machines request it.
+
+	Only those results are retained, not the images themselves; each machine takes ownership of the
+	images it fetches, so keeping another copy here would merely keep every ROM resident for the
+	lifetime of the process.
+
+	ROMs are sought within a machine-named subdirectory of each of the search paths, in order.
+	A ROM whose CRC32 matches none of those expected is still supplied, so that users remain
+	free to substitute their own firmware.
+*/
+class Store {
+	public:
+		/// @returns The process-wide store.
+		static Store &shared();
+
+		/// Sets the directories that will be searched for ROMs; each should end with a path separator.
+		void set_search_paths(const std::vector<std::string> &paths);
+
+		/// @returns @c true if @c rom can be found; @c false otherwise.
+		bool is_present(const ROM &rom);
+
+		/// @returns @c true if @c rom can be found and has one of the CRC32s listed for it; @c false otherwise.
+		bool is_known_image(const ROM &rom);
+
+		/// @returns A fetcher that supplies ROMs from the search paths, recording what it finds.
+		ROMFetcher fetcher();
+
+	private:
+		std::mutex mutex_;
+		std::vector<std::string> paths_;
+
+		struct Record {
+			bool is_present = false;
+			uint32_t crc32 = 0;
+		};
+
+		// Records by machine name and file name.
+		std::map<std::pair<std::string, std::string>, Record> records_;
+
+		/// Reads @c rom from the search paths, if it can be found, and records the result.
+		std::unique_ptr<std::vector<uint8_t>> load(const ROM &rom);
+
+		/// @returns The record for @c rom, loading it first if it hasn't yet been sought.
+		Record record(const ROM &rom);
+};
+
+}
+
+#endif /* ROMStore_hpp */
@@ -12,9 +12,10 @@
 
 using namespace Utility;
 
-Typer::Typer(const std::string &string, HalfCycles delay, HalfCycles frequency, std::unique_ptr<CharacterMapper> character_mapper, Delegate *delegate) :
+Typer::Typer(const std::string &string, HalfCycles delay, HalfCycles frequency, std::unique_ptr<CharacterMapper> character_mapper, Delegate *delegate, int keyboard_lines) :
 		frequency_(frequency),
 		counter_(-delay),
+		all_lines_((keyboard_lines > 0 && keyboard_lines < 32) ? (1u << keyboard_lines) - 1 : 0),
 		delegate_(delegate),
 		character_mapper_(std::move(character_mapper)) {
 	std::ostringstream string_stream;
@@ -25,6 +26,7 @@ Typer::Typer(const std::string &string, HalfCycles delay, HalfCycles frequency,
 void Typer::run_for(const HalfCycles duration) {
 	if(string_pointer_ < string_.size()) {
 		if(counter_ < 0 && counter_ + duration >= 0) {
+			did_transition();
 			if(!type_next_character()) {
 				delegate_->typer_reset(this);
 			}
@@ -33,6 +35,7 @@ void Typer::run_for(const HalfCycles duration) {
 		counter_ += duration;
 		while(string_pointer_ < string_.size() && counter_ > frequency_) {
 			counter_ -= frequency_;
+			did_transition();
 			if(!type_next_character()) {
 				delegate_->typer_reset(this);
 			}
@@ -40,6 +43,31 @@ void Typer::run_for(const HalfCycles duration) {
 	}
 }
 
+void Typer::did_read_keyboard_line(int line) {
+	// Ignore reads if typing isn't scan-driven, or hasn't yet begun.
+	if(!all_lines_ || counter_ < 0 || string_pointer_ == string_.size()) return;
+
+	// A scan is complete once every line has been read.
+	lines_read_ |= (1u << line) & all_lines_;
+	if(lines_read_ != all_lines_) return;
+	lines_read_ = 0;
+
+	++scans_;
+	if(scans_ < ScansPerTransition) return;
+
+	// Restart the clock, since the next transition is due a full period after this one.
+	counter_ = HalfCycles(0);
+	did_transition();
+	if(!type_next_character()) {
+		delegate_->typer_reset(this);
+	}
+}
+
+void Typer::did_transition() {
+	lines_read_ = 0;
+	scans_ = 0;
+}
+
 bool Typer::try_type_next_character() {
 	uint16_t *sequence = character_mapper_->sequence_for_character(string_[string_pointer_]);
 
@@ -46,6 +46,11 @@ class CharacterMapper {
 	Being given a delay and frequency at construction, the run_for interface can be used to produce time-based
 	typing. Alternatively, an owner may decline to use run_for and simply call type_next_character each time a
 	fresh key transition is ready to be consumed.
+
+	Owners that use run_for may also supply the number of lines in their keyboard matrix and report each read of
+	a line via did_read_keyboard_line. Typing then becomes scan-driven: the typer advances as soon as every line
+	has been read ScansPerTransition times since the last transition, so that the machine has certainly observed
+	it. The frequency continues to act as an upper bound on the time between transitions.
 */
 class Typer {
 	public:
@@ -54,12 +59,18 @@ class Typer {
 				virtual void typer_reset(Typer *typer) = 0;
 		};
 
-		Typer(const std::string &string, HalfCycles delay, HalfCycles frequency, std::unique_ptr<CharacterMapper> character_mapper, Delegate *delegate);
+		Typer(const std::string &string, HalfCycles delay, HalfCycles frequency, std::unique_ptr<CharacterMapper> character_mapper, Delegate *delegate, int keyboard_lines = 0);
 
 		void run_for(const HalfCycles duration);
 		bool type_next_character();
 		bool is_completed();
 
+		/// The number of complete scans of the keyboard that must follow a transition before scan-driven typing advances.
+		static constexpr int ScansPerTransition = 2;
+
+		/// Records that the machine has read line @c line of its keyboard, advancing scan-driven typing if appropriate.
+		void did_read_keyboard_line(int line);
+
 		const char BeginString = 0x02;	// i.e. ASCII start of text
 		const char EndString = 0x03;	// i.e. ASCII end of text
 
@@ -71,6 +82,11 @@ class Typer {
 		HalfCycles counter_;
 		int phase_ = 0;
 
+		uint32_t all_lines_ = 0;
+		uint32_t lines_read_ = 0;
+		int scans_ = 0;
+		void did_transition();
+
 		Delegate *delegate_;
 		std::unique_ptr<CharacterMapper> character_mapper_;
 
@@ -85,7 +101,7 @@ class TypeRecipient: public Typer::Delegate {
 	protected:
 		/// Attaches a typer to this class that will type @c string using @c character_mapper as a source.
 		void add_typer(const std::string &string, std::unique_ptr<CharacterMapper> character_mapper) {
-			typer_ = std::make_unique<Typer>(string, get_typer_delay(), get_typer_frequency(), std::move(character_mapper), this);
+			typer_ = std::make_unique<Typer>(string, get_typer_delay(), get_typer_frequency(), std::move(character_mapper), this, get_typer_keyboard_lines());
 		}
 
 		/*!
@@ -104,6 +120,9 @@ class TypeRecipient: public Typer::Delegate {
 
 		virtual HalfCycles get_typer_delay() { return HalfCycles(0); }
 		virtual HalfCycles get_typer_frequency() { return HalfCycles(0); }
+
+		/// Subclasses that report keyboard reads to typer_ should return the number of lines in their keyboard matrix; see Typer.
+		virtual int get_typer_keyboard_lines() { return 0; }
 		std::unique_ptr<Typer> typer_;
 
 	private:
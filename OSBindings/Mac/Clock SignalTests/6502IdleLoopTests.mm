@@ -0,0 +1,190 @@
+//
+//  6502IdleLoopTests.mm
+//  Clock SignalTests
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../../../Processors/6502/6502.hpp"
+
+namespace {
+
+/*!
+	Runs a program at 0x0200 that polls memory; at @c change_time the byte at 0x8000 is set, which the program
+	is waiting for. The program signals completion by fetching an opcode from 0x0300.
+
+	If idle-loop skipping is enabled then this bus handler skips as many iterations as it can while remaining
+	strictly before @c change_time, as a machine would with respect to its next scheduled event.
+*/
+class PollingMachine: public CPU::MOS6502::BusHandler {
+	public:
+		PollingMachine(const std::vector<uint8_t> &program, bool skips_idle_loops, int64_t change_time) :
+			m6502_(*this), memory_(65536), change_time_(change_time) {
+			std::copy(program.begin(), program.end(), memory_.begin() + 0x0200);
+			memory_[0x0300] = 0x4c;	// JMP $0300
+			memory_[0x0301] = 0x00;
+			memory_[0x0302] = 0x03;
+			memory_[0xfffc] = 0x00;
+			memory_[0xfffd] = 0x02;
+
+			m6502_.set_idle_loop_detection_enabled(skips_idle_loops);
+		}
+
+		Cycles perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			++time_;
+			if(time_ >= change_time_) memory_[0x8000] = 0x01;
+
+			if(operation == CPU::MOS6502::BusOperation::ReadOpcode && address == 0x0300 && completion_time_ < 0) {
+				completion_time_ = time_;
+			}
+			if(isReadOperation(operation)) {
+				*value = memory_[address];
+			} else if(operation == CPU::MOS6502::BusOperation::Write) {
+				memory_[address] = *value;
+			}
+
+			return Cycles(1);
+		}
+
+		Cycles skip_idle_loop(Cycles iteration_length, Cycles available) {
+			++skip_offers_;
+
+			const int64_t limit = std::min(available.as_integral(), change_time_ - time_);
+			if(limit <= 1) return Cycles(0);
+
+			const int64_t skipped = ((limit - 1) / iteration_length.as_integral()) * iteration_length.as_integral();
+			time_ += skipped;
+			skipped_time_ += skipped;
+			return Cycles(skipped);
+		}
+
+		void run_for(Cycles cycles) {
+			m6502_.run_for(cycles);
+		}
+
+		uint16_t get_value_of_register(CPU::MOS6502::Register r) {
+			return m6502_.get_value_of_register(r);
+		}
+
+		int64_t time() const				{	return time_;				}
+		int64_t completion_time() const		{	return completion_time_;	}
+		int64_t skipped_time() const		{	return skipped_time_;		}
+		int skip_offers() const				{	return skip_offers_;		}
+
+	private:
+		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, PollingMachine, false> m6502_;
+		std::vector<uint8_t> memory_;
+		const int64_t change_time_;
+
+		int64_t time_ = 0;
+		int64_t completion_time_ = -1;
+		int64_t skipped_time_ = 0;
+		int skip_offers_ = 0;
+};
+
+}
+
+@interface MOS6502IdleLoopTests : XCTestCase
+@end
+
+@implementation MOS6502IdleLoopTests
+
+/*!
+	Runs @c program with and without idle-loop skipping, in runs of random lengths, and checks that both
+	reach 0x0300 at the same time and in the same state.
+
+	@returns The amount of time that was skipped.
+*/
+- (int64_t)skippedTimeForProgram:(const std::vector<uint8_t> &)program {
+	const int64_t change_time = 500'003;
+	PollingMachine cycle_by_cycle(program, false, change_time);
+	PollingMachine skipping(program, true, change_time);
+
+	std::mt19937 random;
+	while(cycle_by_cycle.completion_time() < 0 || skipping.completion_time() < 0) {
+		const Cycles length = Cycles(1 + int(random() % 2500));
+		cycle_by_cycle.run_for(length);
+		skipping.run_for(length);
+		XCTAssertEqual(cycle_by_cycle.time(), skipping.time());
+		if(cycle_by_cycle.time() > 4 * change_time) break;
+	}
+
+	XCTAssertGreaterThanOrEqual(cycle_by_cycle.completion_time(), change_time);
+	XCTAssertEqual(cycle_by_cycle.completion_time(), skipping.completion_time());
+	for(const auto reg: {
+		CPU::MOS6502::Register::ProgramCounter,	CPU::MOS6502::Register::S,	CPU::MOS6502::Register::Flags,
+		CPU::MOS6502::Register::A,	CPU::MOS6502::Register::X,	CPU::MOS6502::Register::Y,
+	}) {
+		XCTAssertEqual(cycle_by_cycle.get_value_of_register(reg), skipping.get_value_of_register(reg));
+	}
+
+	XCTAssertEqual(cycle_by_cycle.skip_offers(), 0);
+	return skipping.skipped_time();
+}
+
+- (void)testPollingLoopIsSkipped {
+	const std::vector<uint8_t> program = {
+		0xad, 0x00, 0x80,	// loop: LDA $8000
+		0xf0, 0xfb,			// BEQ loop
+		0x4c, 0x00, 0x03,	// JMP $0300
+	};
+	const int64_t skipped = [self skippedTimeForProgram:program];
+	XCTAssertGreaterThan(skipped, int64_t(450'000));
+}
+
+- (void)testCountingLoopIsNotSkipped {
+	// The loop's state changes every iteration, so it isn't idle.
+	const std::vector<uint8_t> program = {
+		0xe8,				// loop: INX
+		0xad, 0x00, 0x80,	// LDA $8000
+		0xf0, 0xfa,			// BEQ loop
+		0x4c, 0x00, 0x03,	// JMP $0300
+	};
+	XCTAssertEqual([self skippedTimeForProgram:program], int64_t(0));
+}
+
+- (void)testRepeatedWritesAreSkipped {
+	// The loop writes the same value to the same address every iteration, so it is still idle.
+	const std::vector<uint8_t> program = {
+		0x8d, 0x00, 0x90,	// loop: STA $9000
+		0xad, 0x00, 0x80,	// LDA $8000
+		0xf0, 0xf8,			// BEQ loop
+		0x4c, 0x00, 0x03,	// JMP $0300
+	};
+	const int64_t skipped = [self skippedTimeForProgram:program];
+	XCTAssertGreaterThan(skipped, int64_t(450'000));
+}
+
+- (void)testSubroutineLoopIsSkipped {
+	// Each JSR pushes the same return address to the same place on the stack.
+	const std::vector<uint8_t> program = {
+		0x20, 0x10, 0x02,	// loop: JSR $0210
+		0xf0, 0xfb,			// BEQ loop
+		0x4c, 0x00, 0x03,	// JMP $0300
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xad, 0x00, 0x80,	// $0210: LDA $8000
+		0x60,				// RTS
+	};
+	const int64_t skipped = [self skippedTimeForProgram:program];
+	XCTAssertGreaterThan(skipped, int64_t(450'000));
+}
+
+- (void)testChangingWritesAreNotSkipped {
+	// The registers are the same at the end of every iteration, but the value written differs.
+	const std::vector<uint8_t> program = {
+		0xee, 0x00, 0x90,	// loop: INC $9000
+		0xad, 0x00, 0x80,	// LDA $8000
+		0xf0, 0xf8,			// BEQ loop
+		0x4c, 0x00, 0x03,	// JMP $0300
+	};
+	XCTAssertEqual([self skippedTimeForProgram:program], int64_t(0));
+}
+
+@end
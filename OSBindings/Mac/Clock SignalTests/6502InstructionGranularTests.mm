@@ -0,0 +1,148 @@
+//
+//  6502InstructionGranularTests.mm
+//  Clock SignalTests
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../../../Processors/6502/AllRAM/6502AllRAM.hpp"
+
+@interface MOS6502InstructionGranularTests : XCTestCase
+@end
+
+@implementation MOS6502InstructionGranularTests {
+	std::vector<uint8_t> _functionalTest;
+}
+
+- (void)setUp {
+	NSString *const path = [[NSBundle bundleForClass:[self class]] pathForResource:@"6502_functional_test" ofType:@"bin"];
+	NSData *const data = [NSData dataWithContentsOfFile:path];
+	XCTAssertNotNil(data, @"Klaus Dormann's functional test is required");
+
+	_functionalTest.resize(65536);
+	memcpy(_functionalTest.data(), data.bytes, std::min(size_t(data.length), _functionalTest.size()));
+}
+
+/*!
+	Runs an instruction-granular 6502 in lockstep with a cycle-by-cycle 6502 through Klaus Dormann's functional
+	test, in runs of random lengths, and checks that the two are in the same state after every run.
+
+	If @c toggle_irq is @c true then the IRQ line is also randomly toggled between runs, and the test's
+	IRQ handler is replaced with one that returns from anything other than BRK.
+*/
+- (void)runLockstepTogglingIRQ:(BOOL)toggle_irq {
+	std::vector<uint8_t> image = _functionalTest;
+	if(toggle_irq) {
+		const uint16_t brk_handler = uint16_t(image[0xfffe] | (image[0xffff] << 8));
+		const uint8_t irq_handler[] = {
+			0x48,				// PHA
+			0x8a,				// TXA
+			0x48,				// PHA
+			0xba,				// TSX
+			0xbd, 0x03, 0x01,	// LDA $0103, X
+			0x29, 0x10,			// AND #$10
+			0xd0, 0x05,			// BNE brk
+			0x68,				// PLA
+			0xaa,				// TAX
+			0x68,				// PLA
+			0x40,				// RTI
+			0xea,				// NOP
+			0x68,				// brk: PLA
+			0xaa,				// TAX
+			0x68,				// PLA
+			0x4c, uint8_t(brk_handler), uint8_t(brk_handler >> 8)	// JMP brk_handler
+		};
+		memcpy(&image[0xf000], irq_handler, sizeof(irq_handler));
+		image[0xfffe] = 0x00;
+		image[0xffff] = 0xf0;
+	}
+
+	const CPU::MOS6502::Register registers[] = {
+		CPU::MOS6502::Register::ProgramCounter,
+		CPU::MOS6502::Register::LastOperationAddress,
+		CPU::MOS6502::Register::Flags,
+		CPU::MOS6502::Register::A,
+		CPU::MOS6502::Register::X,
+		CPU::MOS6502::Register::Y,
+		CPU::MOS6502::Register::S,
+	};
+
+	// Registers are otherwise undefined at power on, so give both processors the same starting state.
+	std::unique_ptr<CPU::MOS6502::AllRAMProcessor> cycle_by_cycle(CPU::MOS6502::AllRAMProcessor::Processor(CPU::MOS6502::Personality::P6502, false));
+	std::unique_ptr<CPU::MOS6502::AllRAMProcessor> instruction_granular(CPU::MOS6502::AllRAMProcessor::Processor(CPU::MOS6502::Personality::P6502, true));
+	for(auto processor: {cycle_by_cycle.get(), instruction_granular.get()}) {
+		processor->set_data_at_address(0, image.size(), image.data());
+		for(const auto reg: registers) {
+			processor->set_value_of_register(reg, 0);
+		}
+		processor->set_value_of_register(CPU::MOS6502::Register::ProgramCounter, 0x400);
+	}
+
+	std::mt19937 random;
+	std::vector<uint8_t> cycle_by_cycle_memory(65536), instruction_granular_memory(65536);
+	uint16_t last_address = 0;
+	int repetitions = 0;
+	while(repetitions < 20) {
+		if(toggle_irq && !(random() % 5)) {
+			const bool irq = random() & 1;
+			cycle_by_cycle->set_irq_line(irq);
+			instruction_granular->set_irq_line(irq);
+		}
+
+		const Cycles length = Cycles(1 + random() % 200);
+		cycle_by_cycle->run_for(length);
+		instruction_granular->run_for(length);
+
+		for(const auto reg: registers) {
+			if(cycle_by_cycle->get_value_of_register(reg) != instruction_granular->get_value_of_register(reg)) {
+				XCTFail(@"Register %d differs after reaching %04x: %04x versus %04x",
+					int(reg),
+					cycle_by_cycle->get_value_of_register(CPU::MOS6502::Register::LastOperationAddress),
+					cycle_by_cycle->get_value_of_register(reg),
+					instruction_granular->get_value_of_register(reg));
+				return;
+			}
+		}
+		if(cycle_by_cycle->get_timestamp() != instruction_granular->get_timestamp()) {
+			XCTFail(@"Timestamps differ after reaching %04x", cycle_by_cycle->get_value_of_register(CPU::MOS6502::Register::LastOperationAddress));
+			return;
+		}
+		if(!(random() % 64)) {
+			cycle_by_cycle->get_data_at_address(0, cycle_by_cycle_memory.size(), cycle_by_cycle_memory.data());
+			instruction_granular->get_data_at_address(0, instruction_granular_memory.size(), instruction_granular_memory.data());
+			if(cycle_by_cycle_memory != instruction_granular_memory) {
+				XCTFail(@"Memory differs after reaching %04x", cycle_by_cycle->get_value_of_register(CPU::MOS6502::Register::LastOperationAddress));
+				return;
+			}
+		}
+
+		// The test ends by trapping at a single address.
+		const uint16_t address = cycle_by_cycle->get_value_of_register(CPU::MOS6502::Register::LastOperationAddress);
+		if(address == last_address) {
+			++repetitions;
+		} else {
+			repetitions = 0;
+			last_address = address;
+		}
+	}
+
+	XCTAssertEqual(last_address, uint16_t(0x3399), @"Functional test failed at %04x", last_address);
+}
+
+- (void)testLockstep {
+	[self runLockstepTogglingIRQ:NO];
+}
+
+- (void)testLockstepWithIRQs {
+	[self runLockstepTogglingIRQ:YES];
+}
+
+@end
@@ -0,0 +1,221 @@
+//
+//  68000IdleLoopTests.mm
+//  Clock SignalTests
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../../../Processors/68000/68000.hpp"
+
+namespace {
+
+/*!
+	Runs a program at 0x1000 that polls memory; at @c change_time the word at 0x8000 is set, which the program
+	is waiting for. The program signals completion by writing to 0x3000.
+
+	If idle-loop skipping is enabled then this bus handler skips as many iterations as it can while remaining
+	strictly before @c change_time, as a machine would with respect to its next scheduled event.
+*/
+class PollingMachine: public CPU::MC68000::BusHandler {
+	public:
+		PollingMachine(const std::vector<uint16_t> &program, bool skips_idle_loops, int64_t change_time) :
+			m68000_(*this), memory_(32768), change_time_(change_time) {
+			std::copy(program.begin(), program.end(), memory_.begin() + (0x1000 >> 1));
+
+			// Set the supervisor stack pointer to 0x0800 and the initial program counter to 0x1000.
+			memory_[1] = 0x0800;
+			memory_[3] = 0x1000;
+
+			m68000_.set_idle_loop_detection_enabled(skips_idle_loops);
+		}
+
+		HalfCycles perform_bus_operation(const CPU::MC68000::Microcycle &cycle, int is_supervisor) {
+			time_ += cycle.length.as_integral();
+			if(time_ >= change_time_) memory_[0x8000 >> 1] = 0x0001;
+
+			using Microcycle = CPU::MC68000::Microcycle;
+			if(!cycle.data_select_active() || (cycle.operation & Microcycle::InterruptAcknowledge)) {
+				return HalfCycles(0);
+			}
+
+			const uint32_t word_address = cycle.word_address() % memory_.size();
+			switch(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte | Microcycle::Read)) {
+				default: break;
+
+				case Microcycle::SelectWord | Microcycle::Read:
+					cycle.value->full = memory_[word_address];
+				break;
+				case Microcycle::SelectByte | Microcycle::Read:
+					cycle.value->halves.low = memory_[word_address] >> cycle.byte_shift();
+				break;
+				case Microcycle::SelectWord:
+				case Microcycle::SelectByte:
+					if(word_address == (0x3000 >> 1) && completion_time_ < 0) {
+						completion_time_ = time_;
+					}
+					if(cycle.operation & Microcycle::SelectWord) {
+						memory_[word_address] = cycle.value->full;
+					} else {
+						memory_[word_address] = uint16_t(
+							(cycle.value->halves.low << cycle.byte_shift()) |
+							(memory_[word_address] & cycle.untouched_byte_mask())
+						);
+					}
+				break;
+			}
+
+			return HalfCycles(0);
+		}
+
+		HalfCycles skip_idle_loop(HalfCycles iteration_length, HalfCycles available) {
+			++skip_offers_;
+
+			const int64_t limit = std::min(available.as_integral(), change_time_ - time_);
+			if(limit <= 1) return HalfCycles(0);
+
+			const int64_t skipped = ((limit - 1) / iteration_length.as_integral()) * iteration_length.as_integral();
+			time_ += skipped;
+			skipped_time_ += skipped;
+			return HalfCycles(skipped);
+		}
+
+		void run_for(HalfCycles cycles) {
+			m68000_.run_for(cycles);
+		}
+
+		CPU::MC68000::ProcessorState get_state() {
+			return m68000_.get_state();
+		}
+
+		int64_t time() const				{	return time_;				}
+		int64_t completion_time() const		{	return completion_time_;	}
+		int64_t skipped_time() const		{	return skipped_time_;		}
+		int skip_offers() const				{	return skip_offers_;		}
+
+	private:
+		CPU::MC68000::Processor<PollingMachine, true> m68000_;
+		std::vector<uint16_t> memory_;
+		const int64_t change_time_;
+
+		int64_t time_ = 0;
+		int64_t completion_time_ = -1;
+		int64_t skipped_time_ = 0;
+		int skip_offers_ = 0;
+};
+
+}
+
+@interface M68000IdleLoopTests : XCTestCase
+@end
+
+@implementation M68000IdleLoopTests
+
+/*!
+	Runs @c program with and without idle-loop skipping, in runs of random lengths, and checks that both
+	write to 0x3000 at the same time and in the same state.
+
+	@returns The amount of time that was skipped.
+*/
+- (int64_t)skippedTimeForProgram:(const std::vector<uint16_t> &)program {
+	const int64_t change_time = 1'000'003;
+	PollingMachine cycle_by_cycle(program, false, change_time);
+	PollingMachine skipping(program, true, change_time);
+
+	std::mt19937 random;
+	while(cycle_by_cycle.completion_time() < 0 || skipping.completion_time() < 0) {
+		const HalfCycles length = HalfCycles(1 + int(random() % 5000));
+		cycle_by_cycle.run_for(length);
+		skipping.run_for(length);
+		XCTAssertEqual(cycle_by_cycle.time(), skipping.time());
+		if(cycle_by_cycle.time() > 4 * change_time) break;
+	}
+
+	XCTAssertGreaterThanOrEqual(cycle_by_cycle.completion_time(), change_time);
+	XCTAssertEqual(cycle_by_cycle.completion_time(), skipping.completion_time());
+
+	const auto cycle_by_cycle_state = cycle_by_cycle.get_state();
+	const auto skipping_state = skipping.get_state();
+	for(int c = 0; c < 8; ++c) {
+		XCTAssertEqual(cycle_by_cycle_state.data[c], skipping_state.data[c]);
+	}
+	for(int c = 0; c < 7; ++c) {
+		XCTAssertEqual(cycle_by_cycle_state.address[c], skipping_state.address[c]);
+	}
+	XCTAssertEqual(cycle_by_cycle_state.supervisor_stack_pointer, skipping_state.supervisor_stack_pointer);
+	XCTAssertEqual(cycle_by_cycle_state.program_counter, skipping_state.program_counter);
+	XCTAssertEqual(cycle_by_cycle_state.status, skipping_state.status);
+
+	XCTAssertEqual(cycle_by_cycle.skip_offers(), 0);
+	return skipping.skipped_time();
+}
+
+- (void)testPollingLoopIsSkipped {
+	const std::vector<uint16_t> program = {
+		0x4a79, 0x0000, 0x8000,			// loop: TST.w ($8000).l
+		0x67f8,							// BEQ.s loop
+		0x33fc, 0x0001, 0x0000, 0x3000,	// MOVE.w #1, ($3000).l
+		0x60fe,							// BRA.s *
+	};
+	const int64_t skipped = [self skippedTimeForProgram:program];
+	XCTAssertGreaterThan(skipped, int64_t(900'000));
+}
+
+- (void)testCountingLoopIsNotSkipped {
+	// The loop's state changes every iteration, so it isn't idle.
+	const std::vector<uint16_t> program = {
+		0x5281,							// loop: ADDQ.l #1, D1
+		0x4a79, 0x0000, 0x8000,			// TST.w ($8000).l
+		0x67f6,							// BEQ.s loop
+		0x33fc, 0x0001, 0x0000, 0x3000,	// MOVE.w #1, ($3000).l
+		0x60fe,							// BRA.s *
+	};
+	XCTAssertEqual([self skippedTimeForProgram:program], int64_t(0));
+}
+
+- (void)testRepeatedWritesAreSkipped {
+	// The loop writes the same value to the same address every iteration, so it is still idle.
+	const std::vector<uint16_t> program = {
+		0x33c0, 0x0000, 0x9000,			// loop: MOVE.w D0, ($9000).l
+		0x4a79, 0x0000, 0x8000,			// TST.w ($8000).l
+		0x67f2,							// BEQ.s loop
+		0x33fc, 0x0001, 0x0000, 0x3000,	// MOVE.w #1, ($3000).l
+		0x60fe,							// BRA.s *
+	};
+	const int64_t skipped = [self skippedTimeForProgram:program];
+	XCTAssertGreaterThan(skipped, int64_t(900'000));
+}
+
+- (void)testSubroutineLoopIsSkipped {
+	// Each BSR pushes the same return address to the same place on the stack.
+	const std::vector<uint16_t> program = {
+		0x6100, 0x000e,					// loop: BSR.w $1010
+		0x67fa,							// BEQ.s loop
+		0x33fc, 0x0001, 0x0000, 0x3000,	// MOVE.w #1, ($3000).l
+		0x60fe,							// BRA.s *
+		0x4a79, 0x0000, 0x8000,			// $1010: TST.w ($8000).l
+		0x4e75,							// RTS
+	};
+	const int64_t skipped = [self skippedTimeForProgram:program];
+	XCTAssertGreaterThan(skipped, int64_t(900'000));
+}
+
+- (void)testChangingWritesAreNotSkipped {
+	// The registers are the same at the end of every iteration, but the value written differs.
+	const std::vector<uint16_t> program = {
+		0x5279, 0x0000, 0x9000,			// loop: ADDQ.w #1, ($9000).l
+		0x4a79, 0x0000, 0x8000,			// TST.w ($8000).l
+		0x67f2,							// BEQ.s loop
+		0x33fc, 0x0001, 0x0000, 0x3000,	// MOVE.w #1, ($3000).l
+		0x60fe,							// BRA.s *
+	};
+	XCTAssertEqual([self skippedTimeForProgram:program], int64_t(0));
+}
+
+@end
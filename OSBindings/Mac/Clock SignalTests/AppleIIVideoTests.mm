@@ -0,0 +1,299 @@
+//
+//  AppleIIVideoTests.mm
+//  Clock SignalTests
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../../../Machines/Apple/AppleII/Video.hpp"
+
+namespace {
+
+/*!
+	Exposes VideoBase's per-mode output functions, and provides serial reimplementations of each, producing
+	one sample at a time, against which they can be compared.
+*/
+class VideoBaseTester: public Apple::II::Video::VideoBase {
+	public:
+		VideoBaseTester(bool is_iie) : VideoBase(is_iie, [] (Cycles) {}) {}
+
+		using VideoBase::output_text;
+		using VideoBase::output_double_text;
+		using VideoBase::output_low_resolution;
+		using VideoBase::output_double_low_resolution;
+		using VideoBase::output_high_resolution;
+		using VideoBase::output_double_high_resolution;
+		using VideoBase::output_fat_low_resolution;
+
+		void set_graphics_carry(uint8_t carry) {
+			graphics_carry_ = reference_carry = carry;
+		}
+
+		uint8_t graphics_carry() const {
+			return graphics_carry_;
+		}
+
+		void set_high_resolution_mask(uint8_t mask) {
+			high_resolution_mask_ = mask;
+		}
+
+		uint8_t reference_carry = 0;
+
+		void reference_text(uint8_t *target, const uint8_t *const source, size_t length, size_t pixel_row) {
+			for(size_t c = 0; c < length; ++c) {
+				const int character = source[c] & character_zones[source[c] >> 6].address_mask;
+				const uint8_t xor_mask = character_zones[source[c] >> 6].xor_mask;
+				const std::size_t character_address = static_cast<std::size_t>(character << 3) + pixel_row;
+				const uint8_t character_pattern = character_rom_[character_address] ^ xor_mask;
+
+				target[0] = target[1] = character_pattern & 0x40;
+				target[2] = target[3] = character_pattern & 0x20;
+				target[4] = target[5] = character_pattern & 0x10;
+				target[6] = target[7] = character_pattern & 0x08;
+				target[8] = target[9] = character_pattern & 0x04;
+				target[10] = target[11] = character_pattern & 0x02;
+				target[12] = target[13] = character_pattern & 0x01;
+				reference_carry = character_pattern & 0x01;
+				target += 14;
+			}
+		}
+
+		void reference_double_text(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length, size_t pixel_row) {
+			for(size_t c = 0; c < length; ++c) {
+				const std::size_t character_addresses[2] = {
+					static_cast<std::size_t>(
+						(auxiliary_source[c] & character_zones[auxiliary_source[c] >> 6].address_mask) << 3
+					) + pixel_row,
+					static_cast<std::size_t>(
+						(source[c] & character_zones[source[c] >> 6].address_mask) << 3
+					) + pixel_row
+				};
+
+				const uint8_t character_patterns[2] = {
+					static_cast<uint8_t>(
+						character_rom_[character_addresses[0]] ^ character_zones[auxiliary_source[c] >> 6].xor_mask
+					),
+					static_cast<uint8_t>(
+						character_rom_[character_addresses[1]] ^ character_zones[source[c] >> 6].xor_mask
+					)
+				};
+
+				target[0] = character_patterns[0] & 0x40;
+				target[1] = character_patterns[0] & 0x20;
+				target[2] = character_patterns[0] & 0x10;
+				target[3] = character_patterns[0] & 0x08;
+				target[4] = character_patterns[0] & 0x04;
+				target[5] = character_patterns[0] & 0x02;
+				target[6] = character_patterns[0] & 0x01;
+				target[7] = character_patterns[1] & 0x40;
+				target[8] = character_patterns[1] & 0x20;
+				target[9] = character_patterns[1] & 0x10;
+				target[10] = character_patterns[1] & 0x08;
+				target[11] = character_patterns[1] & 0x04;
+				target[12] = character_patterns[1] & 0x02;
+				target[13] = character_patterns[1] & 0x01;
+				reference_carry = character_patterns[1] & 0x01;
+				target += 14;
+			}
+		}
+
+		void reference_low_resolution(uint8_t *target, const uint8_t *const source, size_t length, int column, int row) {
+			const int row_shift = row&4;
+			for(size_t c = 0; c < length; ++c) {
+				if((column + static_cast<int>(c))&1) {
+					target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 4;
+					target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 8;
+					target[2] = target[6] = target[10] = (source[c] >> row_shift) & 1;
+					target[3] = target[7] = target[11] = (source[c] >> row_shift) & 2;
+					reference_carry = (source[c] >> row_shift) & 8;
+				} else {
+					target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 1;
+					target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 2;
+					target[2] = target[6] = target[10] = (source[c] >> row_shift) & 4;
+					target[3] = target[7] = target[11] = (source[c] >> row_shift) & 8;
+					reference_carry = (source[c] >> row_shift) & 2;
+				}
+				target += 14;
+			}
+		}
+
+		void reference_fat_low_resolution(uint8_t *target, const uint8_t *const source, size_t length, int column, int row) {
+			const int row_shift = row&4;
+			for(size_t c = 0; c < length; ++c) {
+				target[0] = target[1] = target[8] = target[9] = (source[c] >> row_shift) & 1;
+				target[2] = target[3] = target[10] = target[11] = (source[c] >> row_shift) & 2;
+				target[4] = target[5] = target[12] = target[13] = (source[c] >> row_shift) & 4;
+				target[6] = target[7] = (source[c] >> row_shift) & 8;
+				reference_carry = (source[c] >> row_shift) & 4;
+				target += 14;
+			}
+		}
+
+		void reference_double_low_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length, int column, int row) {
+			const int row_shift = row&4;
+			for(size_t c = 0; c < length; ++c) {
+				if((column + static_cast<int>(c))&1) {
+					target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 2;
+					target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 4;
+					target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 8;
+					target[3] = (auxiliary_source[c] >> row_shift) & 1;
+
+					target[8] = target[12] = (source[c] >> row_shift) & 4;
+					target[9] = target[13] = (source[c] >> row_shift) & 8;
+					target[10] = (source[c] >> row_shift) & 1;
+					target[7] = target[11] = (source[c] >> row_shift) & 2;
+					reference_carry = (source[c] >> row_shift) & 8;
+				} else {
+					target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 8;
+					target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 1;
+					target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 2;
+					target[3] = (auxiliary_source[c] >> row_shift) & 4;
+
+					target[8] = target[12] = (source[c] >> row_shift) & 1;
+					target[9] = target[13] = (source[c] >> row_shift) & 2;
+					target[10] = (source[c] >> row_shift) & 4;
+					target[7] = target[11] = (source[c] >> row_shift) & 8;
+					reference_carry = (source[c] >> row_shift) & 2;
+				}
+				target += 14;
+			}
+		}
+
+		void reference_high_resolution(uint8_t *target, const uint8_t *const source, size_t length) {
+			for(size_t c = 0; c < length; ++c) {
+				if(source[c] & high_resolution_mask_ & 0x80) {
+					target[0] = reference_carry;
+					target[1] = target[2] = source[c] & 0x01;
+					target[3] = target[4] = source[c] & 0x02;
+					target[5] = target[6] = source[c] & 0x04;
+					target[7] = target[8] = source[c] & 0x08;
+					target[9] = target[10] = source[c] & 0x10;
+					target[11] = target[12] = source[c] & 0x20;
+					target[13] = source[c] & 0x40;
+				} else {
+					target[0] = target[1] = source[c] & 0x01;
+					target[2] = target[3] = source[c] & 0x02;
+					target[4] = target[5] = source[c] & 0x04;
+					target[6] = target[7] = source[c] & 0x08;
+					target[8] = target[9] = source[c] & 0x10;
+					target[10] = target[11] = source[c] & 0x20;
+					target[12] = target[13] = source[c] & 0x40;
+				}
+				reference_carry = source[c] & 0x40;
+				target += 14;
+			}
+		}
+
+		void reference_double_high_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length) {
+			for(size_t c = 0; c < length; ++c) {
+				target[0] = auxiliary_source[c] & 0x01;
+				target[1] = auxiliary_source[c] & 0x02;
+				target[2] = auxiliary_source[c] & 0x04;
+				target[3] = auxiliary_source[c] & 0x08;
+				target[4] = auxiliary_source[c] & 0x10;
+				target[5] = auxiliary_source[c] & 0x20;
+				target[6] = auxiliary_source[c] & 0x40;
+				target[7] = source[c] & 0x01;
+				target[8] = source[c] & 0x02;
+				target[9] = source[c] & 0x04;
+				target[10] = source[c] & 0x08;
+				target[11] = source[c] & 0x10;
+				target[12] = source[c] & 0x20;
+				target[13] = source[c] & 0x40;
+
+				reference_carry = auxiliary_source[c] & 0x40;
+				target += 14;
+			}
+		}
+};
+
+enum class Mode {
+	Text, DoubleText, LowRes, DoubleLowRes, HighRes, DoubleHighRes, FatLowRes
+};
+constexpr int NumModes = 7;
+
+}
+
+@interface AppleIIVideoTests : XCTestCase
+@end
+
+@implementation AppleIIVideoTests
+
+/// Compares the output and graphics carry of every display mode, on both the II and the IIe and with
+/// Annunciator 3 both set and clear, with those of a serial implementation.
+- (void)testOutputAgainstSerialReference {
+	std::mt19937 random(2026);
+
+	std::vector<uint8_t> character_rom(4096);
+	for(auto &byte: character_rom) byte = uint8_t(random());
+
+	for(const bool is_iie: {false, true}) {
+		VideoBaseTester video(is_iie);
+		video.set_character_rom(character_rom);
+
+		for(int run = 0; run < 20000; ++run) {
+			const auto mode = Mode(run % NumModes);
+			video.set_high_resolution_mask((random() & 1) ? 0x7f : 0xff);
+			video.set_graphics_carry((random() & 1) ? 0x40 : 0x00);
+
+			uint8_t source[40], auxiliary_source[40];
+			for(auto &byte: source) byte = uint8_t(random());
+			for(auto &byte: auxiliary_source) byte = uint8_t(random());
+
+			const size_t length = 1 + random() % 40;
+			const size_t pixel_row = random() % 8;
+			const int column = int(random() % 40);
+			const int row = int(random() % 192);
+
+			// Leave space on each side of the output, to detect any overrun.
+			uint8_t output[40*14 + 32], expected[40*14 + 32];
+			memset(output, 0xcd, sizeof(output));
+			memset(expected, 0xcd, sizeof(expected));
+			uint8_t *const target = &output[16];
+			uint8_t *const expected_target = &expected[16];
+
+			switch(mode) {
+				case Mode::Text:
+					video.output_text(target, source, length, pixel_row);
+					video.reference_text(expected_target, source, length, pixel_row);
+				break;
+				case Mode::DoubleText:
+					video.output_double_text(target, source, auxiliary_source, length, pixel_row);
+					video.reference_double_text(expected_target, source, auxiliary_source, length, pixel_row);
+				break;
+				case Mode::LowRes:
+					video.output_low_resolution(target, source, length, column, row);
+					video.reference_low_resolution(expected_target, source, length, column, row);
+				break;
+				case Mode::DoubleLowRes:
+					video.output_double_low_resolution(target, source, auxiliary_source, length, column, row);
+					video.reference_double_low_resolution(expected_target, source, auxiliary_source, length, column, row);
+				break;
+				case Mode::HighRes:
+					video.output_high_resolution(target, source, length);
+					video.reference_high_resolution(expected_target, source, length);
+				break;
+				case Mode::DoubleHighRes:
+					video.output_double_high_resolution(target, source, auxiliary_source, length);
+					video.reference_double_high_resolution(expected_target, source, auxiliary_source, length);
+				break;
+				case Mode::FatLowRes:
+					video.output_fat_low_resolution(target, source, length, column, row);
+					video.reference_fat_low_resolution(expected_target, source, length, column, row);
+				break;
+			}
+
+			XCTAssert(!memcmp(output, expected, sizeof(output)), @"Output differs in mode %d, run %d", int(mode), run);
+			XCTAssertEqual(video.graphics_carry(), video.reference_carry, @"Carry differs in mode %d, run %d", int(mode), run);
+		}
+	}
+}
+
+@end
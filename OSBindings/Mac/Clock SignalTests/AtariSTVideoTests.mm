@@ -9,6 +9,7 @@
 #import <XCTest/XCTest.h>
 
 #include <memory>
+#include <random>
 
 #include "../../../Machines/Atari/ST/Video.hpp"
 
@@ -18,8 +19,122 @@ struct VideoTester {
 	static bool vsync(Atari::ST::Video &video) {
 		return video.vertical_.sync;
 	}
+
+	using OutputBpp = Atari::ST::Video::OutputBpp;
+	using VideoStream = Atari::ST::Video::VideoStream;
+
+	static void output_pixels(VideoStream &stream, int duration) {
+		stream.output_pixels(duration);
+	}
+
+	static void shift(VideoStream &stream, int duration) {
+		stream.shift(duration);
+	}
+
+	static void flush_pixels(VideoStream &stream) {
+		stream.flush_pixels();
+	}
+
+	static uint64_t shifter(const VideoStream &stream) {
+		return stream.output_shifter_;
+	}
 };
 
+namespace {
+
+/// Provides the same pixel buffer to every allocation, so that shifter output can be inspected.
+class PixelCaptureScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		void set_modals(Modals) override {}
+		Scan *begin_scan() override { return &scan_; }
+		void end_scan() override {}
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) override {
+			return reinterpret_cast<uint8_t *>(pixels);
+		}
+		void end_data(size_t actual_length) override {}
+		void submit() override {}
+
+		uint16_t pixels[512];
+
+	private:
+		Scan scan_;
+};
+
+/*!
+	Serially reproduces the Shifter's output, one pixel at a time.
+*/
+struct ReferenceShifter {
+	ReferenceShifter(VideoTester::OutputBpp bpp, const uint16_t *palette, uint64_t shifter) :
+		bpp(bpp), palette(palette), shifter(shifter) {}
+
+	/// Outputs @c duration worth of pixels to @c target, returning the number of pixels output.
+	int output_pixels(int duration, uint16_t *target) {
+		int pixels = 0;
+		switch(bpp) {
+			case VideoTester::OutputBpp::One:
+				for(; pixels < duration << 1; ++pixels) {
+					target[pixels] = ((shifter >> 63) & 1) * 0xffff;
+					shifter <<= 1;
+				}
+			break;
+			case VideoTester::OutputBpp::Two:
+				for(; pixels < duration; ++pixels) {
+					target[pixels] = palette[
+						((shifter >> 63) & 1) |
+						((shifter >> 46) & 2)
+					];
+					shift_two();
+				}
+			break;
+			case VideoTester::OutputBpp::Four:
+				for(; pixels < duration >> 1; ++pixels) {
+					target[pixels] = palette[
+						((shifter >> 63) & 1) |
+						((shifter >> 46) & 2) |
+						((shifter >> 29) & 4) |
+						((shifter >> 12) & 8)
+					];
+					shifter = (shifter << 1) & 0xfffefffefffefffe;
+				}
+			break;
+		}
+		return pixels;
+	}
+
+	/// Shifts without output for @c duration.
+	void shift(int duration) {
+		switch(bpp) {
+			case VideoTester::OutputBpp::One:
+				shifter <<= duration << 1;
+			break;
+			case VideoTester::OutputBpp::Two:
+				while(duration--) shift_two();
+			break;
+			case VideoTester::OutputBpp::Four:
+				for(; duration > 0; duration -= 2) {
+					shifter = (shifter << 1) & 0xfffefffefffefffe;
+				}
+			break;
+		}
+	}
+
+	VideoTester::OutputBpp bpp;
+	const uint16_t *palette;
+	uint64_t shifter;
+
+	private:
+		// Shifts the top two words one to the left, feeding their least significant bits from
+		// the most significant bits of the bottom two words.
+		void shift_two() {
+			uint64_t high = shifter >> 32, low = shifter & 0xffffffff;
+			high = ((high << 1) & 0xfffefffe) | ((low & 0x80008000) >> 15);
+			low = (low << 1) & 0xfffefffe;
+			shifter = (high << 32) | low;
+		}
+};
+
+}
+
 @interface AtariSTVideoTests : XCTestCase
 @end
 
@@ -322,6 +437,60 @@ struct RunLength {
 	XCTAssertNotEqual([self currentVideoAddress], 0);
 }
 
+// MARK: - Shifter Tests
+
+/// Compares the Shifter's output and state after random sequences of output and shifting, in every
+/// bit depth, with those of a serial implementation.
+- (void)testShifterAgainstSerialReference {
+	std::mt19937 random(2026);
+	PixelCaptureScanTarget target;
+	Outputs::CRT::CRT crt(1024, 1, Outputs::Display::Type::PAL50, Outputs::Display::InputDataType::Red4Green4Blue4);
+	crt.set_scan_target(&target);
+
+	uint16_t palette[16];
+	for(auto &colour: palette) colour = uint16_t(random());
+	VideoTester::VideoStream stream(crt, palette);
+
+	const VideoTester::OutputBpp depths[] = {
+		VideoTester::OutputBpp::One, VideoTester::OutputBpp::Two, VideoTester::OutputBpp::Four
+	};
+	for(int run = 0; run < 3000; ++run) {
+		const auto bpp = depths[run % 3];
+		stream.set_bpp(bpp);
+
+		const uint64_t value = (uint64_t(random()) << 32) | uint64_t(random());
+		stream.load(value);
+		ReferenceShifter reference(bpp, palette, value);
+
+		uint16_t expected[512];
+		int pixels = 0;
+		while(true) {
+			// Four-bit output occurs at half the rate of the others, and the shifter is
+			// clocked only on even cycles; one-bit output occurs at twice the rate.
+			int duration = 1 + int(random() % 24);
+			if(bpp == VideoTester::OutputBpp::Four) duration &= ~1;
+			if(!duration) continue;
+			const int duration_pixels =
+				bpp == VideoTester::OutputBpp::One ? duration << 1 :
+				(bpp == VideoTester::OutputBpp::Four ? duration >> 1 : duration);
+			if(pixels + duration_pixels >= 352) break;
+
+			if(random() % 4) {
+				VideoTester::output_pixels(stream, duration);
+				pixels += reference.output_pixels(duration, &expected[pixels]);
+			} else {
+				VideoTester::shift(stream, duration);
+				reference.shift(duration);
+			}
+
+			XCTAssertEqual(VideoTester::shifter(stream), reference.shifter, @"Shifter differs in run %d", run);
+		}
+
+		XCTAssert(!memcmp(target.pixels, expected, size_t(pixels) * sizeof(uint16_t)), @"Output differs in run %d", run);
+		VideoTester::flush_pixels(stream);
+	}
+}
+
 // MARK: - Tests Correlating To Exact Pieces of Software
 
 - (void)testUnionDemoScroller {
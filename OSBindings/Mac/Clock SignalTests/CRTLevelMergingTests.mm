@@ -0,0 +1,324 @@
+//
+//  CRTLevelMergingTests.mm
+//  Clock SignalTests
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../../Outputs/CRT/CRT.hpp"
+
+namespace {
+
+/*!
+	Records every call that a CRT makes to it as a line of text, including the value of the first sample
+	of each scan, so that the output of two CRTs can be compared.
+*/
+class RecordingScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		void set_modals(Modals modals) override {
+			char line[64];
+			snprintf(line, sizeof(line), "modals %d %d", int(modals.display_type), int(modals.input_data_type));
+			log_.push_back(line);
+		}
+
+		Scan *begin_scan() override {
+			return &scan_;
+		}
+
+		void end_scan() override {
+			char line[128];
+			snprintf(line, sizeof(line), "scan (%d, %d) to (%d, %d), samples %d to %d, angle %d, value %02x",
+				scan_.end_points[0].x, scan_.end_points[0].y,
+				scan_.end_points[1].x, scan_.end_points[1].y,
+				scan_.end_points[0].data_offset, scan_.end_points[1].data_offset,
+				scan_.end_points[0].composite_angle,
+				data_[scan_.end_points[0].data_offset]);
+			log_.push_back(line);
+		}
+
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) override {
+			log_.push_back("begin_data " + std::to_string(required_length));
+			return data_.data();
+		}
+
+		void end_data(size_t actual_length) override {
+			log_.push_back("end_data " + std::to_string(actual_length));
+		}
+
+		void submit() override {}
+
+		void announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) override {
+			log_.push_back("announce " + std::to_string(int(event)));
+		}
+
+		const std::vector<std::string> &log() const {
+			return log_;
+		}
+
+		/// @returns The number of log entries that begin with @c prefix.
+		size_t count(const std::string &prefix) const {
+			return size_t(std::count_if(log_.begin(), log_.end(), [&prefix] (const std::string &line) {
+				return !line.compare(0, prefix.size(), prefix);
+			}));
+		}
+
+		/// @returns @c true if every call to end_data follows a call to begin_data that hasn't yet been ended.
+		bool is_balanced() const {
+			int open_areas = 0;
+			for(const auto &line: log_) {
+				if(!line.compare(0, 10, "begin_data")) open_areas = 1;
+				if(!line.compare(0, 8, "end_data")) {
+					if(!open_areas) return false;
+					open_areas = 0;
+				}
+			}
+			return true;
+		}
+
+		/// @returns The values of all scans, in order, omitting repeats.
+		std::string scan_values() const {
+			std::string values;
+			for(const auto &line: log_) {
+				if(line.compare(0, 4, "scan")) continue;
+				const std::string value = line.substr(line.size() - 2);
+				if(values.size() < 2 || values.compare(values.size() - 2, 2, value)) {
+					values += value;
+				}
+			}
+			return values;
+		}
+
+	private:
+		std::vector<std::string> log_;
+		Scan scan_;
+		std::vector<uint8_t> data_ = std::vector<uint8_t>(4096);
+};
+
+/// Pairs a CRT with a scan target that records its output.
+struct RecordedCRT {
+	RecordedCRT() : crt(456, 1, Outputs::Display::Type::PAL50, Outputs::Display::InputDataType::Luminance8) {
+		crt.set_scan_target(&target);
+
+		// Run for long enough to be clear of the first vertical retrace, so that subsequent output is visible.
+		for(int c = 0; c < 100; ++c) {
+			begin_line();
+			crt.output_blank(400);
+		}
+	}
+
+	/// Outputs horizontal sync and the lead-in to a new line.
+	void begin_line() {
+		crt.output_sync(32);
+		crt.output_blank(24);
+	}
+
+	void output_level(uint8_t value, int cycles) {
+		uint8_t *const data = crt.begin_data(1);
+		if(data) *data = value;
+		crt.output_level(cycles);
+	}
+
+	void output_data(const std::vector<uint8_t> &values, int cycles_per_sample) {
+		uint8_t *const data = crt.begin_data(values.size());
+		if(data) std::copy(values.begin(), values.end(), data);
+		crt.output_data(int(values.size()) * cycles_per_sample, values.size());
+	}
+
+	Outputs::CRT::CRT crt;
+	RecordingScanTarget target;
+};
+
+}
+
+@interface CRTLevelMergingTests : XCTestCase
+@end
+
+@implementation CRTLevelMergingTests
+
+- (void)testIdenticalLevelsAreMerged {
+	RecordedCRT merged, reference;
+	merged.begin_line();
+	reference.begin_line();
+
+	for(int c = 0; c < 50; ++c) {
+		merged.output_level(0xaa, 4);
+	}
+	reference.output_level(0xaa, 200);
+
+	merged.crt.output_blank(40);
+	reference.crt.output_blank(40);
+
+	XCTAssert(merged.target.log() == reference.target.log());
+	XCTAssertEqual(merged.target.count("begin_data"), 1);
+	XCTAssertTrue(merged.target.is_balanced());
+}
+
+- (void)testValueChangingMidRun {
+	RecordedCRT merged, reference;
+	merged.begin_line();
+	reference.begin_line();
+
+	for(const uint8_t value: {0xaa, 0xaa, 0xaa, 0x55, 0x55, 0xaa}) {
+		merged.output_level(value, 10);
+	}
+	reference.output_level(0xaa, 30);
+	reference.output_level(0x55, 20);
+	reference.output_level(0xaa, 10);
+
+	merged.crt.output_blank(40);
+	reference.crt.output_blank(40);
+
+	XCTAssert(merged.target.log() == reference.target.log());
+	XCTAssertEqual(merged.target.count("begin_data"), 3);
+	XCTAssertEqual(merged.target.scan_values(), "aa55aa");
+	XCTAssertTrue(merged.target.is_balanced());
+}
+
+- (void)testScratchAreaFollowedByData {
+	RecordedCRT merged, reference;
+	merged.begin_line();
+	reference.begin_line();
+
+	// A single-sample allocation while a level is pending is provided from the CRT's scratch area,
+	// and must be moved into the scan target once it is output as data.
+	merged.output_level(0xaa, 10);
+	merged.output_level(0xaa, 10);
+	merged.output_data({0x55}, 5);
+	merged.output_data({0x11, 0x22, 0x33}, 5);
+
+	reference.output_level(0xaa, 20);
+	reference.output_data({0x55}, 5);
+	reference.output_data({0x11, 0x22, 0x33}, 5);
+
+	merged.crt.output_blank(40);
+	reference.crt.output_blank(40);
+
+	XCTAssert(merged.target.log() == reference.target.log());
+	XCTAssertEqual(merged.target.count("begin_data"), 3);
+	XCTAssertEqual(merged.target.scan_values(), "aa5511");
+	XCTAssertTrue(merged.target.is_balanced());
+}
+
+- (void)testModalChangeWhileLevelIsPending {
+	RecordedCRT merged, reference;
+	merged.begin_line();
+	reference.begin_line();
+
+	merged.output_level(0xaa, 10);
+	merged.output_level(0xaa, 10);
+	merged.crt.set_display_type(Outputs::Display::DisplayType::RGB);
+	merged.output_level(0xaa, 10);
+
+	reference.output_level(0xaa, 20);
+	reference.crt.set_display_type(Outputs::Display::DisplayType::RGB);
+	reference.output_level(0xaa, 10);
+
+	merged.crt.output_blank(40);
+	reference.crt.output_blank(40);
+
+	XCTAssert(merged.target.log() == reference.target.log());
+
+	// The pending level must have been posted before the modals changed, and not extended across the change.
+	const auto &log = merged.target.log();
+	const auto modals = std::find_if(log.begin() + 1, log.end(), [] (const std::string &line) {
+		return !line.compare(0, 6, "modals");
+	});
+	XCTAssert(modals != log.end());
+	XCTAssertEqual((modals - 1)->compare(0, 4, "scan"), 0);
+	XCTAssertEqual(merged.target.count("begin_data"), 2);
+	XCTAssertTrue(merged.target.is_balanced());
+}
+
+- (void)testModalChangeAfterScratchAreaIsVended {
+	RecordedCRT crt;
+	crt.begin_line();
+
+	// Begin a new value while a level is pending, then change modals before outputting it; the new value
+	// must survive the change.
+	crt.output_level(0xaa, 10);
+	uint8_t *const data = crt.crt.begin_data(1);
+	*data = 0x55;
+	crt.crt.set_display_type(Outputs::Display::DisplayType::RGB);
+	crt.crt.output_level(10);
+	crt.crt.output_blank(40);
+
+	XCTAssertEqual(crt.target.scan_values(), "aa55");
+	XCTAssertEqual(crt.target.count("begin_data"), 2);
+	XCTAssertTrue(crt.target.is_balanced());
+}
+
+/*!
+	Feeds random sequences of levels, data and syncs to one CRT and the same sequences to another with
+	all consecutive levels pre-merged, and checks that the two produce identical output.
+*/
+- (void)testRandomisedAgainstPremergedLevels {
+	std::mt19937 random(2026);
+
+	for(int run = 0; run < 20; ++run) {
+		RecordedCRT merged, reference;
+		uint8_t pending_value = 0;
+		int pending_cycles = 0;
+		const auto flush_reference = [&] {
+			if(pending_cycles) reference.output_level(pending_value, pending_cycles);
+			pending_cycles = 0;
+		};
+
+		for(int line = 0; line < 400; ++line) {
+			flush_reference();
+			merged.begin_line();
+			reference.begin_line();
+			merged.crt.output_default_colour_burst(16);
+			reference.crt.output_default_colour_burst(16);
+
+			int remaining = 368;
+			while(remaining > 0) {
+				const int length = std::min(remaining, 1 + int(random() % 24));
+				remaining -= length;
+
+				switch(random() % 8) {
+					default: {
+						// Use only a few values, so that runs are common.
+						const uint8_t value = uint8_t((random() % 3) * 0x55);
+						merged.output_level(value, length);
+						if(pending_cycles && value != pending_value) flush_reference();
+						pending_value = value;
+						pending_cycles += length;
+					} break;
+
+					case 0: {
+						std::vector<uint8_t> values(size_t(1 + random() % 4));
+						for(auto &value: values) value = uint8_t(random());
+						merged.output_data(values, 2);
+						flush_reference();
+						reference.output_data(values, 2);
+						remaining -= int(values.size()) * 2 - length;
+					} break;
+
+					case 1:
+						merged.crt.output_blank(length);
+						flush_reference();
+						reference.crt.output_blank(length);
+					break;
+				}
+			}
+		}
+		flush_reference();
+		merged.crt.output_sync(32);
+		reference.crt.output_sync(32);
+
+		XCTAssert(merged.target.log() == reference.target.log(), @"Output differs in run %d", run);
+		XCTAssertTrue(merged.target.is_balanced());
+		XCTAssertTrue(reference.target.is_balanced());
+	}
+}
+
+@end
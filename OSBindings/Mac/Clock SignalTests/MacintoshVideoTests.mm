@@ -9,8 +9,33 @@
 #import <XCTest/XCTest.h>
 
 #include <memory>
+#include <random>
+#include <vector>
 #include "../../../Machines/Apple/Macintosh/Video.hpp"
 
+namespace {
+
+/// Retains every data area allocated by the CRT, in order.
+class DataCaptureScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		void set_modals(Modals) override {}
+		Scan *begin_scan() override { return &scan_; }
+		void end_scan() override {}
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) override {
+			areas.emplace_back(required_length);
+			return areas.back().data();
+		}
+		void end_data(size_t actual_length) override {}
+		void submit() override {}
+
+		std::vector<std::vector<uint8_t>> areas;
+
+	private:
+		Scan scan_;
+};
+
+}
+
 @interface MacintoshVideoTests : XCTestCase
 @end
 
@@ -24,7 +49,7 @@
 - (void)setUp {
 	// Put setup code here. This method is called before the invocation of each test method in the class.
 	_video = std::make_unique<Apple::Macintosh::Video>(_dummy_audio, _dummy_drive_speed_accumulator);
-	_video->set_ram(_ram, sizeof(_ram) - 1);
+	_video->set_ram(_ram, sizeof(_ram)/sizeof(*_ram) - 1);
 }
 
 - (void)testPrediction {
@@ -44,4 +69,57 @@
 	}
 }
 
+/// Runs a frame of random RAM and compares the pixels output with those produced serially from the same RAM.
+- (void)testPixelOutput {
+	std::mt19937 random(2026);
+	for(auto &word: _ram) word = uint16_t(random());
+
+	DataCaptureScanTarget target;
+	_video->set_scan_target(&target);
+
+	// Run for a frame in uneven steps, so that fetches are split across calls.
+	auto remaining = Apple::Macintosh::frame_length;
+	while(remaining > HalfCycles(0)) {
+		const auto step = std::min(remaining, HalfCycles(1 + int(random() % 200)));
+		_video->run_for(step);
+		remaining -= step;
+	}
+
+	XCTAssertEqual(target.areas.size(), 342);
+	const uint16_t *words = &_ram[(0xffffa700 >> 1) & 0xffff];
+	for(const auto &area: target.areas) {
+		XCTAssertEqual(area.size(), 512);
+
+		uint8_t expected[512];
+		uint8_t *pixel_buffer = expected;
+		for(int c = 0; c < 32; ++c) {
+			uint16_t pixels = *words ^ 0xffff;
+			++words;
+
+			pixel_buffer[15] = pixels & 0x01;
+			pixel_buffer[14] = pixels & 0x02;
+			pixel_buffer[13] = pixels & 0x04;
+			pixel_buffer[12] = pixels & 0x08;
+			pixel_buffer[11] = pixels & 0x10;
+			pixel_buffer[10] = pixels & 0x20;
+			pixel_buffer[9] = pixels & 0x40;
+			pixel_buffer[8] = pixels & 0x80;
+
+			pixels >>= 8;
+			pixel_buffer[7] = pixels & 0x01;
+			pixel_buffer[6] = pixels & 0x02;
+			pixel_buffer[5] = pixels & 0x04;
+			pixel_buffer[4] = pixels & 0x08;
+			pixel_buffer[3] = pixels & 0x10;
+			pixel_buffer[2] = pixels & 0x20;
+			pixel_buffer[1] = pixels & 0x40;
+			pixel_buffer[0] = pixels & 0x80;
+
+			pixel_buffer += 16;
+		}
+
+		XCTAssert(!memcmp(area.data(), expected, sizeof(expected)));
+	}
+}
+
 @end
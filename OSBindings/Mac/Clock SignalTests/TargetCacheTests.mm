@@ -0,0 +1,240 @@
+//
+//  TargetCacheTests.mm
+//  Clock SignalTests
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <typeinfo>
+#include <unistd.h>
+#include <vector>
+
+#include "../../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../../Analyser/Static/TargetCache.hpp"
+#include "../../../Analyser/Static/AmstradCPC/Target.hpp"
+#include "../../../Analyser/Static/Commodore/Target.hpp"
+#include "../../../Analyser/Static/Oric/Target.hpp"
+
+namespace {
+
+/// @returns The contents of the file at @c path, or an empty vector if it can't be read.
+std::vector<uint8_t> contents(const std::string &path) {
+	std::vector<uint8_t> data;
+	FILE *const file = std::fopen(path.c_str(), "rb");
+	if(!file) return data;
+
+	uint8_t buffer[4096];
+	size_t read;
+	while((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		data.insert(data.end(), buffer, buffer + read);
+	}
+	std::fclose(file);
+	return data;
+}
+
+/// Writes @c data to the file at @c path.
+void write(const std::string &path, const std::vector<uint8_t> &data) {
+	FILE *const file = std::fopen(path.c_str(), "wb");
+	std::fwrite(data.data(), 1, data.size(), file);
+	std::fclose(file);
+}
+
+/// @returns The index of @c item within @c list, or -1 if it isn't present.
+template <typename T> int index_of(const std::vector<std::shared_ptr<T>> &list, const std::shared_ptr<T> &item) {
+	const auto position = std::find(list.begin(), list.end(), item);
+	return position == list.end() ? -1 : int(position - list.begin());
+}
+
+/// @returns Targets of several types with non-default fields, referring to @c media.
+Analyser::Static::TargetList make_targets(const Analyser::Static::Media &media) {
+	using namespace Analyser::Static;
+	TargetList targets;
+	{
+		auto target = std::make_unique<AmstradCPC::Target>();
+		target->machine = Analyser::Machine::AmstradCPC;
+		target->confidence = 0.75f;
+		target->model = AmstradCPC::Target::Model::CPC6128;
+		target->loading_command = "run\"disc\n";
+		target->media.disks = media.disks;
+		targets.push_back(std::move(target));
+	}
+	{
+		auto target = std::make_unique<Commodore::Target>();
+		target->machine = Analyser::Machine::Vic20;
+		target->confidence = 0.25f;
+		target->enabled_ram.bank1 = true;
+		target->enabled_ram.bank5 = true;
+		target->region = Commodore::Target::Region::Japanese;
+		target->has_c1540 = true;
+		target->loading_command = "LOAD\"\",8,1\nRUN\n";
+		target->media.disks.push_back(media.disks.back());
+		targets.push_back(std::move(target));
+	}
+	{
+		auto target = std::make_unique<Oric::Target>();
+		target->machine = Analyser::Machine::Oric;
+		target->confidence = 0.5f;
+		target->rom = Oric::Target::ROM::Pravetz;
+		target->disk_interface = Oric::Target::DiskInterface::Jasmin;
+		target->should_start_jasmin = true;
+		targets.push_back(std::move(target));
+	}
+	return targets;
+}
+
+}
+
+@interface TargetCacheTests : XCTestCase
+@end
+
+@implementation TargetCacheTests {
+	std::string _directory;
+	std::string _disk_name;
+	Analyser::Static::TargetCache _cache;
+}
+
+- (void)setUp {
+	char directory[] = "/tmp/TargetCacheTests.XXXXXX";
+	XCTAssert(mkdtemp(directory));
+	_directory = std::string(directory) + "/";
+	_cache.set_directory(_directory);
+
+	// A blank 800kb disk image is recognised by more than one format, so produces media of several kinds.
+	_disk_name = _directory + "blank.dsk";
+	write(_disk_name, std::vector<uint8_t>(819200));
+}
+
+- (void)tearDown {
+	const std::string command = "rm -rf '" + _directory + "'";
+	std::system(command.c_str());
+}
+
+/// Stores targets with non-default fields and media drawn from all over the parsed file, then checks that
+/// the same targets come back, referring to the corresponding media of a fresh parse.
+- (void)testRoundTrip {
+	using namespace Analyser::Static;
+
+	const Media media = GetMedia(_disk_name);
+	XCTAssertFalse(media.disks.empty());
+
+	const TargetList targets = make_targets(media);
+
+	const std::string key = _cache.key(_disk_name);
+	XCTAssertFalse(key.empty());
+	_cache.put(key, targets, media);
+
+	const Media fresh_media = GetMedia(_disk_name);
+	TargetList loaded;
+	XCTAssertTrue(_cache.get(key, fresh_media, loaded));
+	XCTAssertEqual(loaded.size(), targets.size());
+	if(loaded.size() != targets.size()) return;
+
+	for(size_t c = 0; c < targets.size(); ++c) {
+		XCTAssert(loaded[c]->machine == targets[c]->machine);
+		XCTAssertEqual(loaded[c]->confidence, targets[c]->confidence);
+
+		XCTAssertEqual(loaded[c]->media.disks.size(), targets[c]->media.disks.size());
+		for(size_t d = 0; d < std::min(loaded[c]->media.disks.size(), targets[c]->media.disks.size()); ++d) {
+			XCTAssertEqual(index_of(fresh_media.disks, loaded[c]->media.disks[d]), index_of(media.disks, targets[c]->media.disks[d]));
+		}
+		XCTAssert(loaded[c]->media.tapes.empty());
+		XCTAssert(loaded[c]->media.cartridges.empty());
+		XCTAssert(loaded[c]->media.mass_storage_devices.empty());
+	}
+
+	const auto cpc = dynamic_cast<AmstradCPC::Target *>(loaded[0].get());
+	XCTAssert(cpc);
+	if(cpc) {
+		XCTAssert(cpc->model == AmstradCPC::Target::Model::CPC6128);
+		XCTAssert(cpc->loading_command == "run\"disc\n");
+	}
+
+	const auto vic = dynamic_cast<Commodore::Target *>(loaded[1].get());
+	XCTAssert(vic);
+	if(vic) {
+		XCTAssertFalse(vic->enabled_ram.bank0);
+		XCTAssertTrue(vic->enabled_ram.bank1);
+		XCTAssertFalse(vic->enabled_ram.bank2);
+		XCTAssertFalse(vic->enabled_ram.bank3);
+		XCTAssertTrue(vic->enabled_ram.bank5);
+		XCTAssert(vic->region == Commodore::Target::Region::Japanese);
+		XCTAssertTrue(vic->has_c1540);
+		XCTAssert(vic->loading_command == "LOAD\"\",8,1\nRUN\n");
+	}
+
+	const auto oric = dynamic_cast<Oric::Target *>(loaded[2].get());
+	XCTAssert(oric);
+	if(oric) {
+		XCTAssert(oric->rom == Oric::Target::ROM::Pravetz);
+		XCTAssert(oric->disk_interface == Oric::Target::DiskInterface::Jasmin);
+		XCTAssertTrue(oric->should_start_jasmin);
+		XCTAssert(oric->loading_command.empty());
+	}
+}
+
+/// Checks that the results of a real analysis are cached, and that the cached results match.
+- (void)testAnalysedTargetsRoundTrip {
+	using namespace Analyser::Static;
+	auto &cache = TargetCache::shared();
+	cache.set_directory(_directory);
+
+	const TargetList analysed = GetTargets(_disk_name);
+	XCTAssertFalse(analysed.empty());
+	XCTAssertFalse(contents(_directory + cache.key(_disk_name)).empty());
+
+	const TargetList cached = GetTargets(_disk_name);
+	cache.set_directory("");
+
+	XCTAssertEqual(cached.size(), analysed.size());
+	for(size_t c = 0; c < std::min(cached.size(), analysed.size()); ++c) {
+		XCTAssert(typeid(*cached[c]) == typeid(*analysed[c]));
+		XCTAssert(cached[c]->machine == analysed[c]->machine);
+		XCTAssertEqual(cached[c]->confidence, analysed[c]->confidence);
+		XCTAssertEqual(cached[c]->media.disks.size(), analysed[c]->media.disks.size());
+		XCTAssertEqual(cached[c]->media.tapes.size(), analysed[c]->media.tapes.size());
+		XCTAssertEqual(cached[c]->media.cartridges.size(), analysed[c]->media.cartridges.size());
+		XCTAssertEqual(cached[c]->media.mass_storage_devices.size(), analysed[c]->media.mass_storage_devices.size());
+	}
+}
+
+/// Checks that changes to a file alter its key, and that damaged entries are ignored.
+- (void)testStaleAndDamagedEntries {
+	using namespace Analyser::Static;
+
+	const Media media = GetMedia(_disk_name);
+	const TargetList targets = make_targets(media);
+	const std::string key = _cache.key(_disk_name);
+	_cache.put(key, targets, media);
+
+	// Alter the file; it should now have a different key.
+	std::vector<uint8_t> altered(819200);
+	altered[400] = 1;
+	write(_disk_name, altered);
+	XCTAssert(_cache.key(_disk_name) != key);
+
+	// Truncate the stored entry; it should no longer load.
+	auto entry = contents(_directory + key);
+	XCTAssertFalse(entry.empty());
+	entry.pop_back();
+	write(_directory + key, entry);
+
+	TargetList loaded;
+	XCTAssertFalse(_cache.get(key, media, loaded));
+	XCTAssert(loaded.empty());
+
+	// An entry referring to media that the file no longer contains should also be rejected.
+	_cache.put(key, targets, media);
+	XCTAssertTrue(_cache.get(key, media, loaded));
+	loaded.clear();
+	XCTAssertFalse(_cache.get(key, Media(), loaded));
+	XCTAssert(loaded.empty());
+}
+
+@end
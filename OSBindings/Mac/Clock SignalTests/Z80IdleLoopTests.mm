@@ -0,0 +1,224 @@
+//
+//  Z80IdleLoopTests.mm
+//  Clock SignalTests
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <random>
+#include <vector>
+
+#include "../../../Processors/Z80/Z80.hpp"
+
+namespace {
+
+/*!
+	Runs a program at 0x0000 that polls memory; at @c change_time the byte at 0x8000 is set, which the program
+	is waiting for. The program signals completion by fetching an opcode from 0x0100.
+
+	If idle-loop skipping is enabled then this bus handler skips as many iterations as it can while remaining
+	strictly before @c change_time, as a machine would with respect to its next scheduled event.
+*/
+class PollingMachine: public CPU::Z80::BusHandler {
+	public:
+		PollingMachine(const std::vector<uint8_t> &program, bool skips_idle_loops, int64_t change_time) :
+			z80_(*this), memory_(65536), change_time_(change_time) {
+			std::copy(program.begin(), program.end(), memory_.begin());
+			memory_[0x0100] = 0x76;	// HALT
+
+			z80_.reset_power_on();
+			for(const auto reg: {
+				CPU::Z80::Register::AF,	CPU::Z80::Register::BC,	CPU::Z80::Register::DE,	CPU::Z80::Register::HL,
+				CPU::Z80::Register::IX,	CPU::Z80::Register::IY,	CPU::Z80::Register::StackPointer,
+				CPU::Z80::Register::MemPtr,	CPU::Z80::Register::ProgramCounter,
+			}) {
+				z80_.set_value_of_register(reg, 0);
+			}
+			z80_.set_idle_loop_detection_enabled(skips_idle_loops);
+		}
+
+		HalfCycles perform_machine_cycle(const CPU::Z80::PartialMachineCycle &cycle) {
+			time_ += cycle.length.as_integral();
+			if(time_ >= change_time_) memory_[0x8000] = 0x01;
+
+			if(!cycle.is_terminal()) {
+				return HalfCycles(0);
+			}
+
+			const uint16_t address = cycle.address ? *cycle.address : 0x0000;
+			switch(cycle.operation) {
+				case CPU::Z80::PartialMachineCycle::ReadOpcode:
+					if(address == 0x0100 && completion_time_ < 0) {
+						completion_time_ = time_;
+					}
+				case CPU::Z80::PartialMachineCycle::Read:
+					*cycle.value = memory_[address];
+				break;
+
+				case CPU::Z80::PartialMachineCycle::Write:
+					memory_[address] = *cycle.value;
+				break;
+
+				default: break;
+			}
+
+			return HalfCycles(0);
+		}
+
+		HalfCycles skip_idle_loop(HalfCycles iteration_length, HalfCycles available) {
+			++skip_offers_;
+
+			const int64_t limit = std::min(available.as_integral(), change_time_ - time_);
+			if(limit <= 1) return HalfCycles(0);
+
+			const int64_t skipped = ((limit - 1) / iteration_length.as_integral()) * iteration_length.as_integral();
+			time_ += skipped;
+			skipped_time_ += skipped;
+			return HalfCycles(skipped);
+		}
+
+		void run_for(Cycles cycles) {
+			z80_.run_for(cycles);
+		}
+
+		uint16_t get_value_of_register(CPU::Z80::Register r) {
+			return z80_.get_value_of_register(r);
+		}
+
+		int64_t time() const				{	return time_;				}
+		int64_t completion_time() const		{	return completion_time_;	}
+		int64_t skipped_time() const		{	return skipped_time_;		}
+		int skip_offers() const				{	return skip_offers_;		}
+
+	private:
+		CPU::Z80::Processor<PollingMachine, false, false> z80_;
+		std::vector<uint8_t> memory_;
+		const int64_t change_time_;
+
+		int64_t time_ = 0;
+		int64_t completion_time_ = -1;
+		int64_t skipped_time_ = 0;
+		int skip_offers_ = 0;
+};
+
+}
+
+@interface Z80IdleLoopTests : XCTestCase
+@end
+
+@implementation Z80IdleLoopTests
+
+/*!
+	Runs @c program with and without idle-loop skipping, in runs of random lengths, and checks that both
+	reach 0x0100 at the same time and in the same state.
+
+	@returns The amount of time that was skipped.
+*/
+- (int64_t)skippedTimeForProgram:(const std::vector<uint8_t> &)program {
+	const int64_t change_time = 1'000'003;
+	PollingMachine cycle_by_cycle(program, false, change_time);
+	PollingMachine skipping(program, true, change_time);
+
+	std::mt19937 random;
+	while(cycle_by_cycle.completion_time() < 0 || skipping.completion_time() < 0) {
+		const Cycles length = Cycles(1 + int(random() % 5000));
+		cycle_by_cycle.run_for(length);
+		skipping.run_for(length);
+		XCTAssertEqual(cycle_by_cycle.time(), skipping.time());
+		if(cycle_by_cycle.time() > 4 * change_time) break;
+	}
+
+	XCTAssertGreaterThanOrEqual(cycle_by_cycle.completion_time(), change_time);
+	XCTAssertEqual(cycle_by_cycle.completion_time(), skipping.completion_time());
+	for(const auto reg: {
+		CPU::Z80::Register::ProgramCounter,	CPU::Z80::Register::StackPointer,
+		CPU::Z80::Register::AF,	CPU::Z80::Register::BC,	CPU::Z80::Register::DE,	CPU::Z80::Register::HL,
+		CPU::Z80::Register::MemPtr,
+	}) {
+		XCTAssertEqual(cycle_by_cycle.get_value_of_register(reg), skipping.get_value_of_register(reg));
+	}
+
+	XCTAssertEqual(cycle_by_cycle.skip_offers(), 0);
+	return skipping.skipped_time();
+}
+
+- (void)testPollingLoopIsSkipped {
+	const std::vector<uint8_t> program = {
+		0x3a, 0x00, 0x80,	// loop: LD A, (8000h)
+		0xb7,				// OR A
+		0x28, 0xfa,			// JR Z, loop
+		0xc3, 0x00, 0x01,	// JP 0100h
+	};
+	const int64_t skipped = [self skippedTimeForProgram:program];
+	XCTAssertGreaterThan(skipped, int64_t(900'000));
+}
+
+- (void)testCountingLoopIsNotSkipped {
+	// The loop's state changes every iteration, so it isn't idle.
+	const std::vector<uint8_t> program = {
+		0x23,				// loop: INC HL
+		0x3a, 0x00, 0x80,	// LD A, (8000h)
+		0xb7,				// OR A
+		0x28, 0xf9,			// JR Z, loop
+		0xc3, 0x00, 0x01,	// JP 0100h
+	};
+	XCTAssertEqual([self skippedTimeForProgram:program], int64_t(0));
+}
+
+- (void)testRepeatedWritesAreSkipped {
+	// The loop writes the same value to the same address every iteration, so it is still idle.
+	const std::vector<uint8_t> program = {
+		0x32, 0x00, 0x90,	// loop: LD (9000h), A
+		0x3a, 0x00, 0x80,	// LD A, (8000h)
+		0xb7,				// OR A
+		0x28, 0xf7,			// JR Z, loop
+		0xc3, 0x00, 0x01,	// JP 0100h
+	};
+	const int64_t skipped = [self skippedTimeForProgram:program];
+	XCTAssertGreaterThan(skipped, int64_t(900'000));
+}
+
+- (void)testSubroutineLoopIsSkipped {
+	// Each CALL pushes the same return address to the same place on the stack.
+	const std::vector<uint8_t> program = {
+		0x31, 0x00, 0xf0,	// LD SP, F000h
+		0xcd, 0x10, 0x00,	// loop: CALL 0010h
+		0xb7,				// OR A
+		0x28, 0xfa,			// JR Z, loop
+		0xc3, 0x00, 0x01,	// JP 0100h
+		0x00, 0x00, 0x00, 0x00,
+		0x3a, 0x00, 0x80,	// 0010h: LD A, (8000h)
+		0xc9,				// RET
+	};
+	const int64_t skipped = [self skippedTimeForProgram:program];
+	XCTAssertGreaterThan(skipped, int64_t(900'000));
+}
+
+- (void)testChangingWritesAreNotSkipped {
+	// The registers are the same at the end of every iteration, but the value written differs.
+	const std::vector<uint8_t> program = {
+		0x21, 0x00, 0x90,	// LD HL, 9000h
+		0x34,				// loop: INC (HL)
+		0x3a, 0x00, 0x80,	// LD A, (8000h)
+		0xb7,				// OR A
+		0x28, 0xf9,			// JR Z, loop
+		0xc3, 0x00, 0x01,	// JP 0100h
+	};
+	XCTAssertEqual([self skippedTimeForProgram:program], int64_t(0));
+}
+
+- (void)testOutputtingLoopIsNotSkipped {
+	const std::vector<uint8_t> program = {
+		0xd3, 0x00,			// loop: OUT (00h), A
+		0x3a, 0x00, 0x80,	// LD A, (8000h)
+		0xb7,				// OR A
+		0x28, 0xf8,			// JR Z, loop
+		0xc3, 0x00, 0x01,	// JP 0100h
+	};
+	XCTAssertEqual([self skippedTimeForProgram:program], int64_t(0));
+}
+
+@end
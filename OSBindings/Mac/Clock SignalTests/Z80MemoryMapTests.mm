@@ -0,0 +1,257 @@
+//
+//  Z80MemoryMapTests.mm
+//  Clock SignalTests
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../../Processors/Z80/Z80.hpp"
+
+namespace {
+
+/*!
+	Runs a CP/M program at 0x100 on a Z80 that does or does not use a memory map; the map covers everything
+	other than the first 256 bytes, which hold the BDOS entry point.
+
+	The bus handler can also assert the wait line in the same pattern as an Amstrad CPC and/or periodically
+	toggle the interrupt line, dating each change as any machine that uses a memory map must.
+*/
+template <bool uses_memory_map> class CPMMachine: public CPU::Z80::BusHandler {
+	public:
+		CPMMachine(const std::vector<uint8_t> &program, bool uses_wait_line, bool uses_interrupts) :
+			z80_(*this), memory_(65536), uses_wait_line_(uses_wait_line), uses_interrupts_(uses_interrupts) {
+			std::copy(program.begin(), program.end(), memory_.begin() + 0x100);
+
+			// Place a RET at the BDOS entry point and point the top-of-memory vector at the top of memory.
+			memory_[0x0005] = 0xc9;
+			memory_[0x0006] = 0xff;
+			memory_[0x0007] = 0xff;
+
+			// Install an interrupt handler that just re-enables interrupts and returns.
+			memory_[0x0038] = 0xfb;
+			memory_[0x0039] = 0xc9;
+
+			for(size_t c = 0; c < 256; ++c) {
+				read_pages_[c] = write_pages_[c] = c ? &memory_[c << 8] : nullptr;
+			}
+			z80_.set_memory_map(read_pages_, write_pages_, 8);
+
+			// Registers are otherwise undefined at power on, so give every instance the same starting state.
+			z80_.reset_power_on();
+			for(const auto reg: {
+				CPU::Z80::Register::AF,	CPU::Z80::Register::BC,	CPU::Z80::Register::DE,	CPU::Z80::Register::HL,
+				CPU::Z80::Register::AFDash,	CPU::Z80::Register::BCDash,	CPU::Z80::Register::DEDash,	CPU::Z80::Register::HLDash,
+				CPU::Z80::Register::IX,	CPU::Z80::Register::IY,	CPU::Z80::Register::StackPointer,
+				CPU::Z80::Register::I,	CPU::Z80::Register::Refresh,	CPU::Z80::Register::MemPtr,
+			}) {
+				z80_.set_value_of_register(reg, 0);
+			}
+			z80_.set_value_of_register(CPU::Z80::Register::ProgramCounter, 0x100);
+			if(uses_interrupts) {
+				z80_.set_value_of_register(CPU::Z80::Register::IM, 1);
+				z80_.set_value_of_register(CPU::Z80::Register::IFF1, 1);
+				z80_.set_value_of_register(CPU::Z80::Register::IFF2, 1);
+			}
+		}
+
+		HalfCycles perform_machine_cycle(const CPU::Z80::PartialMachineCycle &cycle) {
+			const int64_t start_time = time_;
+			time_ += cycle.length.as_integral();
+
+			if(uses_wait_line_) {
+				z80_.set_wait_line((time_ & 7) >= 2);
+			}
+
+			// Raise the interrupt line for 200 half-cycles in every 10007, dating each change.
+			if(uses_interrupts_) {
+				const int64_t period = 10007, duration = 200;
+				int64_t edge = (start_time / period) * period;
+				while(edge <= time_) {
+					if(edge > start_time) z80_.set_interrupt_line(true, HalfCycles(edge - time_));
+					if(edge + duration > start_time && edge + duration <= time_) z80_.set_interrupt_line(false, HalfCycles(edge + duration - time_));
+					edge += period;
+				}
+			}
+
+			if(!cycle.is_terminal()) {
+				return HalfCycles(0);
+			}
+
+			const uint16_t address = cycle.address ? *cycle.address : 0x0000;
+			switch(cycle.operation) {
+				case CPU::Z80::PartialMachineCycle::ReadOpcode:
+					if(address == 0x0005) {
+						perform_bdos_call();
+					}
+					if(address == 0x0000) {
+						is_finished_ = true;
+					}
+				case CPU::Z80::PartialMachineCycle::Read:
+					*cycle.value = memory_[address];
+				break;
+
+				case CPU::Z80::PartialMachineCycle::Write:
+					memory_[address] = *cycle.value;
+				break;
+
+				case CPU::Z80::PartialMachineCycle::Input:
+				case CPU::Z80::PartialMachineCycle::Interrupt:
+					*cycle.value = 0xff;
+				break;
+
+				default: break;
+			}
+
+			return HalfCycles(0);
+		}
+
+		void run_for(Cycles cycles) {
+			z80_.run_for(cycles);
+		}
+
+		uint16_t get_value_of_register(CPU::Z80::Register r) {
+			return z80_.get_value_of_register(r);
+		}
+
+		int64_t time() const {
+			return time_;
+		}
+
+		const std::vector<uint8_t> &memory() const {
+			return memory_;
+		}
+
+		const std::string &output() const {
+			return output_;
+		}
+
+		bool is_finished() const {
+			return is_finished_;
+		}
+
+	private:
+		void perform_bdos_call() {
+			switch(z80_.get_value_of_register(CPU::Z80::Register::C)) {
+				case 0:
+					is_finished_ = true;
+				break;
+
+				case 2:
+					output_.push_back(char(z80_.get_value_of_register(CPU::Z80::Register::E)));
+				break;
+
+				case 9: {
+					uint16_t address = z80_.get_value_of_register(CPU::Z80::Register::DE);
+					while(memory_[address] != '$') {
+						output_.push_back(char(memory_[address]));
+						++address;
+					}
+				} break;
+
+				default: break;
+			}
+		}
+
+		CPU::Z80::Processor<CPMMachine, false, true, uses_memory_map> z80_;
+		std::vector<uint8_t> memory_;
+		const uint8_t *read_pages_[256];
+		uint8_t *write_pages_[256];
+
+		const bool uses_wait_line_;
+		const bool uses_interrupts_;
+		int64_t time_ = 0;
+
+		std::string output_;
+		bool is_finished_ = false;
+};
+
+}
+
+@interface Z80MemoryMapTests : XCTestCase
+@end
+
+@implementation Z80MemoryMapTests {
+	std::vector<uint8_t> _zexdoc;
+}
+
+- (void)setUp {
+	NSString *const path = [[NSBundle bundleForClass:[self class]] pathForResource:@"zexdoc" ofType:@"com"];
+	NSData *const data = [NSData dataWithContentsOfFile:path];
+	XCTAssertNotNil(data, @"zexdoc is required");
+
+	_zexdoc.resize(data.length);
+	memcpy(_zexdoc.data(), data.bytes, data.length);
+}
+
+/*!
+	Runs the opening of zexdoc on a Z80 that uses a memory map in lockstep with one that doesn't, in runs of
+	random lengths, and checks that the two are in the same state after every run.
+*/
+- (void)runLockstepWithWaitLine:(BOOL)uses_wait_line interrupts:(BOOL)uses_interrupts {
+	CPMMachine<false> cycle_by_cycle(_zexdoc, uses_wait_line, uses_interrupts);
+	CPMMachine<true> memory_mapped(_zexdoc, uses_wait_line, uses_interrupts);
+
+	const CPU::Z80::Register registers[] = {
+		CPU::Z80::Register::ProgramCounter,	CPU::Z80::Register::StackPointer,
+		CPU::Z80::Register::AF,	CPU::Z80::Register::BC,	CPU::Z80::Register::DE,	CPU::Z80::Register::HL,
+		CPU::Z80::Register::IX,	CPU::Z80::Register::IY,	CPU::Z80::Register::MemPtr,
+		CPU::Z80::Register::IFF1,
+	};
+
+	std::mt19937 random;
+	int64_t total = 0;
+	while(total < 10'000'000 && !cycle_by_cycle.is_finished()) {
+		const int length = 1 + int(random() % 400);
+		cycle_by_cycle.run_for(Cycles(length));
+		memory_mapped.run_for(Cycles(length));
+		total += length;
+
+		for(const auto reg: registers) {
+			if(cycle_by_cycle.get_value_of_register(reg) != memory_mapped.get_value_of_register(reg)) {
+				XCTFail(@"Register %d differs at time %lld: %04x versus %04x",
+					int(reg),
+					static_cast<long long>(cycle_by_cycle.time()),
+					cycle_by_cycle.get_value_of_register(reg),
+					memory_mapped.get_value_of_register(reg));
+				return;
+			}
+		}
+		if(cycle_by_cycle.time() != memory_mapped.time()) {
+			XCTFail(@"Times differ: %lld versus %lld", static_cast<long long>(cycle_by_cycle.time()), static_cast<long long>(memory_mapped.time()));
+			return;
+		}
+		if(!(random() % 256) && cycle_by_cycle.memory() != memory_mapped.memory()) {
+			XCTFail(@"Memory differs at time %lld", static_cast<long long>(cycle_by_cycle.time()));
+			return;
+		}
+	}
+
+	XCTAssertTrue(cycle_by_cycle.output() == memory_mapped.output(), @"Output differs");
+	XCTAssertFalse(cycle_by_cycle.output().empty(), @"zexdoc produced no output");
+}
+
+- (void)testLockstep {
+	[self runLockstepWithWaitLine:NO interrupts:NO];
+}
+
+- (void)testLockstepWithWaitLine {
+	[self runLockstepWithWaitLine:YES interrupts:NO];
+}
+
+- (void)testLockstepWithInterrupts {
+	[self runLockstepWithWaitLine:NO interrupts:YES];
+}
+
+- (void)testLockstepWithWaitLineAndInterrupts {
+	[self runLockstepWithWaitLine:YES interrupts:YES];
+}
+
+@end
@@ -13,13 +13,16 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <sys/stat.h>
 #include <unistd.h>
 
 #include <SDL2/SDL.h>
 
 #include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../Analyser/Static/TargetCache.hpp"
 #include "../../Machines/Utility/MachineForTarget.hpp"
+#include "../../Machines/Utility/ROMStore.hpp"
 
 #include "../../Machines/MediaTarget.hpp"
 #include "../../Machines/CRTMachine.hpp"
@@ -27,6 +30,8 @@
 #include "../../Concurrency/BestEffortUpdater.hpp"
 
 #include "../../Activity/Observer.hpp"
+#include "../../Outputs/Capture/FrameHasher.hpp"
+#include "../../Outputs/Capture/Recorder.hpp"
 #include "../../Outputs/OpenGL/Primitives/Rectangle.hpp"
 #include "../../Outputs/OpenGL/ScanTarget.hpp"
 #include "../../Outputs/OpenGL/Screenshot.hpp"
@@ -35,10 +40,13 @@ namespace {
 
 struct BestEffortUpdaterDelegate: public Concurrency::BestEffortUpdater::Delegate {
 	Time::Seconds update(Concurrency::BestEffortUpdater *updater, Time::Seconds duration, bool did_skip_previous_update, int flags) override {
-		return machine->crt_machine()->run_until(duration, flags);
+		const Time::Seconds run_time = machine->crt_machine()->run_until(duration, flags);
+		if(recorder) recorder->add_time(run_time);
+		return run_time;
 	}
 
 	Machine::DynamicMachine *machine;
+	Outputs::Capture::Recorder *recorder = nullptr;
 };
 
 struct SpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
@@ -301,6 +309,92 @@ std::string system_get(const char *command) {
 	return result;
 }
 
+/*!
+	Applies user-friendly defaults to @c machine, overridden by any selections in @c arguments.
+*/
+void apply_selections(Machine::DynamicMachine &machine, ParsedArguments &arguments) {
+	Configurable::Device *const configurable_device = machine.configurable_device();
+	if(configurable_device) {
+		// Establish user-friendly options by default.
+		configurable_device->set_selections(configurable_device->get_user_friendly_selections());
+
+		// Consider transcoding any list selections that map to Boolean options.
+		for(const auto &option: configurable_device->get_options()) {
+			// Check for a corresponding selection.
+			auto selection = arguments.selections.find(option->short_name);
+			if(selection != arguments.selections.end()) {
+				// Transcode selection if necessary.
+				if(dynamic_cast<Configurable::BooleanOption *>(option.get())) {
+					arguments.selections[selection->first] =  std::unique_ptr<Configurable::Selection>(selection->second->boolean_selection());
+				}
+
+				if(dynamic_cast<Configurable::ListOption *>(option.get())) {
+					arguments.selections[selection->first] =  std::unique_ptr<Configurable::Selection>(selection->second->list_selection());
+				}
+			}
+		}
+
+		// Apply the user's actual selections to override the defaults.
+		configurable_device->set_selections(arguments.selections);
+	}
+}
+
+/*!
+	Runs @c machine without any window or audio device, as quickly as possible, until @c frames frames
+	have been output, passing video and audio to @c recorder and video to @c hasher; either may be
+	@c nullptr. If there is a hasher then the hash of every frame is printed at the end.
+
+	Gives up if the machine fails to output those frames within a generous amount of emulated time.
+*/
+int run_headless(Machine::DynamicMachine &machine, ParsedArguments &arguments, Outputs::Capture::Recorder *recorder, Outputs::Capture::FrameHasher *hasher, int frames) {
+	constexpr int audio_sample_rate = 48000;
+
+	const auto crt_machine = machine.crt_machine();
+	if(hasher) {
+		hasher->set_scan_target(recorder);
+		crt_machine->set_scan_target(hasher);
+	} else {
+		crt_machine->set_scan_target(recorder);
+	}
+
+	auto speaker = crt_machine->get_speaker();
+	if(speaker && recorder) {
+		speaker->set_output_rate(audio_sample_rate, 1024);
+		speaker->set_delegate(recorder);
+		recorder->set_audio_sample_rate(audio_sample_rate);
+	}
+
+	apply_selections(machine, arguments);
+
+	const auto frames_output = [&] {
+		return hasher ? int(hasher->frame_hashes().size()) : recorder->frames_recorded();
+	};
+
+	// Allow a tenth of a second of emulated time per frame, far longer than any machine takes, or ten seconds if that's longer.
+	constexpr Time::Seconds step = 0.01;
+	const Time::Seconds time_limit = std::max(10.0, double(frames) * 0.1);
+	Time::Seconds time_run = 0.0;
+	while(frames_output() < frames) {
+		if(time_run >= time_limit) {
+			std::cerr << "Only " << frames_output() << " of " << frames << " frames were output within " << time_limit << " seconds of emulated time" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		crt_machine->run_for(step);
+		if(recorder) recorder->add_time(step);
+		time_run += step;
+	}
+
+	if(hasher) {
+		const auto &hashes = hasher->frame_hashes();
+		for(int frame = 0; frame < frames; ++frame) {
+			printf("%d: %016llx\n", frame, static_cast<unsigned long long>(hashes[size_t(frame)]));
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
 /*!
 	Maintains a communicative window title.
 */
@@ -342,6 +436,9 @@ int main(int argc, char *argv[]) {
 	if(arguments.selections.find("help") != arguments.selections.end() || arguments.selections.find("h") != arguments.selections.end()) {
 		std::cout << "Usage: " << final_path_component(argv[0]) << usage_suffix << std::endl;
 		std::cout << "Use alt+enter to toggle full screen display. Use control+shift+V to paste text." << std::endl;
+		std::cout << "Use --record={path} to record video and audio to {path}.y4m and {path}.wav. Add --headless to record without a window, as quickly as possible, until --frames={count} frames have been recorded." << std::endl;
+		std::cout << "Use --analysiscache={path} to store the results of file analysis in {path}, so that files need be analysed only once." << std::endl;
+		std::cout << "Use --headless --hash to run without a window until --frames={count} frames have been output, then print a hash of each frame; this may be combined with --record." << std::endl;
 		std::cout << "Required machine type and configuration is determined from the file. Machines with further options:" << std::endl << std::endl;
 
 		auto all_options = Machine::AllOptionsByMachineName();
@@ -375,7 +472,16 @@ int main(int argc, char *argv[]) {
 		return EXIT_FAILURE;
 	}
 
-	// Determine the machine for the supplied file.
+	// Determine the machine for the supplied file, via the analysis cache if one has been nominated.
+	if(arguments.selections.find("analysiscache") != arguments.selections.end()) {
+		std::string cache_path = arguments.selections["analysiscache"]->list_selection()->value;
+		if(cache_path.empty()) {
+			std::cerr << "--analysiscache requires a path" << std::endl;
+			return EXIT_FAILURE;
+		}
+		if(cache_path.back() != '/') cache_path += "/";
+		Analyser::Static::TargetCache::shared().set_directory(cache_path);
+	}
 	const auto targets = Analyser::Static::GetTargets(arguments.file_name);
 	if(targets.empty()) {
 		std::cerr << "Cannot open " << arguments.file_name << "; no target machine found" << std::endl;
@@ -386,58 +492,51 @@ int main(int argc, char *argv[]) {
 	BestEffortUpdaterDelegate best_effort_updater_delegate;
 	SpeakerDelegate speaker_delegate;
 
+	// Create a recorder and a frame hasher if requested. These are created before the machine so that they will outlive it.
+	std::unique_ptr<Outputs::Capture::Recorder> recorder;
+	if(arguments.selections.find("record") != arguments.selections.end()) {
+		const std::string path = arguments.selections["record"]->list_selection()->value;
+		recorder = std::make_unique<Outputs::Capture::Recorder>(path);
+		if(!recorder->is_open()) {
+			std::cerr << "Could not open " << path << ".y4m and " << path << ".wav for writing" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	std::unique_ptr<Outputs::Capture::FrameHasher> hasher;
+	if(arguments.selections.find("hash") != arguments.selections.end()) {
+		// Hashes are printed only by the headless loop, which runs for a known number of frames.
+		if(arguments.selections.find("headless") == arguments.selections.end()) {
+			std::cerr << "--hash requires --headless" << std::endl;
+			return EXIT_FAILURE;
+		}
+		hasher = std::make_unique<Outputs::Capture::FrameHasher>();
+	}
+
 	// For vanilla SDL purposes, assume system ROMs can be found in one of:
 	//
 	//	/usr/local/share/CLK/[system];
 	//	/usr/share/CLK/[system]; or
 	//	[user-supplied path]/[system]
+	std::vector<std::string> rom_paths = {
+		"/usr/local/share/CLK/",
+		"/usr/share/CLK/"
+	};
+	if(arguments.selections.find("rompath") != arguments.selections.end()) {
+		std::string user_path = arguments.selections["rompath"]->list_selection()->value;
+		if(user_path.back() != '/') {
+			rom_paths.push_back(user_path + "/");
+		} else {
+			rom_paths.push_back(user_path);
+		}
+	}
+	ROMMachine::Store::shared().set_search_paths(rom_paths);
+
 	std::vector<ROMMachine::ROM> requested_roms;
-	ROMMachine::ROMFetcher rom_fetcher = [&requested_roms, &arguments]
+	const ROMMachine::ROMFetcher store_fetcher = ROMMachine::Store::shared().fetcher();
+	ROMMachine::ROMFetcher rom_fetcher = [&requested_roms, &store_fetcher]
 		(const std::vector<ROMMachine::ROM> &roms) -> std::vector<std::unique_ptr<std::vector<uint8_t>>> {
 			requested_roms.insert(requested_roms.end(), roms.begin(), roms.end());
-
-			std::vector<std::string> paths = {
-				"/usr/local/share/CLK/",
-				"/usr/share/CLK/"
-			};
-			if(arguments.selections.find("rompath") != arguments.selections.end()) {
-				std::string user_path = arguments.selections["rompath"]->list_selection()->value;
-				if(user_path.back() != '/') {
-					paths.push_back(user_path + "/");
-				} else {
-					paths.push_back(user_path);
-				}
-			}
-
-			std::vector<std::unique_ptr<std::vector<uint8_t>>> results;
-			for(const auto &rom: roms) {
-				FILE *file = nullptr;
-				for(const auto &path: paths) {
-					std::string local_path = path + rom.machine_name + "/" + rom.file_name;
-					file = std::fopen(local_path.c_str(), "rb");
-					if(file) break;
-				}
-
-				if(!file) {
-					results.emplace_back(nullptr);
-					continue;
-				}
-
-				auto data = std::make_unique<std::vector<uint8_t>>();
-
-				std::fseek(file, 0, SEEK_END);
-				data->resize(std::ftell(file));
-				std::fseek(file, 0, SEEK_SET);
-				std::size_t read = fread(data->data(), 1, data->size(), file);
-				std::fclose(file);
-
-				if(read == data->size())
-					results.emplace_back(std::move(data));
-				else
-					results.emplace_back(nullptr);
-			}
-
-			return results;
+			return store_fetcher(roms);
 		};
 
 	// Create and configure a machine.
@@ -462,7 +561,36 @@ int main(int argc, char *argv[]) {
 		return EXIT_FAILURE;
 	}
 
+	// Use whatever ROMs were found, but point out any that aren't known copies; a bad dump or
+	// a mislabelled file is otherwise indistinguishable from an emulation fault.
+	std::set<std::pair<std::string, std::string>> checked_roms;
+	for(const auto &rom: requested_roms) {
+		if(!checked_roms.insert(std::make_pair(rom.machine_name, rom.file_name)).second) continue;
+		if(ROMMachine::Store::shared().is_present(rom) && !ROMMachine::Store::shared().is_known_image(rom)) {
+			std::cerr << "Warning: " << rom.machine_name << '/' << rom.file_name;
+			if(!rom.descriptive_name.empty()) {
+				std::cerr << " (" << rom.descriptive_name << ")";
+			}
+			std::cerr << " doesn't match any known copy; using it anyway." << std::endl;
+		}
+	}
+
+	// If running headless, hand straight over to the headless loop.
+	if(arguments.selections.find("headless") != arguments.selections.end()) {
+		if(!recorder && !hasher) {
+			std::cerr << "--headless requires --record or --hash" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		int frames = 500;
+		if(arguments.selections.find("frames") != arguments.selections.end()) {
+			frames = std::atoi(arguments.selections["frames"]->list_selection()->value.c_str());
+		}
+		return run_headless(*machine, arguments, recorder.get(), hasher.get(), frames);
+	}
+
 	best_effort_updater_delegate.machine = machine.get();
+	best_effort_updater_delegate.recorder = recorder.get();
 	speaker_delegate.updater = &updater;
 	updater.set_delegate(&best_effort_updater_delegate);
 
@@ -503,7 +631,12 @@ int main(int argc, char *argv[]) {
 
 	// Setup output, assuming a CRT machine for now, and prepare a best-effort updater.
 	Outputs::Display::OpenGL::ScanTarget scan_target(target_framebuffer);
-	machine->crt_machine()->set_scan_target(&scan_target);
+	if(recorder) {
+		recorder->set_scan_target(&scan_target);
+		machine->crt_machine()->set_scan_target(recorder.get());
+	} else {
+		machine->crt_machine()->set_scan_target(&scan_target);
+	}
 
 	// For now, lie about audio output intentions.
 	auto speaker = machine->crt_machine()->get_speaker();
@@ -523,37 +656,20 @@ int main(int argc, char *argv[]) {
 		speaker_delegate.audio_device = SDL_OpenAudioDevice(nullptr, 0, &desired_audio_spec, &obtained_audio_spec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
 
 		speaker->set_output_rate(obtained_audio_spec.freq, desired_audio_spec.samples);
-		speaker->set_delegate(&speaker_delegate);
+		if(recorder) {
+			recorder->set_speaker_delegate(&speaker_delegate);
+			recorder->set_audio_sample_rate(obtained_audio_spec.freq);
+			speaker->set_delegate(recorder.get());
+		} else {
+			speaker->set_delegate(&speaker_delegate);
+		}
 		SDL_PauseAudioDevice(speaker_delegate.audio_device, 0);
 	}
 
 	int window_width, window_height;
 	SDL_GetWindowSize(window, &window_width, &window_height);
 
-	Configurable::Device *const configurable_device = machine->configurable_device();
-	if(configurable_device) {
-		// Establish user-friendly options by default.
-		configurable_device->set_selections(configurable_device->get_user_friendly_selections());
-
-		// Consider transcoding any list selections that map to Boolean options.
-		for(const auto &option: configurable_device->get_options()) {
-			// Check for a corresponding selection.
-			auto selection = arguments.selections.find(option->short_name);
-			if(selection != arguments.selections.end()) {
-				// Transcode selection if necessary.
-				if(dynamic_cast<Configurable::BooleanOption *>(option.get())) {
-					arguments.selections[selection->first] =  std::unique_ptr<Configurable::Selection>(selection->second->boolean_selection());
-				}
-
-				if(dynamic_cast<Configurable::ListOption *>(option.get())) {
-					arguments.selections[selection->first] =  std::unique_ptr<Configurable::Selection>(selection->second->list_selection());
-				}
-			}
-		}
-
-		// Apply the user's actual selections to override the defaults.
-		configurable_device->set_selections(arguments.selections);
-	}
+	apply_selections(*machine, arguments);
 
 	// If this is a joystick machine, check for and open attached joysticks.
 	/*!
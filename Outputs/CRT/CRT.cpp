@@ -10,12 +10,14 @@
 
 #include <cstdarg>
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 #include <cassert>
 
 using namespace Outputs::CRT;
 
 void CRT::set_new_timing(int cycles_per_line, int height_of_display, Outputs::Display::ColourSpace colour_space, int colour_cycle_numerator, int colour_cycle_denominator, int vertical_sync_half_lines, bool should_alternate) {
+	flush_level();
 
 	constexpr int millisecondsHorizontalRetraceTime = 7;	// Source: Dictionary of Video and Television Technology, p. 234.
 	constexpr int scanlinesVerticalRetraceTime = 8;			// Source: ibid.
@@ -68,42 +70,50 @@ void CRT::set_new_timing(int cycles_per_line, int height_of_display, Outputs::Di
 }
 
 void CRT::set_scan_target(Outputs::Display::ScanTarget *scan_target) {
+	flush_level();
 	scan_target_ = scan_target;
 	if(!scan_target_) scan_target_ = &Outputs::Display::NullScanTarget::singleton;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_new_data_type(Outputs::Display::InputDataType data_type) {
+	flush_level();
 	scan_target_modals_.input_data_type = data_type;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_aspect_ratio(float aspect_ratio) {
+	flush_level();
 	scan_target_modals_.aspect_ratio = aspect_ratio;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_visible_area(Outputs::Display::Rect visible_area) {
+	flush_level();
 	scan_target_modals_.visible_area = visible_area;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_display_type(Outputs::Display::DisplayType display_type) {
+	flush_level();
 	scan_target_modals_.display_type = display_type;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_phase_linked_luminance_offset(float offset) {
+	flush_level();
 	scan_target_modals_.input_data_tweaks.phase_linked_luminance_offset = offset;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_input_data_type(Outputs::Display::InputDataType input_data_type) {
+	flush_level();
 	scan_target_modals_.input_data_type = input_data_type;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_brightness(float brightness) {
+	flush_level();
 	scan_target_modals_.brightness = brightness;
 	scan_target_->set_modals(scan_target_modals_);
 }
@@ -123,6 +133,7 @@ void CRT::set_new_display_type(int cycles_per_line, Outputs::Display::Type displ
 }
 
 void CRT::set_composite_function_type(CompositeSourceType type, float offset_of_first_sample) {
+	flush_level();
 	if(type == DiscreteFourSamplesPerCycle) {
 		colour_burst_phase_adjustment_ = static_cast<uint8_t>(offset_of_first_sample * 256.0f) & 63;
 	} else {
@@ -131,6 +142,7 @@ void CRT::set_composite_function_type(CompositeSourceType type, float offset_of_
 }
 
 void CRT::set_input_gamma(float gamma) {
+	flush_level();
 	scan_target_modals_.intended_gamma = gamma;
 	scan_target_->set_modals(scan_target_modals_);
 }
@@ -364,6 +376,7 @@ void CRT::output_scan(const Scan *const scan) {
 	These all merely channel into advance_cycles, supplying appropriate arguments
 */
 void CRT::output_sync(int number_of_cycles) {
+	flush_level();
 	Scan scan;
 	scan.type = Scan::Type::Sync;
 	scan.number_of_cycles = number_of_cycles;
@@ -371,6 +384,7 @@ void CRT::output_sync(int number_of_cycles) {
 }
 
 void CRT::output_blank(int number_of_cycles) {
+	flush_level();
 	Scan scan;
 	scan.type = Scan::Type::Blank;
 	scan.number_of_cycles = number_of_cycles;
@@ -378,6 +392,30 @@ void CRT::output_blank(int number_of_cycles) {
 }
 
 void CRT::output_level(int number_of_cycles) {
+	if(pending_level_cycles_) {
+		// If no new value has been supplied, or the new value is the same as the pending
+		// one, just extend the pending level.
+		if(
+			!level_scratch_is_vended_ ||
+			!memcmp(level_scratch_, pending_level_data_, Outputs::Display::size_for_data_type(scan_target_modals_.input_data_type))
+		) {
+			level_scratch_is_vended_ = false;
+			pending_level_cycles_ += number_of_cycles;
+			return;
+		}
+
+		// Otherwise output the pending level; this also moves the new value into the scan target.
+		flush_level();
+	}
+
+	// Hold this level back if it was successfully allocated; it may yet be extended.
+	if(allocated_data_) {
+		pending_level_data_ = allocated_data_;
+		pending_level_cycles_ = number_of_cycles;
+		allocated_data_ = nullptr;
+		return;
+	}
+
 	scan_target_->end_data(1);
 	Scan scan;
 	scan.type = Scan::Type::Level;
@@ -386,7 +424,32 @@ void CRT::output_level(int number_of_cycles) {
 	output_scan(&scan);
 }
 
+void CRT::flush_level() {
+	if(!pending_level_cycles_) return;
+
+	Scan scan;
+	scan.type = Scan::Type::Level;
+	scan.number_of_cycles = pending_level_cycles_;
+	scan.number_of_samples = 1;
+	pending_level_cycles_ = 0;
+	pending_level_data_ = nullptr;
+
+	scan_target_->end_data(1);
+	output_scan(&scan);
+
+	// If the scratch area has been vended then the caller has begun a new run of data;
+	// move that into the scan target, exactly as if it had been allocated there.
+	if(level_scratch_is_vended_) {
+		level_scratch_is_vended_ = false;
+		allocated_data_ = scan_target_->begin_data(1);
+		if(allocated_data_) {
+			memcpy(allocated_data_, level_scratch_, Outputs::Display::size_for_data_type(scan_target_modals_.input_data_type));
+		}
+	}
+}
+
 void CRT::output_colour_burst(int number_of_cycles, uint8_t phase, uint8_t amplitude) {
+	flush_level();
 	Scan scan;
 	scan.type = Scan::Type::ColourBurst;
 	scan.number_of_cycles = number_of_cycles;
@@ -401,6 +464,7 @@ void CRT::output_default_colour_burst(int number_of_cycles, uint8_t amplitude) {
 }
 
 void CRT::set_immediate_default_phase(float phase) {
+	flush_level();
 	phase = fmodf(phase, 1.0f);
 	phase_numerator_ = static_cast<int>(phase * static_cast<float>(phase_denominator_));
 }
@@ -410,6 +474,9 @@ void CRT::output_data(int number_of_cycles, size_t number_of_samples) {
 	assert(number_of_samples > 0 && number_of_samples <= allocated_data_length_);
 	allocated_data_length_ = std::numeric_limits<size_t>::min();
 #endif
+	flush_level();
+	allocated_data_ = nullptr;
+
 	scan_target_->end_data(number_of_samples);
 	Scan scan;
 	scan.type = Scan::Type::Data;
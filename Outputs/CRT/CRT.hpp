@@ -88,6 +88,18 @@ class CRT {
 		size_t allocated_data_length_ = std::numeric_limits<size_t>::min();
 #endif
 
+		// Consecutive levels of the same value are merged into a single run before being posted to the scan
+		// target: each level is held back as pending for as long as it might be extended. While a level is
+		// pending, single-sample allocations are vended from level_scratch_ so that they can be compared with
+		// it, and are copied into the scan target only if they turn out to be needed. flush_level posts any
+		// pending level, and moves the scratch area into the scan target if it has been vended.
+		int pending_level_cycles_ = 0;
+		uint8_t *pending_level_data_ = nullptr;
+		uint8_t *allocated_data_ = nullptr;
+		alignas(4) uint8_t level_scratch_[4];
+		bool level_scratch_is_vended_ = false;
+		void flush_level();
+
 	public:
 		/*!	Constructs the CRT with a specified clock rate, height and colour subcarrier frequency.
 			The requested number of buffers, each with the requested number of bytes per pixel,
@@ -169,6 +181,9 @@ class CRT {
 
 		/*!	Outputs the first written to the most-recently created run of data repeatedly for a prolonged period.
 
+			Consecutive levels of the same value are merged, so are posted to the scan target as a single
+			run that uses a single sample of data.
+
 			@param number_of_cycles The number of cycles to repeat the output for.
 		*/
 		void output_level(int number_of_cycles);
@@ -229,7 +244,16 @@ class CRT {
 #ifndef NDEBUG
 			allocated_data_length_ = required_length;
 #endif
-			return scan_target_->begin_data(required_length, required_alignment);
+			if(pending_level_cycles_) {
+				// This may be a repeat of the pending level; defer allocation until that's known.
+				if(required_length == 1) {
+					level_scratch_is_vended_ = true;
+					return level_scratch_;
+				}
+				flush_level();
+			}
+			allocated_data_ = scan_target_->begin_data(required_length, required_alignment);
+			return allocated_data_;
 		}
 
 		/*!	Sets the gamma exponent for the simulated screen. */
@@ -274,6 +298,15 @@ class CRT {
 		/*! Sets the scan target for CRT output. */
 		void set_scan_target(Outputs::Display::ScanTarget *);
 
+		/*!
+			@returns @c true if output is disabled because there is no scan target, in which case every
+			call to @c begin_data will fail. Video generators may use this to skip the work of producing
+			pixels, but should preserve any side effects of that work, such as memory fetches.
+		*/
+		inline bool is_output_disabled() const {
+			return scan_target_ == &Outputs::Display::NullScanTarget::singleton;
+		}
+
 		/*! Sets the display type that will be nominated to the scan target. */
 		void set_display_type(Outputs::Display::DisplayType);
 
@@ -0,0 +1,60 @@
+//
+//  FrameHasher.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#include "FrameHasher.hpp"
+
+#include <algorithm>
+
+using namespace Outputs::Capture;
+
+const std::vector<uint64_t> &FrameHasher::frame_hashes() const {
+	return frame_hashes_;
+}
+
+void FrameHasher::hash(const void *data, size_t length) {
+	// FNV-1a.
+	const auto bytes = static_cast<const uint8_t *>(data);
+	for(size_t c = 0; c < length; ++c) {
+		hash_ = (hash_ ^ bytes[c]) * 1099511628211u;
+	}
+}
+
+void FrameHasher::did_set_modals(const Modals &modals) {
+	// Hash only those fields that affect the meaning of subsequent scans.
+	hash(modals.input_data_type);
+	hash(modals.composite_colour_space);
+	hash(modals.cycles_per_line);
+	hash(modals.output_scale.x);
+	hash(modals.output_scale.y);
+}
+
+void FrameHasher::did_end_scan(const Scan &scan, const uint8_t *data) {
+	for(const auto &end_point: scan.end_points) {
+		hash(end_point.x);
+		hash(end_point.y);
+		hash(end_point.composite_angle);
+		hash(end_point.cycles_since_end_of_horizontal_retrace);
+	}
+	hash(scan.composite_amplitude);
+
+	if(data) {
+		// Hash the data this scan spans; that's at least one sample, even if its end
+		// points have the same offset, as is the case for a level.
+		const size_t sample_size = size_for_data_type(modals().input_data_type);
+		const size_t start = scan.end_points[0].data_offset;
+		const size_t end = std::max<size_t>(start + 1, scan.end_points[1].data_offset);
+		hash(&data[start * sample_size], (end - start) * sample_size);
+	}
+}
+
+void FrameHasher::did_announce(Event event) {
+	if(event != Event::BeginVerticalRetrace) return;
+
+	frame_hashes_.push_back(hash_);
+	hash_ = InitialHash;
+}
@@ -0,0 +1,53 @@
+//
+//  FrameHasher.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#ifndef Outputs_Capture_FrameHasher_hpp
+#define Outputs_Capture_FrameHasher_hpp
+
+#include "PassThroughScanTarget.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Capture {
+
+/*!
+	Computes a hash of each frame of video output, for cheap comparison against known-good output.
+
+	A FrameHasher passes everything it receives on to any nominated downstream scan target.
+	Each frame's hash covers the modals, every scan ended during the frame and the data
+	samples that each of those scans spans; frames are delimited by the start of vertical retrace.
+	Hashes are therefore a deterministic function of the machine's output, independent of both
+	host timing and of how the output would be rendered.
+*/
+class FrameHasher: public PassThroughScanTarget {
+	public:
+		/// @returns The hashes of all frames completed so far, indexed by frame number.
+		const std::vector<uint64_t> &frame_hashes() const;
+
+	private:
+		// PassThroughScanTarget overrides.
+		void did_set_modals(const Modals &modals) override;
+		void did_end_scan(const Scan &scan, const uint8_t *data) override;
+		void did_announce(Event event) override;
+
+		static constexpr uint64_t InitialHash = 14695981039346656037u;
+		uint64_t hash_ = InitialHash;
+		std::vector<uint64_t> frame_hashes_;
+
+		void hash(const void *data, size_t length);
+		template <typename IntT> void hash(IntT value) {
+			hash(&value, sizeof(value));
+		}
+};
+
+}
+}
+
+#endif /* Outputs_Capture_FrameHasher_hpp */
@@ -0,0 +1,72 @@
+//
+//  PassThroughScanTarget.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#include "PassThroughScanTarget.hpp"
+
+using namespace Outputs::Capture;
+
+void PassThroughScanTarget::set_scan_target(Outputs::Display::ScanTarget *scan_target) {
+	scan_target_ = scan_target;
+	if(scan_target_ && has_modals_) {
+		scan_target_->set_modals(modals_);
+	}
+}
+
+void PassThroughScanTarget::set_modals(Modals modals) {
+	modals_ = modals;
+	has_modals_ = true;
+	if(scan_target_) scan_target_->set_modals(modals);
+	did_set_modals(modals_);
+}
+
+Outputs::Display::ScanTarget::Scan *PassThroughScanTarget::begin_scan() {
+	scan_ = scan_target_ ? scan_target_->begin_scan() : &own_scan_;
+	return scan_;
+}
+
+void PassThroughScanTarget::end_scan() {
+	if(scan_) {
+		did_end_scan(*scan_, data_);
+		scan_ = nullptr;
+	}
+	if(scan_target_) scan_target_->end_scan();
+}
+
+uint8_t *PassThroughScanTarget::begin_data(size_t required_length, size_t required_alignment) {
+	if(scan_target_) {
+		data_ = scan_target_->begin_data(required_length, required_alignment);
+	} else {
+		// Allow for the largest sample size, plus alignment.
+		const size_t required_size = (required_length + required_alignment) * 4;
+		if(own_data_.size() < required_size) own_data_.resize(required_size);
+
+		const auto address = reinterpret_cast<uintptr_t>(own_data_.data());
+		const size_t alignment_bytes = required_alignment * size_for_data_type(modals_.input_data_type);
+		data_ = own_data_.data() + (alignment_bytes ? (alignment_bytes - (address % alignment_bytes)) % alignment_bytes : 0);
+	}
+	return data_;
+}
+
+void PassThroughScanTarget::end_data(size_t actual_length) {
+	if(scan_target_) scan_target_->end_data(actual_length);
+}
+
+void PassThroughScanTarget::will_change_owner() {
+	data_ = nullptr;
+	scan_ = nullptr;
+	if(scan_target_) scan_target_->will_change_owner();
+}
+
+void PassThroughScanTarget::submit() {
+	if(scan_target_) scan_target_->submit();
+}
+
+void PassThroughScanTarget::announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) {
+	if(scan_target_) scan_target_->announce(event, is_visible, location, composite_amplitude);
+	did_announce(event);
+}
@@ -0,0 +1,83 @@
+//
+//  PassThroughScanTarget.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#ifndef Outputs_Capture_PassThroughScanTarget_hpp
+#define Outputs_Capture_PassThroughScanTarget_hpp
+
+#include "../ScanTarget.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Capture {
+
+/*!
+	A ScanTarget that passes everything it receives on to any nominated downstream scan target,
+	and offers subclasses the chance to observe the modals, each completed scan and each event
+	along the way.
+
+	If there is no downstream target then scans and data areas are provided from storage owned
+	by this class, so that observation continues regardless.
+*/
+class PassThroughScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		/// Sets a scan target to which all calls will be forwarded, or @c nullptr for none.
+		void set_scan_target(Outputs::Display::ScanTarget *scan_target);
+
+		// Outputs::Display::ScanTarget overrides.
+		void set_modals(Modals) final;
+		Scan *begin_scan() final;
+		void end_scan() final;
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) final;
+		void end_data(size_t actual_length) final;
+		void will_change_owner() final;
+		void submit() final;
+		void announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) final;
+
+	protected:
+		~PassThroughScanTarget() = default;
+
+		/// Called after @c modals have been set and passed on.
+		virtual void did_set_modals(const Modals &modals) {}
+
+		/// Called as @c scan is ended, before it is passed on; @c data is the most recently allocated
+		/// data area, if any, to which the scan's data offsets refer.
+		virtual void did_end_scan(const Scan &scan, const uint8_t *data) {}
+
+		/// Called after @c event has been passed on.
+		virtual void did_announce(Event event) {}
+
+		/// @returns The most recently set modals.
+		const Modals &modals() const {
+			return modals_;
+		}
+
+		/// @returns @c true if any modals have yet been set; @c false otherwise.
+		bool has_modals() const {
+			return has_modals_;
+		}
+
+	private:
+		Outputs::Display::ScanTarget *scan_target_ = nullptr;
+
+		Modals modals_{};
+		bool has_modals_ = false;
+
+		// The current scan and data area; these are either vended by scan_target_ or,
+		// if there is no downstream target, owned by this class.
+		Scan *scan_ = nullptr;
+		Scan own_scan_;
+		uint8_t *data_ = nullptr;
+		std::vector<uint8_t> own_data_;
+};
+
+}
+}
+
+#endif /* Outputs_Capture_PassThroughScanTarget_hpp */
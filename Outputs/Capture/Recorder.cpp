@@ -0,0 +1,298 @@
+//
+//  Recorder.cpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#include "Recorder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace Outputs::Capture;
+
+namespace {
+
+/// Appends @c value to @c target as a little-endian quantity of @c size bytes.
+void append_little_endian(std::vector<uint8_t> &target, uint32_t value, int size) {
+	for(int c = 0; c < size; ++c) {
+		target.push_back(uint8_t(value));
+		value >>= 8;
+	}
+}
+
+/// Converts the sample at @c source to 8-bit RGB at @c target, per the input data type and colour space of @c modals.
+void to_rgb(const Outputs::Display::ScanTarget::Modals &modals, const uint8_t *source, uint8_t *target) {
+	using InputDataType = Outputs::Display::InputDataType;
+
+	switch(modals.input_data_type) {
+		case InputDataType::Luminance1:
+			target[0] = target[1] = target[2] = source[0] ? 255 : 0;
+		break;
+		case InputDataType::Luminance8:
+			target[0] = target[1] = target[2] = source[0];
+		break;
+		case InputDataType::Luminance8Phase8: {
+			// Decode as an S-Video display would: phases of 0–127 describe a complete revolution of
+			// the colour subcarrier, and anything above 191 means that colour is omitted.
+			if(source[1] > 191) {
+				target[0] = target[1] = target[2] = source[0];
+				break;
+			}
+
+			struct Chrominance {
+				float u, v;
+			};
+			static const auto chrominances = [] {
+				std::array<Chrominance, 192> table;
+				for(size_t c = 0; c < table.size(); ++c) {
+					const float angle = float(c) * 3.141592654f / 64.0f;
+					table[c] = Chrominance{0.5f * std::cos(angle), -0.5f * std::sin(angle)};
+				}
+				return table;
+			}();
+
+			const float y = float(source[0]);
+			const float u = chrominances[source[1]].u * 255.0f;
+			const float v = chrominances[source[1]].v * 255.0f;
+			float red, green, blue;
+			if(modals.composite_colour_space == Outputs::Display::ColourSpace::YIQ) {
+				red = y + 0.956f*u + 0.621f*v;
+				green = y - 0.272f*u - 0.647f*v;
+				blue = y - 1.106f*u + 1.703f*v;
+			} else {
+				red = y + 1.13983f*v;
+				green = y - 0.39465f*u - 0.58060f*v;
+				blue = y + 2.03211f*u;
+			}
+			target[0] = uint8_t(std::clamp(red, 0.0f, 255.0f));
+			target[1] = uint8_t(std::clamp(green, 0.0f, 255.0f));
+			target[2] = uint8_t(std::clamp(blue, 0.0f, 255.0f));
+		} break;
+		case InputDataType::PhaseLinkedLuminance8:
+			target[0] = target[1] = target[2] = uint8_t((source[0] + source[1] + source[2] + source[3]) >> 2);
+		break;
+
+		case InputDataType::Red1Green1Blue1:
+			target[0] = (source[0] & 4) ? 255 : 0;
+			target[1] = (source[0] & 2) ? 255 : 0;
+			target[2] = (source[0] & 1) ? 255 : 0;
+		break;
+		case InputDataType::Red2Green2Blue2:
+			target[0] = uint8_t(((source[0] >> 4) & 3) * 85);
+			target[1] = uint8_t(((source[0] >> 2) & 3) * 85);
+			target[2] = uint8_t((source[0] & 3) * 85);
+		break;
+		case InputDataType::Red4Green4Blue4:
+			target[0] = uint8_t((source[0] & 15) * 17);
+			target[1] = uint8_t((source[1] >> 4) * 17);
+			target[2] = uint8_t((source[1] & 15) * 17);
+		break;
+		case InputDataType::Red8Green8Blue8:
+			target[0] = source[0];
+			target[1] = source[1];
+			target[2] = source[2];
+		break;
+	}
+}
+
+}
+
+Recorder::Recorder(const std::string &base_path, int width, int height) :
+	width_(width), height_(height), frame_(size_t(width * height * 3)) {
+	video_file_ = fopen((base_path + ".y4m").c_str(), "wb");
+	audio_file_ = fopen((base_path + ".wav").c_str(), "wb");
+
+	if(video_file_) {
+		// Declare 50Hz until the actual rate has been measured.
+		write_video_header(50, 1);
+	}
+}
+
+Recorder::~Recorder() {
+	queue_.flush();
+
+	if(video_file_) {
+		// Rewrite the header now that the frame rate can be measured; it is quoted in thousandths.
+		if(frames_recorded_ > 1 && last_frame_time_ > first_frame_time_) {
+			const double frame_rate = double(frames_recorded_ - 1) / (last_frame_time_ - first_frame_time_);
+			fseek(video_file_, 0, SEEK_SET);
+			write_video_header(int(std::lround(frame_rate * 1000.0)), 1000);
+		}
+		fclose(video_file_);
+	}
+	if(audio_file_) {
+		// Rewrite the header now that the total length is known.
+		if(has_written_audio_header_) {
+			fseek(audio_file_, 0, SEEK_SET);
+			write_audio_header();
+		}
+		fclose(audio_file_);
+	}
+}
+
+bool Recorder::is_open() const {
+	return video_file_ && audio_file_;
+}
+
+void Recorder::set_speaker_delegate(Outputs::Speaker::Speaker::Delegate *delegate) {
+	speaker_delegate_ = delegate;
+}
+
+void Recorder::set_audio_sample_rate(int sample_rate) {
+	queue_.enqueue([this, sample_rate] {
+		audio_sample_rate_ = sample_rate;
+	});
+}
+
+int Recorder::frames_recorded() const {
+	return frames_recorded_;
+}
+
+void Recorder::add_time(Time::Seconds duration) {
+	time_ += duration;
+}
+
+// MARK: - Video.
+
+void Recorder::did_announce(Event event) {
+	if(event != Event::BeginVerticalRetrace) return;
+
+	if(!frames_recorded_) first_frame_time_ = time_;
+	last_frame_time_ = time_;
+	++frames_recorded_;
+	if(!video_file_) return;
+
+	// Each pending frame holds a full copy of the frame buffer, so if writing has fallen too far
+	// behind then wait for it to catch up rather than allowing them to accumulate without limit.
+	// Frames are never dropped, so that the recording remains a complete record of the output.
+	if(pending_frames_.load(std::memory_order_acquire) >= MaximumPendingFrames) {
+		queue_.flush();
+	}
+
+	// Convert and write on the queue; the frame is copied rather than moved because
+	// lines that aren't redrawn by the next field should persist.
+	pending_frames_.fetch_add(1, std::memory_order_relaxed);
+	queue_.enqueue([this, frame = frame_] {
+		const size_t pixels = size_t(width_ * height_);
+		std::vector<uint8_t> planes(pixels * 3);
+		for(size_t c = 0; c < pixels; ++c) {
+			const int red = frame[c*3 + 0], green = frame[c*3 + 1], blue = frame[c*3 + 2];
+
+			// ITU-R BT.601, studio swing.
+			planes[c]				= uint8_t(((66*red + 129*green + 25*blue + 128) >> 8) + 16);
+			planes[pixels + c]		= uint8_t(((-38*red - 74*green + 112*blue + 128) >> 8) + 128);
+			planes[pixels*2 + c]	= uint8_t(((112*red - 94*green - 18*blue + 128) >> 8) + 128);
+		}
+
+		fputs("FRAME\n", video_file_);
+		fwrite(planes.data(), 1, planes.size(), video_file_);
+		pending_frames_.fetch_sub(1, std::memory_order_release);
+	});
+}
+
+void Recorder::did_end_scan(const Scan &scan, const uint8_t *data) {
+	const Modals &modals = this->modals();
+	if(!has_modals() || !data || !modals.output_scale.x || !modals.output_scale.y) return;
+
+	// Map from output coordinates to the visible area, and thereby to pixels.
+	const auto &visible_area = modals.visible_area;
+	const auto to_x = [&] (uint16_t x) {
+		return (float(x) / float(modals.output_scale.x) - visible_area.origin.x) * float(width_) / visible_area.size.width;
+	};
+	const auto to_y = [&] (float y) {
+		return (y / float(modals.output_scale.y) - visible_area.origin.y) * float(height_) / visible_area.size.height;
+	};
+
+	// Each scan is drawn as a single row, then stretched to the height of a line.
+	const float centre_y = (float(scan.end_points[0].y) + float(scan.end_points[1].y)) * 0.5f;
+	const float line_height = float(modals.output_scale.y) / float(std::max(1, modals.expected_vertical_lines));
+	const int row = int(std::floor(to_y(centre_y)));
+	const int end_row = std::min(height_, std::max(row + 1, int(std::floor(to_y(centre_y + line_height)))));
+	if(row < 0 || row >= height_) return;
+
+	const float start_x = to_x(scan.end_points[0].x);
+	const float end_x = to_x(scan.end_points[1].x);
+	if(end_x <= start_x) return;
+
+	const int start_column = std::max(0, int(std::ceil(start_x - 0.5f)));
+	const int end_column = std::min(width_, int(std::ceil(end_x - 0.5f)));
+
+	const int start_offset = scan.end_points[0].data_offset;
+	const int samples = std::max(1, int(scan.end_points[1].data_offset) - start_offset);
+	const size_t sample_size = size_for_data_type(modals.input_data_type);
+
+	uint8_t *target = &frame_[size_t(row * width_ + start_column) * 3];
+	for(int column = start_column; column < end_column; ++column) {
+		const float position = (float(column) + 0.5f - start_x) / (end_x - start_x);
+		const int sample = std::min(samples - 1, int(position * float(samples)));
+		to_rgb(modals, &data[size_t(start_offset + sample) * sample_size], target);
+		target += 3;
+	}
+
+	const size_t row_length = size_t(std::max(0, end_column - start_column) * 3);
+	const uint8_t *const source = &frame_[size_t(row * width_ + start_column) * 3];
+	for(int copy_row = row + 1; copy_row < end_row; ++copy_row) {
+		std::copy(source, source + row_length, &frame_[size_t(copy_row * width_ + start_column) * 3]);
+	}
+}
+
+void Recorder::write_video_header(int frame_rate_numerator, int frame_rate_denominator) {
+	// The frame rate is zero-padded so that the header's length doesn't depend on it, allowing it to be rewritten in place.
+	fprintf(video_file_, "YUV4MPEG2 W%d H%d F%010d:%010d Ip A1:1 C444\n", width_, height_, frame_rate_numerator, frame_rate_denominator);
+}
+
+// MARK: - Audio.
+
+void Recorder::write_audio_header() {
+	const uint32_t sample_rate = uint32_t(audio_sample_rate_);
+	std::vector<uint8_t> header;
+	const auto append_tag = [&header] (const char *tag) {
+		header.insert(header.end(), tag, tag + 4);
+	};
+
+	append_tag("RIFF");
+	append_little_endian(header, 36 + audio_bytes_written_, 4);
+	append_tag("WAVE");
+
+	append_tag("fmt ");
+	append_little_endian(header, 16, 4);				// Chunk size.
+	append_little_endian(header, 1, 2);					// Format: PCM.
+	append_little_endian(header, 1, 2);					// Channels.
+	append_little_endian(header, sample_rate, 4);
+	append_little_endian(header, sample_rate * 2, 4);	// Bytes per second.
+	append_little_endian(header, 2, 2);					// Bytes per sample frame.
+	append_little_endian(header, 16, 2);				// Bits per sample.
+
+	append_tag("data");
+	append_little_endian(header, audio_bytes_written_, 4);
+
+	fwrite(header.data(), 1, header.size(), audio_file_);
+}
+
+void Recorder::speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) {
+	if(speaker_delegate_) speaker_delegate_->speaker_did_complete_samples(speaker, buffer);
+	if(!audio_file_) return;
+
+	queue_.enqueue([this, samples = buffer] {
+		if(!has_written_audio_header_) {
+			write_audio_header();
+			has_written_audio_header_ = true;
+		}
+
+		std::vector<uint8_t> bytes;
+		bytes.reserve(samples.size() * 2);
+		for(const auto sample: samples) {
+			append_little_endian(bytes, uint16_t(sample), 2);
+		}
+		fwrite(bytes.data(), 1, bytes.size(), audio_file_);
+		audio_bytes_written_ += uint32_t(bytes.size());
+	});
+}
+
+void Recorder::speaker_did_change_input_clock(Outputs::Speaker::Speaker *speaker) {
+	if(speaker_delegate_) speaker_delegate_->speaker_did_change_input_clock(speaker);
+}
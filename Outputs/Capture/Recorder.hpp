@@ -0,0 +1,108 @@
+//
+//  Recorder.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#ifndef Outputs_Capture_Recorder_hpp
+#define Outputs_Capture_Recorder_hpp
+
+#include "PassThroughScanTarget.hpp"
+#include "../Speaker/Speaker.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Outputs {
+namespace Capture {
+
+/*!
+	Records video and audio output to disk: video as an uncompressed YUV4MPEG2 stream, at 4:4:4,
+	and audio as a 16-bit mono WAV file.
+
+	A Recorder is both a pass-through scan target and a speaker delegate; it passes everything it
+	receives on to any nominated downstream scan target and delegate, so it can be inserted in front
+	of the normal outputs or used on its own for headless capture.
+
+	Scans are rasterised into a frame buffer as they are ended, using the raw colour of the input
+	data without any composite decoding, and a frame is emitted at the start of each vertical
+	retrace; so output is a deterministic function of the machine's output, independent of
+	host timing. All file writing occurs on a background queue; if that falls more than a few frames
+	behind, the emulation waits for it.
+
+	The video's frame rate is measured from the amount of emulated time between frames, as
+	reported via @c add_time, and is written to the video header when the recorder is destroyed.
+*/
+class Recorder: public PassThroughScanTarget, public Outputs::Speaker::Speaker::Delegate {
+	public:
+		/*!
+			Creates a recorder that will write to @c base_path with the extensions .y4m and .wav.
+
+			@param width The width of the recorded video.
+			@param height The height of the recorded video.
+		*/
+		Recorder(const std::string &base_path, int width = 640, int height = 480);
+		~Recorder();
+
+		/// @returns @c true if the output files were opened successfully; @c false otherwise.
+		bool is_open() const;
+
+		/// Sets a speaker delegate to which all calls will be forwarded, or @c nullptr for none.
+		void set_speaker_delegate(Outputs::Speaker::Speaker::Delegate *delegate);
+
+		/// Sets the sample rate to declare in the audio header; this should match the rate supplied to the speaker.
+		void set_audio_sample_rate(int sample_rate);
+
+		/// @returns The number of frames that have been recorded so far.
+		int frames_recorded() const;
+
+		/// Informs the recorder that the machine has been run for a further @c duration of emulated time.
+		void add_time(Time::Seconds duration);
+
+		// Outputs::Speaker::Speaker::Delegate overrides.
+		void speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) override;
+		void speaker_did_change_input_clock(Outputs::Speaker::Speaker *speaker) override;
+
+	private:
+		const int width_, height_;
+		Outputs::Speaker::Speaker::Delegate *speaker_delegate_ = nullptr;
+
+		// PassThroughScanTarget overrides.
+		void did_end_scan(const Scan &scan, const uint8_t *data) override;
+		void did_announce(Event event) override;
+
+		// The frame being composed, as 8-bit RGB.
+		std::vector<uint8_t> frame_;
+		int frames_recorded_ = 0;
+
+		// The number of frames enqueued but not yet written, and the most that may be.
+		static constexpr int MaximumPendingFrames = 8;
+		std::atomic<int> pending_frames_ = 0;
+
+		// Emulated time so far, and as at the first and most recent frames.
+		Time::Seconds time_ = 0.0, first_frame_time_ = 0.0, last_frame_time_ = 0.0;
+		void write_video_header(int frame_rate_numerator, int frame_rate_denominator);
+
+		// Output; the files are accessed only from the queue.
+		FILE *video_file_ = nullptr;
+		FILE *audio_file_ = nullptr;
+		int audio_sample_rate_ = 0;
+		uint32_t audio_bytes_written_ = 0;
+		bool has_written_audio_header_ = false;
+		void write_audio_header();
+
+		// This is declared last so that it is destroyed, and therefore flushed, first.
+		Concurrency::AsyncTaskQueue queue_;
+};
+
+}
+}
+
+#endif /* Outputs_Capture_Recorder_hpp */
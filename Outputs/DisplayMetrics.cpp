@@ -8,6 +8,7 @@
 
 #include "DisplayMetrics.hpp"
 
+#include <algorithm>
 #include <numeric>
 
 using namespace Outputs::Display;
@@ -51,6 +52,8 @@ void Metrics::announce_did_resize() {
 }
 
 void Metrics::announce_draw_status(size_t lines, std::chrono::high_resolution_clock::duration duration, bool complete) {
+	update_quality_level(complete);
+
 	if(!complete) {
 		++frames_missed_;
 	} else {
@@ -86,3 +89,70 @@ bool Metrics::should_lower_resolution() {
 	if(frames_hit_ + frames_missed_ < 100) return false;
 	return frames_missed_ > 10;
 }
+
+// MARK: Quality control.
+
+void Metrics::set_draw_budget(std::chrono::high_resolution_clock::duration budget) {
+	draw_budget_ = budget;
+}
+
+void Metrics::set_maximum_quality_level(int level) {
+	maximum_quality_level_ = level;
+	if(quality_level_ > level) quality_level_ = level;
+}
+
+int Metrics::quality_level() const {
+	return quality_level_;
+}
+
+void Metrics::announce_did_change_pipeline() {
+	quality_level_ = 0;
+	quality_samples_ = quality_overruns_ = quality_headroom_ = 0;
+	headroom_windows_ = 0;
+	headroom_windows_required_ = 1;
+	did_raise_quality_ = false;
+	has_draw_cost_ = false;
+}
+
+void Metrics::announce_draw_cost(std::chrono::high_resolution_clock::duration duration) {
+	draw_cost_ = duration;
+	has_draw_cost_ = true;
+}
+
+void Metrics::update_quality_level(bool complete) {
+	// Classify this draw: it overran if it didn't complete in time or cost more than the budget;
+	// it had headroom if it completed and, if its cost is known, cost less than half the budget.
+	const auto budget = draw_budget_.load();
+	if(!complete || (has_draw_cost_ && draw_cost_ > budget)) {
+		++quality_overruns_;
+	} else if(!has_draw_cost_ || draw_cost_ < budget / 2) {
+		++quality_headroom_;
+	}
+	has_draw_cost_ = false;
+
+	if(++quality_samples_ < QualityWindow) return;
+
+	const int level = quality_level_;
+	if(quality_overruns_ > QualityWindow / 10) {
+		// Drop quality; if quality was only just raised then require longer evidence of headroom next time.
+		if(did_raise_quality_) {
+			headroom_windows_required_ = std::min(headroom_windows_required_ * 2, MaximumHeadroomWindows);
+		}
+		did_raise_quality_ = false;
+		headroom_windows_ = 0;
+		if(level < maximum_quality_level_) quality_level_ = level + 1;
+	} else if(quality_headroom_ == quality_samples_) {
+		// Raise quality only after sufficiently many consecutive windows of headroom.
+		did_raise_quality_ = false;
+		if(level > 0 && ++headroom_windows_ >= headroom_windows_required_) {
+			quality_level_ = level - 1;
+			did_raise_quality_ = true;
+			headroom_windows_ = 0;
+		}
+	} else {
+		did_raise_quality_ = false;
+		headroom_windows_ = 0;
+	}
+
+	quality_samples_ = quality_overruns_ = quality_headroom_ = 0;
+}
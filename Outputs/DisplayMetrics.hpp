@@ -12,6 +12,7 @@
 #include "ScanTarget.hpp"
 
 #include <array>
+#include <atomic>
 #include <chrono>
 
 namespace Outputs {
@@ -21,6 +22,9 @@ namespace Display {
 	A class to derive various metrics about the input to a ScanTarget,
 	based purely on empirical observation. In particular it is intended
 	to allow for host-client frame synchronisation.
+
+	It also recommends a quality level for drawing, adjusting it so that the
+	cost of drawing each frame stays within a nominated budget.
 */
 class Metrics {
 	public:
@@ -29,12 +33,27 @@ class Metrics {
 
 		/// Notifies Metrics that the size of the output buffer has changed.
 		void announce_did_resize();
+		/// Notifies Metrics that the output pipeline has been reconfigured, so the recommended quality level should start again from the top.
+		void announce_did_change_pipeline();
 		/// Provides Metrics with a new data point for output speed estimation.
 		void announce_draw_status(size_t lines, std::chrono::high_resolution_clock::duration duration, bool complete);
+		/// Provides Metrics with the measured cost of the draw that will be reported by the next call to @c announce_draw_status.
+		void announce_draw_cost(std::chrono::high_resolution_clock::duration duration);
 
 		/// @returns @c true if Metrics thinks a lower output buffer resolution is desirable in the abstract; @c false otherwise.
 		bool should_lower_resolution();
 
+		/// Sets the amount of time that drawing each frame should ideally take; the default is 10ms.
+		void set_draw_budget(std::chrono::high_resolution_clock::duration budget);
+		/// Sets the greatest quality level that may be recommended; this is set by the scan target to indicate how many levels of degradation it offers.
+		void set_maximum_quality_level(int level);
+		/*!
+			@returns The currently-recommended quality level, from 0 — the highest — to the maximum quality level.
+			This is raised if draws are measured to exceed the budget or fail to complete in time, and lowered if
+			they are comfortably within it. It may be polled from any thread for monitoring purposes.
+		*/
+		int quality_level() const;
+
 		/// @returns An estimate of the number of lines being produced per frame, excluding vertical sync.
 		float visible_lines_per_frame_estimate();
 
@@ -49,6 +68,24 @@ class Metrics {
 
 		int frames_hit_ = 0;
 		int frames_missed_ = 0;
+
+		// Quality control: decisions are made once per window of draws; after a drop in quality that
+		// immediately follows a rise, the number of windows of headroom required before the next rise is doubled.
+		static constexpr int QualityWindow = 60;
+		static constexpr int MaximumHeadroomWindows = 16;
+		std::atomic<std::chrono::high_resolution_clock::duration> draw_budget_{std::chrono::milliseconds(10)};
+		std::atomic<int> quality_level_{0};
+		int maximum_quality_level_ = 0;
+
+		std::chrono::high_resolution_clock::duration draw_cost_{};
+		bool has_draw_cost_ = false;
+		int quality_samples_ = 0;
+		int quality_overruns_ = 0;
+		int quality_headroom_ = 0;
+		int headroom_windows_ = 0;
+		int headroom_windows_required_ = 1;
+		bool did_raise_quality_ = false;
+		void update_quality_level(bool complete);
 };
 
 }
@@ -11,6 +11,7 @@
 #include "OpenGL.hpp"
 #include "Primitives/Rectangle.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <limits>
@@ -22,6 +23,12 @@ using namespace Outputs::Display::OpenGL;
 //#define LOG_SCANS
 #endif
 
+// Persistent mapping requires glBufferStorage and glDrawArraysInstancedBaseInstance, which are
+// declared only by headers that include OpenGL 4.4.
+#ifdef GL_VERSION_4_4
+#define PERSISTENT_MAPPING_AVAILABLE
+#endif
+
 namespace {
 
 /// The texture unit from which to source input data.
@@ -55,6 +62,28 @@ const GLint internalFormatForDepth(std::size_t depth) {
 	}
 }
 
+#ifdef PERSISTENT_MAPPING_AVAILABLE
+/// The flags used both to create and to map persistently-mapped buffers; scans are
+/// modified after being vended, so reading is also permitted.
+constexpr GLbitfield PersistentMappingFlags = GL_MAP_WRITE_BIT | GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+#endif
+
+/// @returns @c true if the current context is at least version @c required_major.@c required_minor.
+bool is_version_at_least(GLint required_major, GLint required_minor) {
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	return major > required_major || (major == required_major && minor >= required_minor);
+}
+
+bool supports_persistent_mapping() {
+#ifdef PERSISTENT_MAPPING_AVAILABLE
+	return is_version_at_least(4, 4);
+#else
+	return false;
+#endif
+}
+
 const GLenum formatForDepth(std::size_t depth) {
 	switch(depth) {
 		default: return GL_FALSE;
@@ -67,15 +96,26 @@ const GLenum formatForDepth(std::size_t depth) {
 
 }
 
-template <typename T> void ScanTarget::allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name) {
+template <typename T> void *ScanTarget::allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name) {
 	const auto buffer_size = array.size() * sizeof(array[0]);
+	void *mapping = nullptr;
 	test_gl(glGenBuffers, 1, &buffer_name);
 	test_gl(glBindBuffer, GL_ARRAY_BUFFER, buffer_name);
-	test_gl(glBufferData, GL_ARRAY_BUFFER, GLsizeiptr(buffer_size), NULL, GL_STREAM_DRAW);
+#ifdef PERSISTENT_MAPPING_AVAILABLE
+	if(uses_persistent_mapping_) {
+		test_gl(glBufferStorage, GL_ARRAY_BUFFER, GLsizeiptr(buffer_size), NULL, PersistentMappingFlags);
+		mapping = glMapBufferRange(GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), PersistentMappingFlags);
+		test_gl_error();
+	} else
+#endif
+	{
+		test_gl(glBufferData, GL_ARRAY_BUFFER, GLsizeiptr(buffer_size), NULL, GL_STREAM_DRAW);
+	}
 
 	test_gl(glGenVertexArrays, 1, &vertex_array_name);
 	test_gl(glBindVertexArray, vertex_array_name);
 	test_gl(glBindBuffer, GL_ARRAY_BUFFER, buffer_name);
+	return mapping;
 }
 
 ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
@@ -88,16 +128,53 @@ ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
 	read_pointers_.store(write_pointers_);
 	submit_pointers_.store(write_pointers_);
 
-	// Allocate space for the scans and lines.
-	allocate_buffer(scan_buffer_, scan_buffer_name_, scan_vertex_array_);
-	allocate_buffer(line_buffer_, line_buffer_name_, line_vertex_array_);
+	// Allocate space for the scans and lines; if persistent mapping is available then the client
+	// will write straight into GPU-visible memory.
+	uses_persistent_mapping_ = supports_persistent_mapping();
+	if(uses_persistent_mapping_) {
+		scans_ = static_cast<Scan *>(allocate_buffer(scan_buffer_, scan_buffer_name_, scan_vertex_array_));
+		lines_ = static_cast<Line *>(allocate_buffer(line_buffer_, line_buffer_name_, line_vertex_array_));
+
+#ifdef PERSISTENT_MAPPING_AVAILABLE
+		// Also create a pixel buffer large enough for the write area at any data size.
+		const auto buffer_size = GLsizeiptr(WriteAreaWidth * WriteAreaHeight * 4);
+		test_gl(glGenBuffers, 1, &write_area_buffer_name_);
+		test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, write_area_buffer_name_);
+		test_gl(glBufferStorage, GL_PIXEL_UNPACK_BUFFER, buffer_size, NULL, PersistentMappingFlags);
+		write_area_buffer_ = static_cast<uint8_t *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, buffer_size, PersistentMappingFlags));
+		test_gl_error();
+		test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, 0);
+#endif
 
-	// TODO: if this is OpenGL 4.4 or newer, use glBufferStorage rather than glBufferData
-	// and specify GL_MAP_PERSISTENT_BIT. Then map the buffer now, and let the client
-	// write straight into it.
+		// If any mapping failed then discard everything and fall back on uploading copies.
+		if(!scans_ || !lines_ || !write_area_buffer_) {
+			LOG("Persistent mapping failed; falling back on buffer uploads");
+			const GLuint buffers[] = {scan_buffer_name_, line_buffer_name_, write_area_buffer_name_};
+			const GLuint vertex_arrays[] = {scan_vertex_array_, line_vertex_array_};
+			test_gl(glDeleteBuffers, 3, buffers);
+			test_gl(glDeleteVertexArrays, 2, vertex_arrays);
+			write_area_buffer_name_ = 0;
+			write_area_buffer_ = nullptr;
+			uses_persistent_mapping_ = false;
+		}
+	}
+	if(!uses_persistent_mapping_) {
+		allocate_buffer(scan_buffer_, scan_buffer_name_, scan_vertex_array_);
+		allocate_buffer(line_buffer_, line_buffer_name_, line_vertex_array_);
+		scans_ = scan_buffer_.data();
+		lines_ = line_buffer_.data();
+	}
+	pending_read_pointers_ = write_pointers_;
 
 	test_gl(glGenTextures, 1, &write_area_texture_name_);
 
+	// Timer queries became core in OpenGL 3.3.
+#ifdef GL_TIME_ELAPSED
+	if(is_version_at_least(3, 3)) {
+		test_gl(glGenQueries, 1, &timer_query_);
+	}
+#endif
+
 	test_gl(glBlendFunc, GL_SRC_ALPHA, GL_CONSTANT_COLOR);
 	test_gl(glBlendColor, 0.4f, 0.4f, 0.4f, 1.0f);
 
@@ -109,7 +186,9 @@ ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
 ScanTarget::~ScanTarget() {
 	while(is_updating_.test_and_set());
 	glDeleteBuffers(1, &scan_buffer_name_);
+	glDeleteBuffers(1, &write_area_buffer_name_);
 	glDeleteTextures(1, &write_area_texture_name_);
+	if(timer_query_) glDeleteQueries(1, &timer_query_);
 	glDeleteVertexArrays(1, &scan_vertex_array_);
 }
 
@@ -131,7 +210,7 @@ void ScanTarget::set_modals(Modals modals) {
 Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
 	if(allocation_has_failed_) return nullptr;
 
-	const auto result = &scan_buffer_[write_pointers_.scan_buffer];
+	const auto result = &scans_[write_pointers_.scan_buffer];
 	const auto read_pointers = read_pointers_.load();
 
 	// Advance the pointer.
@@ -177,7 +256,7 @@ uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignmen
 	assert(required_alignment);
 
 	if(allocation_has_failed_) return nullptr;
-	if(write_area_texture_.empty()) {
+	if(!write_area_) {
 		allocation_has_failed_ = true;
 		return nullptr;
 	}
@@ -213,7 +292,7 @@ uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignmen
 	// Everything checks out, note expectation of a future end_data and return the pointer.
 	data_is_allocated_ = true;
 	vended_write_area_pointer_ = write_pointers_.write_area = TextureAddress(aligned_start_x, output_y);
-	return &write_area_texture_[size_t(write_pointers_.write_area) * data_type_size_];
+	return &write_area_[size_t(write_pointers_.write_area) * data_type_size_];
 
 	// Note state at exit:
 	//		write_pointers_.write_area points to the first pixel the client is expected to draw to.
@@ -224,8 +303,8 @@ void ScanTarget::end_data(size_t actual_length) {
 
 	// Bookend the start of the new data, to safeguard for precision errors in sampling.
 	memcpy(
-		&write_area_texture_[size_t(write_pointers_.write_area - 1) * data_type_size_],
-		&write_area_texture_[size_t(write_pointers_.write_area) * data_type_size_],
+		&write_area_[size_t(write_pointers_.write_area - 1) * data_type_size_],
+		&write_area_[size_t(write_pointers_.write_area) * data_type_size_],
 		data_type_size_);
 
 	// Advance to the end of the current run.
@@ -233,14 +312,14 @@ void ScanTarget::end_data(size_t actual_length) {
 
 	// Also bookend the end.
 	memcpy(
-		&write_area_texture_[size_t(write_pointers_.write_area - 1) * data_type_size_],
-		&write_area_texture_[size_t(write_pointers_.write_area - 2) * data_type_size_],
+		&write_area_[size_t(write_pointers_.write_area - 1) * data_type_size_],
+		&write_area_[size_t(write_pointers_.write_area - 2) * data_type_size_],
 		data_type_size_);
 
 	// The write area was allocated in the knowledge that there's sufficient
 	// distance left on the current line, but there's a risk of exactly filling
 	// the final line, in which case this should wrap back to 0.
-	write_pointers_.write_area %= (write_area_texture_.size() / data_type_size_);
+	write_pointers_.write_area %= WriteAreaWidth * WriteAreaHeight;
 
 	// Record that no further end_data calls are expected.
 	data_is_allocated_ = false;
@@ -304,7 +383,7 @@ void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::
 			} else {
 				line_allocation_has_failed_ = false;
 				write_pointers_.line = next_line;
-				active_line_ = &line_buffer_[size_t(write_pointers_.line)];
+				active_line_ = &lines_[size_t(write_pointers_.line)];
 			}
 			provided_scans_ = 0;
 		} else {
@@ -314,7 +393,7 @@ void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::
 				if(next_line != read_pointers.line) {
 					line_allocation_has_failed_ = false;
 					write_pointers_.line = next_line;
-					active_line_ = &line_buffer_[size_t(write_pointers_.line)];
+					active_line_ = &lines_[size_t(write_pointers_.line)];
 				}
 			}
 		}
@@ -355,7 +434,12 @@ void ScanTarget::setup_pipeline() {
 		// TODO: flush output.
 
 		data_type_size_ = data_type_size;
-		write_area_texture_.resize(WriteAreaWidth*WriteAreaHeight*data_type_size_);
+		if(uses_persistent_mapping_) {
+			write_area_ = write_area_buffer_;
+		} else {
+			write_area_texture_.resize(WriteAreaWidth*WriteAreaHeight*data_type_size_);
+			write_area_ = write_area_texture_.data();
+		}
 
 		write_pointers_.scan_buffer = 0;
 		write_pointers_.write_area = 0;
@@ -381,14 +465,13 @@ void ScanTarget::setup_pipeline() {
 		qam_separation_shader_.reset();
 	}
 
-	// Establish an output shader.
-	output_shader_ = conversion_shader();
-	enable_vertex_attributes(ShaderType::Conversion, *output_shader_);
-	set_uniforms(ShaderType::Conversion, *output_shader_);
-	output_shader_->set_uniform("origin", modals_.visible_area.origin.x, modals_.visible_area.origin.y);
-	output_shader_->set_uniform("size", modals_.visible_area.size.width, modals_.visible_area.size.height);
-	output_shader_->set_uniform("textureName", GLint(UnprocessedLineBufferTextureUnit - GL_TEXTURE0));
-	output_shader_->set_uniform("qamTextureName", GLint(QAMChromaTextureUnit - GL_TEXTURE0));
+	// Restart adaptive quality from the top, and establish an output shader.
+	display_metrics_.set_maximum_quality_level(maximum_quality_level());
+	display_metrics_.announce_did_change_pipeline();
+	quality_level_ = 0;
+	resolution_reduction_level_ = 1;
+	uses_reduced_filters_ = false;
+	setup_output_shader();
 
 	// Establish an input shader.
 	input_shader_ = composition_shader();
@@ -399,6 +482,42 @@ void ScanTarget::setup_pipeline() {
 	input_shader_->set_uniform("textureName", GLint(SourceDataTextureUnit - GL_TEXTURE0));
 }
 
+void ScanTarget::setup_output_shader() {
+	test_gl(glBindVertexArray, line_vertex_array_);
+	test_gl(glBindBuffer, GL_ARRAY_BUFFER, line_buffer_name_);
+
+	output_shader_ = conversion_shader();
+	enable_vertex_attributes(ShaderType::Conversion, *output_shader_);
+	set_uniforms(ShaderType::Conversion, *output_shader_);
+	output_shader_->set_uniform("origin", modals_.visible_area.origin.x, modals_.visible_area.origin.y);
+	output_shader_->set_uniform("size", modals_.visible_area.size.width, modals_.visible_area.size.height);
+	output_shader_->set_uniform("textureName", GLint(UnprocessedLineBufferTextureUnit - GL_TEXTURE0));
+	output_shader_->set_uniform("qamTextureName", GLint(QAMChromaTextureUnit - GL_TEXTURE0));
+}
+
+bool ScanTarget::has_reduced_filters() {
+	// Composite monochrome output depends on all four of its samples to cancel out chrominance.
+	return modals_.display_type != DisplayType::CompositeMonochrome;
+}
+
+int ScanTarget::maximum_quality_level() {
+	return (has_reduced_filters() ? 1 : 0) + (is_soft_display_type() ? 3 : 0);
+}
+
+bool ScanTarget::apply_quality_level(int level) {
+	if(level == quality_level_) return false;
+	quality_level_ = level;
+
+	const int filter_levels = has_reduced_filters() ? 1 : 0;
+	resolution_reduction_level_ = 1 + std::max(0, level - filter_levels);
+
+	const bool uses_reduced_filters = filter_levels && level > 0;
+	if(uses_reduced_filters == uses_reduced_filters_) return false;
+	uses_reduced_filters_ = uses_reduced_filters;
+	setup_output_shader();
+	return true;
+}
+
 Outputs::Display::Metrics &ScanTarget::display_metrics() {
 	return display_metrics_;
 }
@@ -419,6 +538,16 @@ void ScanTarget::update(int output_width, int output_height) {
 		}
 		fence_ = nullptr;
 	}
+
+	// The previous update has completed, so its cost is now known if it was measured.
+#ifdef GL_TIME_ELAPSED
+	if(timer_query_is_pending_) {
+		GLuint64 elapsed = 0;
+		test_gl(glGetQueryObjectui64v, timer_query_, GL_QUERY_RESULT, &elapsed);
+		display_metrics_.announce_draw_cost(std::chrono::nanoseconds(elapsed));
+		timer_query_is_pending_ = false;
+	}
+#endif
 	display_metrics_.announce_draw_status(
 		lines_submitted_,
 		std::chrono::high_resolution_clock::now() - line_submission_begin_time_,
@@ -428,6 +557,19 @@ void ScanTarget::update(int output_width, int output_height) {
 	// with instances where waiting is inappropriate.
 	while(is_updating_.test_and_set());
 
+	// Measure the GPU cost of everything from here on, if possible.
+#ifdef GL_TIME_ELAPSED
+	if(timer_query_) {
+		test_gl(glBeginQuery, GL_TIME_ELAPSED, timer_query_);
+	}
+#endif
+
+	// If persistently mapped, the GPU has now finished with everything the previous update
+	// consumed, so that can be released for reuse.
+	if(uses_persistent_mapping_) {
+		read_pointers_.store(pending_read_pointers_);
+	}
+
 	// Establish the pipeline if necessary.
 	const bool did_setup_pipeline = modals_are_dirty_;
 	if(modals_are_dirty_) {
@@ -445,9 +587,9 @@ void ScanTarget::update(int output_width, int output_height) {
 	// Determine how many lines are about to be submitted.
 	lines_submitted_ = (read_pointers.line + line_buffer_.size() - submit_pointers.line) % line_buffer_.size();
 
-	// Submit scans; only the new ones need to be communicated.
+	// Submit scans; only the new ones need to be communicated, and only if they're not already in GPU-visible memory.
 	size_t new_scans = (submit_pointers.scan_buffer + scan_buffer_.size() - read_pointers.scan_buffer) % scan_buffer_.size();
-	if(new_scans) {
+	if(new_scans && !uses_persistent_mapping_) {
 		test_gl(glBindBuffer, GL_ARRAY_BUFFER, scan_buffer_name_);
 
 		// Map only the required portion of the buffer.
@@ -495,6 +637,14 @@ void ScanTarget::update(int output_width, int output_height) {
 			texture_exists_ = true;
 		}
 
+		// If persistently mapped then the texture is sourced from the pixel buffer, so the copy is performed by the GPU.
+		if(uses_persistent_mapping_) {
+			test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, write_area_buffer_name_);
+		}
+		const auto source = [&] (size_t offset) -> const void * {
+			return uses_persistent_mapping_ ? reinterpret_cast<const void *>(offset) : &write_area_[offset];
+		};
+
 		const auto start_y = TextureAddressGetY(read_pointers.write_area);
 		const auto end_y = TextureAddressGetY(submit_pointers.write_area);
 		if(end_y >= start_y) {
@@ -506,7 +656,7 @@ void ScanTarget::update(int output_width, int output_height) {
 				1 + end_y - start_y,
 				formatForDepth(data_type_size_),
 				GL_UNSIGNED_BYTE,
-				&write_area_texture_[size_t(TextureAddress(0, start_y)) * data_type_size_]);
+				source(size_t(TextureAddress(0, start_y)) * data_type_size_));
 		} else {
 			// The circular buffer wrapped around; submit the data from the read pointer to the end of
 			// the buffer and from the start of the buffer to the submit pointer.
@@ -517,7 +667,7 @@ void ScanTarget::update(int output_width, int output_height) {
 				1 + end_y,
 				formatForDepth(data_type_size_),
 				GL_UNSIGNED_BYTE,
-				&write_area_texture_[0]);
+				source(0));
 			test_gl(glTexSubImage2D,
 				GL_TEXTURE_2D, 0,
 				0, start_y,
@@ -525,7 +675,11 @@ void ScanTarget::update(int output_width, int output_height) {
 				WriteAreaHeight - start_y,
 				formatForDepth(data_type_size_),
 				GL_UNSIGNED_BYTE,
-				&write_area_texture_[size_t(TextureAddress(0, start_y)) * data_type_size_]);
+				source(size_t(TextureAddress(0, start_y)) * data_type_size_));
+		}
+
+		if(uses_persistent_mapping_) {
+			test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, 0);
 		}
 	}
 
@@ -564,20 +718,18 @@ void ScanTarget::update(int output_width, int output_height) {
 		// Apply new spans. They definitely always go to the first buffer.
 		test_gl(glBindVertexArray, scan_vertex_array_);
 		input_shader_->bind();
-		test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(new_scans));
+		draw_instances(read_pointers.scan_buffer, new_scans, scan_buffer_.size());
 	}
 
-	// Logic for reducing resolution: start doing so if the metrics object reports that
-	// it's a good idea. Go up to a quarter of the requested resolution, subject to
-	// clamping at each stage. If the output resolution changes, or anything else about
-	// the output pipeline, just start trying the highest size again.
-	if(display_metrics_.should_lower_resolution() && is_soft_display_type()) {
-		resolution_reduction_level_ = std::min(resolution_reduction_level_+1, 4);
-	}
-	if(output_height_ != output_height || did_setup_pipeline) {
-		resolution_reduction_level_ = 1;
+	// Adopt whatever quality level the metrics object currently recommends, which may mean reducing
+	// filtering and going down to a quarter of the requested resolution, subject to clamping at each
+	// stage. If the output resolution changes, or anything else about the output pipeline, just start
+	// trying the highest quality again.
+	if(output_height_ != output_height) {
+		display_metrics_.announce_did_change_pipeline();
 		output_height_ = output_height;
 	}
+	const bool did_change_output_shader = apply_quality_level(display_metrics_.quality_level());
 
 	// Ensure the accumulation buffer is properly sized, allowing for the metrics object's
 	// feelings about whether too high a resolution is being used.
@@ -617,7 +769,7 @@ void ScanTarget::update(int output_width, int output_height) {
 		stencil_is_valid_ = false;
 	}
 
-	if(did_setup_pipeline || did_create_accumulation_texture) {
+	if(did_setup_pipeline || did_create_accumulation_texture || did_change_output_shader) {
 		set_sampling_window(proportional_width, framebuffer_height, *output_shader_);
 	}
 
@@ -671,24 +823,26 @@ void ScanTarget::update(int output_width, int output_height) {
 				}
 			}
 
-			// Upload.
-			const auto buffer_size = lines * sizeof(Line);
-			if(!end_line || end_line > start_line) {
-				test_gl(glBufferSubData, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), &line_buffer_[start_line]);
-			} else {
-				uint8_t *destination = static_cast<uint8_t *>(
-					glMapBufferRange(GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT)
-				);
-				assert(destination);
-				test_gl_error();
-
-				const size_t buffer_length = line_buffer_.size() * sizeof(Line);
-				const size_t start_position = start_line * sizeof(Line);
-				memcpy(&destination[0], &line_buffer_[start_line], buffer_length - start_position);
-				memcpy(&destination[buffer_length - start_position], &line_buffer_[0], end_line * sizeof(Line));
-
-				test_gl(glFlushMappedBufferRange, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size));
-				test_gl(glUnmapBuffer, GL_ARRAY_BUFFER);
+			// Upload, if not already in GPU-visible memory.
+			if(!uses_persistent_mapping_) {
+				const auto buffer_size = lines * sizeof(Line);
+				if(!end_line || end_line > start_line) {
+					test_gl(glBufferSubData, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), &line_buffer_[start_line]);
+				} else {
+					uint8_t *destination = static_cast<uint8_t *>(
+						glMapBufferRange(GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT)
+					);
+					assert(destination);
+					test_gl_error();
+
+					const size_t buffer_length = line_buffer_.size() * sizeof(Line);
+					const size_t start_position = start_line * sizeof(Line);
+					memcpy(&destination[0], &line_buffer_[start_line], buffer_length - start_position);
+					memcpy(&destination[buffer_length - start_position], &line_buffer_[0], end_line * sizeof(Line));
+
+					test_gl(glFlushMappedBufferRange, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size));
+					test_gl(glUnmapBuffer, GL_ARRAY_BUFFER);
+				}
 			}
 
 			// Produce colour information, if required.
@@ -700,7 +854,7 @@ void ScanTarget::update(int output_width, int output_height) {
 
 				test_gl(glDisable, GL_BLEND);
 				test_gl(glDisable, GL_STENCIL_TEST);
-				test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+				draw_instances(start_line, lines, LineBufferHeight);
 
 				accumulation_texture_->bind_framebuffer();
 				output_shader_->bind();
@@ -709,7 +863,7 @@ void ScanTarget::update(int output_width, int output_height) {
 			}
 
 			// Render to the output.
-			test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+			draw_instances(start_line, lines, LineBufferHeight);
 
 			start_line = end_line;
 			new_lines -= lines;
@@ -724,8 +878,20 @@ void ScanTarget::update(int output_width, int output_height) {
 	is_drawing_to_accumulation_buffer_.clear();
 
 	// All data now having been spooled to the GPU, update the read pointers to
-	// the submit pointer location.
-	read_pointers_.store(submit_pointers);
+	// the submit pointer location; if persistently mapped then the GPU may still be
+	// reading from the client's memory, so that is deferred until the fence below is passed.
+	if(uses_persistent_mapping_) {
+		pending_read_pointers_ = submit_pointers;
+	} else {
+		read_pointers_.store(submit_pointers);
+	}
+
+#ifdef GL_TIME_ELAPSED
+	if(timer_query_) {
+		test_gl(glEndQuery, GL_TIME_ELAPSED);
+		timer_query_is_pending_ = true;
+	}
+#endif
 
 	// Grab a fence sync object to avoid busy waiting upon the next extry into this
 	// function, and reset the is_updating_ flag.
@@ -733,6 +899,21 @@ void ScanTarget::update(int output_width, int output_height) {
 	is_updating_.clear();
 }
 
+void ScanTarget::draw_instances(size_t start, size_t count, size_t buffer_size) {
+#ifdef PERSISTENT_MAPPING_AVAILABLE
+	if(uses_persistent_mapping_) {
+		// Draw in place, in two parts if the circular buffer has wrapped.
+		const size_t first_count = std::min(count, buffer_size - start);
+		test_gl(glDrawArraysInstancedBaseInstance, GL_TRIANGLE_STRIP, 0, 4, GLsizei(first_count), GLuint(start));
+		if(first_count < count) {
+			test_gl(glDrawArraysInstancedBaseInstance, GL_TRIANGLE_STRIP, 0, 4, GLsizei(count - first_count), 0);
+		}
+		return;
+	}
+#endif
+	test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(count));
+}
+
 void ScanTarget::draw(int output_width, int output_height) {
 	while(is_drawing_to_accumulation_buffer_.test_and_set());
 
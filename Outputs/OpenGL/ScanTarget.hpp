@@ -49,7 +49,10 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		/*! Processes all the latest input, at a resolution suitable for later output to a framebuffer of the specified size. */
 		void update(int output_width, int output_height);
 
-		/*! @returns The DisplayMetrics object that this ScanTarget has been providing with announcements and draw overages. */
+		/*!
+			@returns The DisplayMetrics object that this ScanTarget has been providing with announcements and draw overages.
+			Its draw budget and recommended quality level can be used to tune and to monitor adaptive quality.
+		*/
 		Metrics &display_metrics();
 
 	private:
@@ -87,6 +90,19 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		int resolution_reduction_level_ = 1;
 		int output_height_ = 0;
 
+		// Adaptive quality: from level 1 reduced filters are used, if the display type has any,
+		// and soft display types then also divide the accumulation resolution by up to four.
+		int quality_level_ = 0;
+		bool uses_reduced_filters_ = false;
+		bool has_reduced_filters();
+		int maximum_quality_level();
+		/// Adopts quality level @c level; @returns @c true if the output shader was rebuilt as a result.
+		bool apply_quality_level(int level);
+
+		// If supported, a timer query measures the GPU cost of each update.
+		GLuint timer_query_ = 0;
+		bool timer_query_is_pending_ = false;
+
 		size_t lines_submitted_ = 0;
 		std::chrono::high_resolution_clock::time_point line_submission_begin_time_;
 
@@ -123,9 +139,17 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		/// A pointer to the first thing not yet submitted for display.
 		std::atomic<PointerSet> read_pointers_;
 
+		/// If buffers are persistently mapped, the pointer that read_pointers_ should adopt
+		/// once the GPU has finished with the most recent update.
+		PointerSet pending_read_pointers_;
+
 		/// Maintains a buffer of the most recent scans.
 		std::array<Scan, 16384> scan_buffer_;
 
+		/// Points to the storage that scans are actually written to; this is either
+		/// scan_buffer_ or, if persistently mapped, the equivalent GPU buffer.
+		Scan *scans_ = nullptr;
+
 		// Maintains a list of composite scan buffer coordinates; the Line struct
 		// is transported to the GPU in its entirety; the LineMetadatas live in CPU
 		// space only.
@@ -145,6 +169,9 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		std::array<Line, LineBufferHeight> line_buffer_;
 		std::array<LineMetadata, LineBufferHeight> line_metadata_buffer_;
 
+		/// Points to the storage that lines are actually written to; as per scans_.
+		Line *lines_ = nullptr;
+
 		// Contains the first composition of scans into lines;
 		// they're accumulated prior to output to allow for continuous
 		// application of any necessary conversions — e.g. composite processing.
@@ -171,14 +198,39 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		GLuint scan_buffer_name_ = 0, scan_vertex_array_ = 0;
 		GLuint line_buffer_name_ = 0, line_vertex_array_ = 0;
 
-		template <typename T> void allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name);
+		/*!
+			Creates a buffer and a vertex array sized to hold @c array. If using persistent mapping, the buffer is
+			created with immutable storage and mapped.
+
+			@returns A pointer to the mapped buffer if using persistent mapping; @c nullptr otherwise.
+		*/
+		template <typename T> void *allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name);
 		template <typename T> void patch_buffer(const T &array, GLuint target, uint16_t submit_pointer, uint16_t read_pointer);
 
-		// Uses a texture to vend write areas.
+		/*!
+			If OpenGL 4.4 or newer is available then the scan and line buffers, and a pixel buffer that sources
+			the write area texture, are persistently mapped; the emulation thread writes directly to GPU-visible
+			memory and nothing is copied per update. Regions are recycled only once the fence that follows the
+			update which consumed them has been passed.
+		*/
+		bool uses_persistent_mapping_ = false;
+
+		/*!
+			Draws @c count instances of a four-vertex triangle strip, using per-instance data starting at @c start within
+			a circular buffer of @c buffer_size entries; if not using persistent mapping then data is instead assumed to
+			have been uploaded to the start of the buffer.
+		*/
+		void draw_instances(size_t start, size_t count, size_t buffer_size);
+
+		// Uses a texture to vend write areas; the texture is sourced from write_area_, which is
+		// either write_area_texture_ or, if persistently mapped, write_area_buffer_name_.
 		std::vector<uint8_t> write_area_texture_;
+		uint8_t *write_area_ = nullptr;
 		size_t data_type_size_ = 0;
 
 		GLuint write_area_texture_name_ = 0;
+		GLuint write_area_buffer_name_ = 0;
+		uint8_t *write_area_buffer_ = nullptr;
 		bool texture_exists_ = false;
 
 		// Ephemeral information for the begin/end functions.
@@ -194,6 +246,7 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		Modals modals_;
 		bool modals_are_dirty_ = false;
 		void setup_pipeline();
+		void setup_output_shader();
 
 		enum class ShaderType {
 			Composition,
@@ -226,7 +279,8 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		std::unique_ptr<Shader> composition_shader() const;
 		/*!
 			Produces a shader that reads from a composition buffer and converts to host
-			output RGB, decoding composite or S-Video as necessary.
+			output RGB, decoding composite or S-Video as necessary. If using reduced filters,
+			fewer RGB and chrominance samples are taken.
 		*/
 		std::unique_ptr<Shader> conversion_shader() const;
 		/*!
@@ -368,6 +368,23 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 		"void main(void) {"
 			"vec3 fragColour3;";
 
+	// Chrominance is averaged across all four QAM samples or, if using reduced filters, just the central two;
+	// both are unpacked from the range [0, 1] that the QAM texture stores.
+	const std::string chrominance =
+		uses_reduced_filters_ ?
+			"vec2 channels = ("
+				"textureLod(qamTextureName, qamTextureCoordinates[1], 0).gb + "
+				"textureLod(qamTextureName, qamTextureCoordinates[2], 0).gb"
+			") - vec2(1.0);"
+		:
+			"vec2 chrominances[4] = vec2[4]("
+				"textureLod(qamTextureName, qamTextureCoordinates[0], 0).gb,"
+				"textureLod(qamTextureName, qamTextureCoordinates[1], 0).gb,"
+				"textureLod(qamTextureName, qamTextureCoordinates[2], 0).gb,"
+				"textureLod(qamTextureName, qamTextureCoordinates[3], 0).gb"
+			");"
+			"vec2 channels = (chrominances[0] + chrominances[1] + chrominances[2] + chrominances[3])*0.5 - vec2(1.0);";
+
 	switch(modals_.display_type) {
 		case DisplayType::CompositeColour:
 			fragment_shader +=
@@ -390,13 +407,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 				"float luminance = dot(samples, vec4(0.25));"
 
 				// Split and average chrominance.
-				"vec2 chrominances[4] = vec2[4]("
-					"textureLod(qamTextureName, qamTextureCoordinates[0], 0).gb,"
-					"textureLod(qamTextureName, qamTextureCoordinates[1], 0).gb,"
-					"textureLod(qamTextureName, qamTextureCoordinates[2], 0).gb,"
-					"textureLod(qamTextureName, qamTextureCoordinates[3], 0).gb"
-				");"
-				"vec2 channels = (chrominances[0] + chrominances[1] + chrominances[2] + chrominances[3])*0.5 - vec2(1.0);"
+				+ chrominance +
 
 				// Apply a colour space conversion to get RGB.
 				"fragColour3 = mix("
@@ -419,6 +430,15 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 		break;
 
 		case DisplayType::RGB:
+			if(uses_reduced_filters_) {
+				fragment_shader +=
+					"fragColour3 = ("
+						"textureLod(textureName, textureCoordinates[1], 0).rgb + "
+						"textureLod(textureName, textureCoordinates[2], 0).rgb"
+					") * 0.5;";
+				break;
+			}
+
 			fragment_shader +=
 				"vec3 samples[4] = vec3[4]("
 					"textureLod(textureName, textureCoordinates[0], 0).rgb,"
@@ -441,14 +461,8 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 				");"
 				"float luminance = dot(samples, vec4(0.15, 0.35, 0.35, 0.25));"
 
-				// Split and average chrominaxnce.
-				"vec2 chrominances[4] = vec2[4]("
-					"textureLod(qamTextureName, qamTextureCoordinates[0], 0).gb,"
-					"textureLod(qamTextureName, qamTextureCoordinates[1], 0).gb,"
-					"textureLod(qamTextureName, qamTextureCoordinates[2], 0).gb,"
-					"textureLod(qamTextureName, qamTextureCoordinates[3], 0).gb"
-				");"
-				"vec2 channels = (chrominances[0] + chrominances[1] + chrominances[2] + chrominances[3])*0.5 - vec2(1.0);"
+				// Split and average chrominance.
+				+ chrominance +
 
 				// Apply a colour space conversion to get RGB.
 				"fragColour3 = lumaChromaToRGB * vec3(luminance, channels);";
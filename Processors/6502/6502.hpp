@@ -13,6 +13,7 @@
 #include <cstdio>
 #include <cstdint>
 
+#include "../IdleLoopDetector.hpp"
 #include "../RegisterSizes.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
 
@@ -112,6 +113,36 @@ class BusHandler {
 			return Cycles(1);
 		}
 
+		/*!
+			Announces that @c cycles have passed during which the 6502 accessed only memory that it was able to
+			satisfy directly through its memory map, without calling perform_bus_operation. This is called only by
+			processors that are in instruction-granular mode, at most once per instruction, plus once before any
+			call to perform_bus_operation so that time is always announced in order. Changes to the interrupt
+			lines made from here are observed from the start of the next instruction.
+
+			Machines should use this to advance any components that they would otherwise have clocked from within
+			perform_bus_operation.
+		*/
+		void perform_direct_cycles(Cycles cycles) {}
+
+		/*!
+			Announces that the 6502 is in an idle loop: a short loop that has run at least twice, each time
+			returning to its start in the same state, taking @c iteration_length and making the same writes.
+			This is called only by processors that have had idle-loop detection enabled, at the start of an
+			iteration.
+
+			Machines may skip any whole number of further iterations for which they know that nothing the loop
+			reads will change, e.g. until the next scheduled interrupt or video event, by advancing their
+			components as if that time had been spent within perform_bus_operation. As all IO is memory mapped,
+			machines should decline if the loop accessed anything other than plain memory.
+
+			@returns The amount of time skipped, which should be a multiple of @c iteration_length and no
+			greater than @c available.
+		*/
+		Cycles skip_idle_loop(Cycles iteration_length, Cycles available) {
+			return Cycles(0);
+		}
+
 		/*!
 			Announces completion of all the cycles supplied to a .run_for request on the 6502. Intended to allow
 			bus handlers to perform any deferred output work.
@@ -196,6 +227,27 @@ class ProcessorBase: public ProcessorStorage {
 			@returns @c true if the 6502 is jammed; @c false otherwise.
 		*/
 		bool is_jammed();
+
+		/*!
+			Supplies the memory map that an instruction-granular processor will use to satisfy accesses directly,
+			without calling the bus handler. Each array should contain one pointer per page; a pointer is to the memory
+			that should be accessed for that page or nullptr if accesses to that page must instead be communicated to
+			the bus handler, e.g. because it contains I/O. The arrays are retained rather than copied, so subsequent
+			changes to their contents take effect immediately.
+
+			Processors that are not instruction-granular ignore the memory map.
+
+			@param read_pages The table that is consulted for reads.
+			@param write_pages The table that is consulted for writes.
+			@param page_size_shift The base-2 logarithm of the page size, e.g. 8 for 256-byte pages.
+		*/
+		void set_memory_map(uint8_t *const *read_pages, uint8_t *const *write_pages, int page_size_shift = 8);
+
+		/*!
+			Enables or disables idle-loop detection; if enabled then the bus handler's @c skip_idle_loop
+			will be called whenever the 6502 appears to be in an idle loop. Detection is disabled by default.
+		*/
+		void set_idle_loop_detection_enabled(bool enabled);
 };
 
 /*!
@@ -205,8 +257,16 @@ class ProcessorBase: public ProcessorStorage {
 	will announce its cycle-by-cycle activity via the bus handler, which is responsible for marrying it to a bus. They
 	can also nominate whether the processor includes support for the ready line. Declining to support the ready line
 	can produce a minor runtime performance improvement.
+
+	Users may also select instruction-granular mode, in which the processor uses the memory map supplied via
+	@c set_memory_map to avoid the bus handler where it can. On an NMOS 6502, any documented instruction that
+	touches only mapped pages — including with its dummy accesses — and that begins with no interrupt pending
+	is performed in a single step rather than cycle by cycle. Any other access that can be satisfied from the
+	memory map is performed directly. The bus handler is told only of the total time spent, once per instruction;
+	accesses to unmapped pages are announced cycle by cycle. This trades intra-instruction timing fidelity for
+	speed, and is intended for non-timing-sensitive workloads.
 */
-template <Personality personality, typename T, bool uses_ready_line> class Processor: public ProcessorBase {
+template <Personality personality, typename T, bool uses_ready_line, bool is_instruction_granular = false> class Processor: public ProcessorBase {
 	public:
 		/*!
 			Constructs an instance of the 6502 that will use @c bus_handler for all bus communications.
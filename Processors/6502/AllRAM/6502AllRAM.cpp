@@ -15,11 +15,18 @@ using namespace CPU::MOS6502;
 
 namespace {
 
-template <Personality personality> class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
+template <Personality personality, bool is_instruction_granular> class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
 	public:
 		ConcreteAllRAMProcessor() :
 			mos6502_(*this) {
 			mos6502_.set_power_on(false);
+
+			if(is_instruction_granular) {
+				for(int c = 0; c < 256; c++) {
+					read_pages_[c] = write_pages_[c] = &memory_[c << 8];
+				}
+				mos6502_.set_memory_map(read_pages_, write_pages_);
+			}
 		}
 
 		inline Cycles perform_bus_operation(BusOperation operation, uint16_t address, uint8_t *value) {
@@ -38,6 +45,15 @@ template <Personality personality> class ConcreteAllRAMProcessor: public AllRAMP
 			return Cycles(1);
 		}
 
+		inline void perform_direct_cycles(Cycles cycles) {
+			timestamp_ += cycles;
+		}
+
+		void did_add_trap_address(uint16_t address) override {
+			// Opcode fetches from this page will need to be checked.
+			read_pages_[address >> 8] = nullptr;
+		}
+
 		void run_for(const Cycles cycles) {
 			mos6502_.run_for(cycles);
 		}
@@ -63,13 +79,18 @@ template <Personality personality> class ConcreteAllRAMProcessor: public AllRAMP
 		}
 
 	private:
-		CPU::MOS6502::Processor<personality, ConcreteAllRAMProcessor, false> mos6502_;
+		CPU::MOS6502::Processor<personality, ConcreteAllRAMProcessor, false, is_instruction_granular> mos6502_;
+		uint8_t *read_pages_[256];
+		uint8_t *write_pages_[256];
 };
 
 }
 
-AllRAMProcessor *AllRAMProcessor::Processor(Personality personality) {
-#define Bind(p) case p: return new ConcreteAllRAMProcessor<p>();
+AllRAMProcessor *AllRAMProcessor::Processor(Personality personality, bool is_instruction_granular) {
+#define Bind(p) case p: \
+	if(is_instruction_granular) return new ConcreteAllRAMProcessor<p, true>();	\
+	return new ConcreteAllRAMProcessor<p, false>();
+
 	switch(personality) {
 		default:
 		Bind(Personality::P6502)
@@ -19,7 +19,12 @@ class AllRAMProcessor:
 	public ::CPU::AllRAMProcessor {
 
 	public:
-		static AllRAMProcessor *Processor(Personality personality);
+		/*!
+			@returns A new AllRAMProcessor with the specified personality. If @c is_instruction_granular
+			is @c true then the processor will operate in instruction-granular mode; all memory other than
+			that on pages that include a trap address will be accessed directly.
+		*/
+		static AllRAMProcessor *Processor(Personality personality, bool is_instruction_granular = false);
 		virtual ~AllRAMProcessor() {}
 
 		virtual void run_for(const Cycles cycles) = 0;
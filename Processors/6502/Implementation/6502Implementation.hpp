@@ -12,7 +12,7 @@
 	6502.hpp, but it's implementation stuff.
 */
 
-template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::run_for(const Cycles cycles) {
+template <Personality personality, typename T, bool uses_ready_line, bool is_instruction_granular> void Processor<personality, T, uses_ready_line, is_instruction_granular>::run_for(const Cycles cycles) {
 	static const MicroOp do_branch[] = {
 		CycleReadFromPC,
 		CycleAddSignedOperandToPC,
@@ -51,17 +51,35 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 		op;\
 	}
 
+	// In instruction-granular mode, time spent on accesses that were satisfied directly
+	// from the memory map is accumulated here and announced to the bus handler en masse.
+	Cycles direct_cycles;
+
+#define flush_direct_cycles() \
+	if(is_instruction_granular && direct_cycles > Cycles(0)) {	\
+		bus_handler_.perform_direct_cycles(direct_cycles);	\
+		direct_cycles = Cycles(0);	\
+	}
+
 #define bus_access() \
 	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::IRQ) | irq_request_history_;	\
 	irq_request_history_ = irq_line_ & inverse_interrupt_flag_;	\
-	number_of_cycles -= bus_handler_.perform_bus_operation(nextBusOperation, busAddress, busValue);	\
+	if(is_instruction_granular && perform_direct_access(nextBusOperation, busAddress, busValue)) {	\
+		++direct_cycles;	\
+		--number_of_cycles;	\
+	} else {	\
+		flush_direct_cycles();	\
+		number_of_cycles -= bus_handler_.perform_bus_operation(nextBusOperation, busAddress, busValue);	\
+	}	\
 	nextBusOperation = BusOperation::None;	\
 	if(number_of_cycles <= Cycles(0)) break;
 
 	checkSchedule();
 	Cycles number_of_cycles = cycles + cycles_left_to_run_;
+	idle_loop_detector_.did_extend_run(cycles.as_integral());
 
 	while(number_of_cycles > Cycles(0)) {
+		flush_direct_cycles();
 
 		// Deal with a potential RDY state, if this 6502 has anything connected to ready.
 		while(uses_ready_line && ready_is_active_ && number_of_cycles > Cycles(0)) {
@@ -102,7 +120,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 #define read_op(val, addr)		nextBusOperation = BusOperation::ReadOpcode;	busAddress = addr;		busValue = &val;				val = 0xff
 #define read_mem(val, addr)		nextBusOperation = BusOperation::Read;			busAddress = addr;		busValue = &val;				val	= 0xff
 #define throwaway_read(addr)	nextBusOperation = BusOperation::Read;			busAddress = addr;		busValue = &throwaway_target;	throwaway_target = 0xff
-#define write_mem(val, addr)	nextBusOperation = BusOperation::Write;			busAddress = addr;		busValue = &val
+#define write_mem(val, addr)	nextBusOperation = BusOperation::Write;			busAddress = addr;		busValue = &val;	idle_loop_detector_.did_write(addr, val)
 
 				switch(cycle) {
 
@@ -138,6 +156,41 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 					case OperationMoveToNextProgram:
 						scheduled_program_counter_ = nullptr;
+						while(true) {
+							flush_direct_cycles();
+
+							// If this is the start of an idle loop, offer the bus handler the chance to skip some of it.
+							if(
+								idle_loop_detector_.is_enabled() &&
+								!interrupt_requests_ && !irq_request_history_ && !(irq_line_ & inverse_interrupt_flag_)
+							) {
+								const int64_t iteration_length = idle_loop_detector_.did_begin_instruction(
+									pc_.full,
+									IdleLoopDetector::signature({a_, x_, y_, s_, get_flags()}),
+									number_of_cycles.as_integral());
+								if(iteration_length) {
+									const Cycles skipped = bus_handler_.skip_idle_loop(Cycles(iteration_length), number_of_cycles);
+									number_of_cycles -= skipped;
+									idle_loop_detector_.did_skip(skipped.as_integral());
+								}
+							}
+
+							// In instruction-granular mode, perform the next instruction in one step if possible.
+							// That requires an NMOS part, no interrupt pending or about to be, no use of the ready
+							// line and enough time remaining to complete even the longest instruction.
+							if(
+								!is_instruction_granular || is_65c02(personality) ||
+								(uses_ready_line && ready_line_is_enabled_) ||
+								interrupt_requests_ || irq_request_history_ || (irq_line_ & inverse_interrupt_flag_) ||
+								number_of_cycles <= Cycles(7)
+							) break;
+
+							const int instruction_length = perform_direct_instruction(has_decimal_mode(personality));
+							if(!instruction_length) break;
+							number_of_cycles -= Cycles(instruction_length);
+							direct_cycles += Cycles(instruction_length);
+						}
+
 						checkSchedule();
 					continue;
 
@@ -306,23 +359,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 						operand_++;			// deliberate fallthrough
 					case OperationSBC:
 						if(decimal_flag_ && has_decimal_mode(personality)) {
-							const uint16_t notCarry = carry_flag_ ^ 0x1;
-							const uint16_t decimalResult = static_cast<uint16_t>(a_) - static_cast<uint16_t>(operand_) - notCarry;
-							uint16_t temp16;
-
-							temp16 = (a_&0xf) - (operand_&0xf) - notCarry;
-							if(temp16 > 0xf) temp16 -= 0x6;
-							temp16 = (temp16&0x0f) | ((temp16 > 0x0f) ? 0xfff0 : 0x00);
-							temp16 += (a_&0xf0) - (operand_&0xf0);
-
-							overflow_flag_ = ( ( (decimalResult^a_)&(~decimalResult^operand_) )&0x80) >> 1;
-							negative_result_ = static_cast<uint8_t>(temp16);
-							zero_result_ = static_cast<uint8_t>(decimalResult);
-
-							if(temp16 > 0xff) temp16 -= 0x60;
-
-							carry_flag_ = (temp16 > 0xff) ? 0 : Flag::Carry;
-							a_ = static_cast<uint8_t>(temp16);
+							subtract_decimal(operand_);
 
 							if(is_65c02(personality)) {
 								negative_result_ = zero_result_ = a_;
@@ -337,18 +374,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 					// deliberate fallthrough
 					case OperationADC:
 						if(decimal_flag_ && has_decimal_mode(personality)) {
-							const uint16_t decimalResult = static_cast<uint16_t>(a_) + static_cast<uint16_t>(operand_) + static_cast<uint16_t>(carry_flag_);
-
-							uint8_t low_nibble = (a_ & 0xf) + (operand_ & 0xf) + carry_flag_;
-							if(low_nibble >= 0xa) low_nibble = ((low_nibble + 0x6) & 0xf) + 0x10;
-							uint16_t result = static_cast<uint16_t>(a_ & 0xf0) + static_cast<uint16_t>(operand_ & 0xf0) + static_cast<uint16_t>(low_nibble);
-							negative_result_ = static_cast<uint8_t>(result);
-							overflow_flag_ = (( (result^a_)&(result^operand_) )&0x80) >> 1;
-							if(result >= 0xa0) result += 0x60;
-
-							carry_flag_ = (result >> 8) ? 1 : 0;
-							a_ = static_cast<uint8_t>(result);
-							zero_result_ = static_cast<uint8_t>(decimalResult);
+							add_decimal(operand_);
 
 							if(is_65c02(personality)) {
 								negative_result_ = zero_result_ = a_;
@@ -356,10 +382,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 								break;
 							}
 						} else {
-							const uint16_t result = static_cast<uint16_t>(a_) + static_cast<uint16_t>(operand_) + static_cast<uint16_t>(carry_flag_);
-							overflow_flag_ = (( (result^a_)&(result^operand_) )&0x80) >> 1;
-							negative_result_ = zero_result_ = a_ = static_cast<uint8_t>(result);
-							carry_flag_ = (result >> 8)&1;
+							add_binary(operand_);
 						}
 
 						// fix up in case this was INS
@@ -687,10 +710,13 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 	bus_address_ = busAddress;
 	bus_value_ = busValue;
 
+	flush_direct_cycles();
 	bus_handler_.flush();
+
+#undef flush_direct_cycles
 }
 
-template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::set_ready_line(bool active) {
+template <Personality personality, typename T, bool uses_ready_line, bool is_instruction_granular> void Processor<personality, T, uses_ready_line, is_instruction_granular>::set_ready_line(bool active) {
 	assert(uses_ready_line);
 	if(active) {
 		ready_line_is_enabled_ = true;
@@ -730,6 +756,27 @@ void ProcessorBase::set_nmi_line(bool active) {
 	nmi_line_is_enabled_ = active;
 }
 
+bool ProcessorStorage::perform_direct_access(BusOperation operation, uint16_t address, uint8_t *value) {
+	if(!read_pages_) return false;
+
+	if(isReadOperation(operation)) {
+		uint8_t *const page = read_pages_[address >> page_size_shift_];
+		if(!page) return false;
+		*value = page[address & page_offset_mask_];
+		return true;
+	}
+
+	if(operation == BusOperation::Write) {
+		uint8_t *const page = write_pages_[address >> page_size_shift_];
+		if(!page) return false;
+		page[address & page_offset_mask_] = *value;
+		return true;
+	}
+
+	// Anything else, e.g. a Ready or None cycle, is the bus handler's business.
+	return false;
+}
+
 inline const ProcessorStorage::MicroOp *ProcessorStorage::get_reset_program() {
 	static const MicroOp reset[] = {
 		CycleFetchOperand,
@@ -784,6 +831,48 @@ uint8_t ProcessorStorage::get_flags() {
 	return carry_flag_ | overflow_flag_ | (inverse_interrupt_flag_ ^ Flag::Interrupt) | (negative_result_ & 0x80) | (zero_result_ ? 0 : Flag::Zero) | Flag::Always | decimal_flag_;
 }
 
+void ProcessorStorage::add_binary(uint8_t operand) {
+	const uint16_t result = static_cast<uint16_t>(a_) + static_cast<uint16_t>(operand) + static_cast<uint16_t>(carry_flag_);
+	overflow_flag_ = (( (result^a_)&(result^operand) )&0x80) >> 1;
+	negative_result_ = zero_result_ = a_ = static_cast<uint8_t>(result);
+	carry_flag_ = (result >> 8)&1;
+}
+
+void ProcessorStorage::add_decimal(uint8_t operand) {
+	const uint16_t decimalResult = static_cast<uint16_t>(a_) + static_cast<uint16_t>(operand) + static_cast<uint16_t>(carry_flag_);
+
+	uint8_t low_nibble = (a_ & 0xf) + (operand & 0xf) + carry_flag_;
+	if(low_nibble >= 0xa) low_nibble = ((low_nibble + 0x6) & 0xf) + 0x10;
+	uint16_t result = static_cast<uint16_t>(a_ & 0xf0) + static_cast<uint16_t>(operand & 0xf0) + static_cast<uint16_t>(low_nibble);
+	negative_result_ = static_cast<uint8_t>(result);
+	overflow_flag_ = (( (result^a_)&(result^operand) )&0x80) >> 1;
+	if(result >= 0xa0) result += 0x60;
+
+	carry_flag_ = (result >> 8) ? 1 : 0;
+	a_ = static_cast<uint8_t>(result);
+	zero_result_ = static_cast<uint8_t>(decimalResult);
+}
+
+void ProcessorStorage::subtract_decimal(uint8_t operand) {
+	const uint16_t notCarry = carry_flag_ ^ 0x1;
+	const uint16_t decimalResult = static_cast<uint16_t>(a_) - static_cast<uint16_t>(operand) - notCarry;
+	uint16_t temp16;
+
+	temp16 = (a_&0xf) - (operand&0xf) - notCarry;
+	if(temp16 > 0xf) temp16 -= 0x6;
+	temp16 = (temp16&0x0f) | ((temp16 > 0x0f) ? 0xfff0 : 0x00);
+	temp16 += (a_&0xf0) - (operand&0xf0);
+
+	overflow_flag_ = ( ( (decimalResult^a_)&(~decimalResult^operand) )&0x80) >> 1;
+	negative_result_ = static_cast<uint8_t>(temp16);
+	zero_result_ = static_cast<uint8_t>(decimalResult);
+
+	if(temp16 > 0xff) temp16 -= 0x60;
+
+	carry_flag_ = (temp16 > 0xff) ? 0 : Flag::Carry;
+	a_ = static_cast<uint8_t>(temp16);
+}
+
 void ProcessorStorage::set_flags(uint8_t flags) {
 	carry_flag_				= flags		& Flag::Carry;
 	negative_result_		= flags		& Flag::Sign;
@@ -8,7 +8,9 @@
 
 #include "../6502.hpp"
 
+#include <array>
 #include <cstring>
+#include <utility>
 
 using namespace CPU::MOS6502;
 
@@ -385,3 +387,515 @@ ProcessorStorage::ProcessorStorage(Personality personality) {
 	}
 #undef Install
 }
+
+// MARK: - Whole-instruction execution
+
+#undef Absolute
+#undef AbsoluteX
+#undef AbsoluteY
+#undef Zero
+#undef ZeroX
+#undef ZeroY
+#undef IndexedIndirect
+#undef IndirectIndexed
+
+const ProcessorStorage::DirectInstruction *ProcessorStorage::direct_instructions() {
+	using Mode = DirectInstruction::Mode;
+	using Access = DirectInstruction::Access;
+
+	static const auto instructions = [] {
+		std::array<DirectInstruction, 256> table;
+
+		// The arithmetic and logical group: opcodes of the form aaabbb01, in which bbb selects the addressing mode.
+		const Mode group_one_modes[] = {
+			Mode::IndexedIndirect,	Mode::Zero,		Mode::Immediate,	Mode::Absolute,
+			Mode::IndirectIndexed,	Mode::ZeroX,	Mode::AbsoluteY,	Mode::AbsoluteX
+		};
+		const MicroOp group_one_operations[] = {
+			OperationORA,	OperationAND,	OperationEOR,	OperationADC,
+			OperationSTA,	OperationLDA,	OperationCMP,	OperationSBC
+		};
+		for(int operation = 0; operation < 8; ++operation) {
+			for(int mode = 0; mode < 8; ++mode) {
+				const bool is_store = group_one_operations[operation] == OperationSTA;
+				if(is_store && group_one_modes[mode] == Mode::Immediate) continue;
+
+				table[(operation << 5) | (mode << 2) | 1] = {
+					group_one_modes[mode],
+					is_store ? Access::Write : Access::Read,
+					group_one_operations[operation]
+				};
+			}
+		}
+
+		// Shifts and rotates, plus INC and DEC: opcodes of the form aaabbb10.
+		const MicroOp shift_operations[] = {OperationASL, OperationROL, OperationLSR, OperationROR};
+		for(int operation = 0; operation < 4; ++operation) {
+			const int base = operation << 5;
+			table[base | 0x06] = {Mode::Zero,			Access::ReadModifyWrite,	shift_operations[operation]};
+			table[base | 0x0a] = {Mode::Accumulator,	Access::ReadModifyWrite,	shift_operations[operation]};
+			table[base | 0x0e] = {Mode::Absolute,		Access::ReadModifyWrite,	shift_operations[operation]};
+			table[base | 0x16] = {Mode::ZeroX,			Access::ReadModifyWrite,	shift_operations[operation]};
+			table[base | 0x1e] = {Mode::AbsoluteX,		Access::ReadModifyWrite,	shift_operations[operation]};
+		}
+		for(const auto &operation: {std::make_pair(0xc0, OperationDEC), std::make_pair(0xe0, OperationINC)}) {
+			table[operation.first | 0x06] = {Mode::Zero,		Access::ReadModifyWrite,	operation.second};
+			table[operation.first | 0x0e] = {Mode::Absolute,	Access::ReadModifyWrite,	operation.second};
+			table[operation.first | 0x16] = {Mode::ZeroX,		Access::ReadModifyWrite,	operation.second};
+			table[operation.first | 0x1e] = {Mode::AbsoluteX,	Access::ReadModifyWrite,	operation.second};
+		}
+
+		// Index register loads, stores and comparisons, and BIT.
+		table[0x86] = {Mode::Zero,		Access::Write,	OperationSTX};
+		table[0x8e] = {Mode::Absolute,	Access::Write,	OperationSTX};
+		table[0x96] = {Mode::ZeroY,		Access::Write,	OperationSTX};
+		table[0x84] = {Mode::Zero,		Access::Write,	OperationSTY};
+		table[0x8c] = {Mode::Absolute,	Access::Write,	OperationSTY};
+		table[0x94] = {Mode::ZeroX,		Access::Write,	OperationSTY};
+
+		table[0xa2] = {Mode::Immediate,	Access::Read,	OperationLDX};
+		table[0xa6] = {Mode::Zero,		Access::Read,	OperationLDX};
+		table[0xae] = {Mode::Absolute,	Access::Read,	OperationLDX};
+		table[0xb6] = {Mode::ZeroY,		Access::Read,	OperationLDX};
+		table[0xbe] = {Mode::AbsoluteY,	Access::Read,	OperationLDX};
+		table[0xa0] = {Mode::Immediate,	Access::Read,	OperationLDY};
+		table[0xa4] = {Mode::Zero,		Access::Read,	OperationLDY};
+		table[0xac] = {Mode::Absolute,	Access::Read,	OperationLDY};
+		table[0xb4] = {Mode::ZeroX,		Access::Read,	OperationLDY};
+		table[0xbc] = {Mode::AbsoluteX,	Access::Read,	OperationLDY};
+
+		table[0xe0] = {Mode::Immediate,	Access::Read,	OperationCPX};
+		table[0xe4] = {Mode::Zero,		Access::Read,	OperationCPX};
+		table[0xec] = {Mode::Absolute,	Access::Read,	OperationCPX};
+		table[0xc0] = {Mode::Immediate,	Access::Read,	OperationCPY};
+		table[0xc4] = {Mode::Zero,		Access::Read,	OperationCPY};
+		table[0xcc] = {Mode::Absolute,	Access::Read,	OperationCPY};
+
+		table[0x24] = {Mode::Zero,		Access::Read,	OperationBIT};
+		table[0x2c] = {Mode::Absolute,	Access::Read,	OperationBIT};
+
+		// Single-byte operations.
+		table[0x18] = {Mode::Implied, Access::None, OperationCLC};
+		table[0x38] = {Mode::Implied, Access::None, OperationSEC};
+		table[0x58] = {Mode::Implied, Access::None, OperationCLI};
+		table[0x78] = {Mode::Implied, Access::None, OperationSEI};
+		table[0xb8] = {Mode::Implied, Access::None, OperationCLV};
+		table[0xd8] = {Mode::Implied, Access::None, OperationCLD};
+		table[0xf8] = {Mode::Implied, Access::None, OperationSED};
+		table[0x88] = {Mode::Implied, Access::None, OperationDEY};
+		table[0xc8] = {Mode::Implied, Access::None, OperationINY};
+		table[0xca] = {Mode::Implied, Access::None, OperationDEX};
+		table[0xe8] = {Mode::Implied, Access::None, OperationINX};
+		table[0x8a] = {Mode::Implied, Access::None, OperationTXA};
+		table[0x98] = {Mode::Implied, Access::None, OperationTYA};
+		table[0x9a] = {Mode::Implied, Access::None, OperationTXS};
+		table[0xa8] = {Mode::Implied, Access::None, OperationTAY};
+		table[0xaa] = {Mode::Implied, Access::None, OperationTAX};
+		table[0xba] = {Mode::Implied, Access::None, OperationTSX};
+		table[0xea] = {Mode::Implied};
+
+		// Branches.
+		table[0x10] = {Mode::Relative, Access::None, OperationBPL};
+		table[0x30] = {Mode::Relative, Access::None, OperationBMI};
+		table[0x50] = {Mode::Relative, Access::None, OperationBVC};
+		table[0x70] = {Mode::Relative, Access::None, OperationBVS};
+		table[0x90] = {Mode::Relative, Access::None, OperationBCC};
+		table[0xb0] = {Mode::Relative, Access::None, OperationBCS};
+		table[0xd0] = {Mode::Relative, Access::None, OperationBNE};
+		table[0xf0] = {Mode::Relative, Access::None, OperationBEQ};
+
+		// Stack use and flow control.
+		table[0x00] = {Mode::BRK};
+		table[0x20] = {Mode::JSR};
+		table[0x40] = {Mode::RTI};
+		table[0x60] = {Mode::RTS};
+		table[0x4c] = {Mode::JMP};
+		table[0x6c] = {Mode::JMPIndirect};
+		table[0x48] = {Mode::PHA};
+		table[0x08] = {Mode::PHP};
+		table[0x68] = {Mode::PLA};
+		table[0x28] = {Mode::PLP};
+
+		return table;
+	}();
+
+	return instructions.data();
+}
+
+int ProcessorStorage::perform_direct_instruction(bool has_decimal_mode) {
+	using Mode = DirectInstruction::Mode;
+	using Access = DirectInstruction::Access;
+
+	if(!read_pages_) return 0;
+
+	// Every instruction reads at least its operation and the byte after it.
+	const uint16_t operation_address = pc_.full;
+	const uint16_t operand_address = static_cast<uint16_t>(operation_address + 1);
+	if(!read_page(operation_address) || !read_page(operand_address)) return 0;
+
+	const uint8_t operation = read_direct(operation_address);
+	const DirectInstruction &instruction = direct_instructions()[operation];
+	if(instruction.mode == Mode::None) return 0;
+	const uint8_t operand = read_direct(operand_address);
+	const uint16_t following_address = static_cast<uint16_t>(operation_address + 2);
+
+	// Until all of the pages that the instruction will access have been checked, no state may be modified.
+	// cycles counts the bus accesses the instruction will make, and next_pc is the value the PC will end with.
+	int cycles = 2;
+	uint16_t next_pc = following_address;
+	uint16_t address = 0;
+
+	// NMOS indexing: a dummy read from the uncorrected address occurs if a page boundary is crossed,
+	// and always for anything other than a read.
+	const auto index = [&](uint16_t base, uint8_t offset) {
+		address = static_cast<uint16_t>(base + offset);
+		const uint16_t uncorrected = static_cast<uint16_t>((base & 0xff00) | (address & 0x00ff));
+		if(uncorrected != address || instruction.access != Access::Read) {
+			if(!read_page(uncorrected)) return false;
+			++cycles;
+		}
+		return true;
+	};
+	const auto stack = [this](int offset) {
+		return static_cast<uint16_t>(0x100 | static_cast<uint8_t>(s_ + offset));
+	};
+
+	switch(instruction.mode) {
+		case Mode::None: return 0;
+
+		// MARK: Addressing modes.
+
+		case Mode::Implied:
+		case Mode::Accumulator:
+			next_pc = operand_address;
+		break;
+
+		case Mode::Immediate:
+			// Treat the operand as if it were read from the address it was fetched from.
+			address = operand_address;
+			cycles = 1;
+		break;
+
+		case Mode::Zero:
+			address = operand;
+		break;
+
+		case Mode::ZeroX:
+		case Mode::ZeroY:
+			// There's a dummy read from the unindexed address.
+			if(!read_page(operand)) return 0;
+			address = static_cast<uint8_t>(operand + ((instruction.mode == Mode::ZeroX) ? x_ : y_));
+			++cycles;
+		break;
+
+		case Mode::Absolute:
+		case Mode::AbsoluteX:
+		case Mode::AbsoluteY: {
+			if(!read_page(following_address)) return 0;
+			address = static_cast<uint16_t>(operand | (read_direct(following_address) << 8));
+			next_pc = static_cast<uint16_t>(operation_address + 3);
+			++cycles;
+
+			if(instruction.mode == Mode::AbsoluteX && !index(address, x_)) return 0;
+			if(instruction.mode == Mode::AbsoluteY && !index(address, y_)) return 0;
+		} break;
+
+		case Mode::IndexedIndirect: {
+			// There's a dummy read from the unindexed zero-page address.
+			const uint8_t pointer = static_cast<uint8_t>(operand + x_);
+			const uint8_t pointer_high = static_cast<uint8_t>(pointer + 1);
+			if(!read_page(operand) || !read_page(pointer) || !read_page(pointer_high)) return 0;
+			address = static_cast<uint16_t>(read_direct(pointer) | (read_direct(pointer_high) << 8));
+			cycles += 3;
+		} break;
+
+		case Mode::IndirectIndexed: {
+			const uint8_t pointer_high = static_cast<uint8_t>(operand + 1);
+			if(!read_page(operand) || !read_page(pointer_high)) return 0;
+			cycles += 2;
+			if(!index(static_cast<uint16_t>(read_direct(operand) | (read_direct(pointer_high) << 8)), y_)) return 0;
+		} break;
+
+		// MARK: Branches.
+
+		case Mode::Relative: {
+			bool is_taken = false;
+			switch(instruction.operation) {
+				default: break;
+				case OperationBPL: is_taken = !(negative_result_&0x80);	break;
+				case OperationBMI: is_taken = negative_result_&0x80;	break;
+				case OperationBVC: is_taken = !overflow_flag_;			break;
+				case OperationBVS: is_taken = overflow_flag_;			break;
+				case OperationBCC: is_taken = !carry_flag_;				break;
+				case OperationBCS: is_taken = carry_flag_;				break;
+				case OperationBNE: is_taken = zero_result_;				break;
+				case OperationBEQ: is_taken = !zero_result_;			break;
+			}
+
+			if(is_taken) {
+				// A taken branch reads from the next PC, then also from the half-updated PC if it crosses a page.
+				if(!read_page(next_pc)) return 0;
+				++cycles;
+
+				const uint16_t target = static_cast<uint16_t>(next_pc + static_cast<int8_t>(operand));
+				if((target ^ next_pc) & 0xff00) {
+					if(!read_page(static_cast<uint16_t>((next_pc & 0xff00) | (target & 0x00ff)))) return 0;
+					++cycles;
+				}
+				next_pc = target;
+			}
+		} break;
+
+		// MARK: Flow control.
+
+		case Mode::JMP:
+			if(!read_page(following_address)) return 0;
+			next_pc = static_cast<uint16_t>(operand | (read_direct(following_address) << 8));
+			cycles = 3;
+		break;
+
+		case Mode::JMPIndirect: {
+			if(!read_page(following_address)) return 0;
+			const uint16_t pointer = static_cast<uint16_t>(operand | (read_direct(following_address) << 8));
+
+			// The NMOS 6502 doesn't carry into the high byte of the pointer.
+			const uint16_t pointer_high = static_cast<uint16_t>((pointer & 0xff00) | ((pointer + 1) & 0x00ff));
+			if(!read_page(pointer) || !read_page(pointer_high)) return 0;
+			next_pc = static_cast<uint16_t>(read_direct(pointer) | (read_direct(pointer_high) << 8));
+			cycles = 5;
+		} break;
+
+		case Mode::JSR:
+			// The return address is pushed before the high byte of the target is read.
+			if(
+				!read_page(following_address) ||
+				!read_page(stack(0)) || !write_page(stack(0)) || !write_page(stack(-1))
+			) return 0;
+			write_direct(stack(0), following_address >> 8);
+			write_direct(stack(-1), following_address & 0xff);
+			s_ -= 2;
+			next_pc = static_cast<uint16_t>(operand | (read_direct(following_address) << 8));
+			cycles = 6;
+		break;
+
+		case Mode::RTS: {
+			if(!read_page(stack(0)) || !read_page(stack(1)) || !read_page(stack(2))) return 0;
+			const uint16_t return_address = static_cast<uint16_t>(read_direct(stack(1)) | (read_direct(stack(2)) << 8));
+
+			// There's a dummy read from the return address before it is incremented.
+			if(!read_page(return_address)) return 0;
+			s_ += 2;
+			next_pc = static_cast<uint16_t>(return_address + 1);
+			cycles = 6;
+		} break;
+
+		case Mode::RTI:
+			// The flags are restored ahead of the final two accesses, so if the IRQ line is active then
+			// they may cause an interrupt to be signalled; leave that to be handled cycle by cycle.
+			if(irq_line_) return 0;
+			if(!read_page(stack(0)) || !read_page(stack(1)) || !read_page(stack(2)) || !read_page(stack(3))) return 0;
+			set_flags(read_direct(stack(1)));
+			next_pc = static_cast<uint16_t>(read_direct(stack(2)) | (read_direct(stack(3)) << 8));
+			s_ += 3;
+			cycles = 6;
+		break;
+
+		case Mode::BRK:
+			if(
+				!write_page(stack(0)) || !write_page(stack(-1)) || !write_page(stack(-2)) ||
+				!read_page(0xfffe) || !read_page(0xffff)
+			) return 0;
+			write_direct(stack(0), following_address >> 8);
+			write_direct(stack(-1), following_address & 0xff);
+			write_direct(stack(-2), get_flags() | Flag::Break);
+			s_ -= 3;
+			inverse_interrupt_flag_ = 0;
+			next_pc = static_cast<uint16_t>(read_direct(0xfffe) | (read_direct(0xffff) << 8));
+			cycles = 7;
+		break;
+
+		// MARK: Stack.
+
+		case Mode::PHA:
+		case Mode::PHP:
+			if(!write_page(stack(0))) return 0;
+			write_direct(stack(0), (instruction.mode == Mode::PHA) ? a_ : (get_flags() | Flag::Break));
+			--s_;
+			next_pc = operand_address;
+			cycles = 3;
+		break;
+
+		case Mode::PLA:
+		case Mode::PLP: {
+			// There's a dummy read from the stack before it is pulled from.
+			if(!read_page(stack(0)) || !read_page(stack(1))) return 0;
+			const uint8_t value = read_direct(stack(1));
+			if(instruction.mode == Mode::PLA) {
+				a_ = negative_result_ = zero_result_ = value;
+			} else {
+				set_flags(value);
+			}
+			++s_;
+			next_pc = operand_address;
+			cycles = 4;
+		} break;
+	}
+
+	// Check that the data access, if any, is possible.
+	switch(instruction.access) {
+		case Access::None: break;
+
+		case Access::Read:
+			if(!read_page(address)) return 0;
+			++cycles;
+		break;
+
+		case Access::Write:
+			if(!write_page(address)) return 0;
+			++cycles;
+		break;
+
+		case Access::ReadModifyWrite:
+			if(instruction.mode == Mode::Accumulator) break;
+
+			// A read, then a write of the unmodified value, then a write of the result.
+			if(!read_page(address) || !write_page(address)) return 0;
+			cycles += 3;
+		break;
+	}
+
+	// Perform the operation.
+	uint8_t value = 0;
+	switch(instruction.access) {
+		case Access::None:
+		case Access::Write:
+		break;
+
+		case Access::Read:
+			value = read_direct(address);
+		break;
+
+		case Access::ReadModifyWrite:
+			if(instruction.mode == Mode::Accumulator) {
+				value = a_;
+			} else {
+				value = read_direct(address);
+				write_direct(address, value);
+			}
+		break;
+	}
+
+	switch(instruction.operation) {
+		default: break;
+
+		case OperationORA:	a_ |= value;	negative_result_ = zero_result_ = a_;	break;
+		case OperationAND:	a_ &= value;	negative_result_ = zero_result_ = a_;	break;
+		case OperationEOR:	a_ ^= value;	negative_result_ = zero_result_ = a_;	break;
+
+		case OperationLDA:	a_ = negative_result_ = zero_result_ = value;			break;
+		case OperationLDX:	x_ = negative_result_ = zero_result_ = value;			break;
+		case OperationLDY:	y_ = negative_result_ = zero_result_ = value;			break;
+
+		case OperationSTA:	value = a_;		break;
+		case OperationSTX:	value = x_;		break;
+		case OperationSTY:	value = y_;		break;
+
+		case OperationADC:
+			if(decimal_flag_ && has_decimal_mode) {
+				add_decimal(value);
+			} else {
+				add_binary(value);
+			}
+		break;
+		case OperationSBC:
+			if(decimal_flag_ && has_decimal_mode) {
+				subtract_decimal(value);
+			} else {
+				add_binary(static_cast<uint8_t>(~value));
+			}
+		break;
+
+		case OperationCMP:
+		case OperationCPX:
+		case OperationCPY: {
+			const uint8_t source =
+				(instruction.operation == OperationCMP) ? a_ :
+				(instruction.operation == OperationCPX) ? x_ : y_;
+			const uint16_t temp16 = source - value;
+			negative_result_ = zero_result_ = static_cast<uint8_t>(temp16);
+			carry_flag_ = ((~temp16) >> 8)&1;
+		} break;
+
+		case OperationBIT:
+			zero_result_ = value & a_;
+			negative_result_ = value;
+			overflow_flag_ = value&Flag::Overflow;
+		break;
+
+		case OperationASL:
+			carry_flag_ = value >> 7;
+			value <<= 1;
+			negative_result_ = zero_result_ = value;
+		break;
+		case OperationROL: {
+			const uint8_t temp8 = static_cast<uint8_t>((value << 1) | carry_flag_);
+			carry_flag_ = value >> 7;
+			value = negative_result_ = zero_result_ = temp8;
+		} break;
+		case OperationLSR:
+			carry_flag_ = value & 1;
+			value >>= 1;
+			negative_result_ = zero_result_ = value;
+		break;
+		case OperationROR: {
+			const uint8_t temp8 = static_cast<uint8_t>((value >> 1) | (carry_flag_ << 7));
+			carry_flag_ = value & 1;
+			value = negative_result_ = zero_result_ = temp8;
+		} break;
+		case OperationINC:	++value;	negative_result_ = zero_result_ = value;	break;
+		case OperationDEC:	--value;	negative_result_ = zero_result_ = value;	break;
+
+		case OperationCLC: carry_flag_ = 0;								break;
+		case OperationCLI: inverse_interrupt_flag_ = Flag::Interrupt;	break;
+		case OperationCLV: overflow_flag_ = 0;							break;
+		case OperationCLD: decimal_flag_ = 0;							break;
+		case OperationSEC: carry_flag_ = Flag::Carry;					break;
+		case OperationSEI: inverse_interrupt_flag_ = 0;					break;
+		case OperationSED: decimal_flag_ = Flag::Decimal;				break;
+
+		case OperationINX: ++x_; negative_result_ = zero_result_ = x_;	break;
+		case OperationDEX: --x_; negative_result_ = zero_result_ = x_;	break;
+		case OperationINY: ++y_; negative_result_ = zero_result_ = y_;	break;
+		case OperationDEY: --y_; negative_result_ = zero_result_ = y_;	break;
+
+		case OperationTXA: zero_result_ = negative_result_ = a_ = x_;	break;
+		case OperationTYA: zero_result_ = negative_result_ = a_ = y_;	break;
+		case OperationTXS: s_ = x_;										break;
+		case OperationTAY: zero_result_ = negative_result_ = y_ = a_;	break;
+		case OperationTAX: zero_result_ = negative_result_ = x_ = a_;	break;
+		case OperationTSX: zero_result_ = negative_result_ = x_ = s_;	break;
+	}
+
+	switch(instruction.access) {
+		case Access::None:
+		case Access::Read:
+		break;
+
+		case Access::Write:
+			write_direct(address, value);
+		break;
+
+		case Access::ReadModifyWrite:
+			if(instruction.mode == Mode::Accumulator) {
+				a_ = value;
+			} else {
+				write_direct(address, value);
+			}
+		break;
+	}
+
+	last_operation_pc_.full = operation_address;
+	operation_ = operation;
+	pc_.full = next_pc;
+	return cycles;
+}
@@ -241,6 +241,21 @@ class ProcessorStorage {
 		*/
 		inline void set_flags(uint8_t flags);
 
+		/*!
+			Performs a binary-mode ADC of @c operand into a_, setting the negative, zero, carry and overflow flags.
+		*/
+		inline void add_binary(uint8_t operand);
+
+		/*!
+			Performs a decimal-mode ADC of @c operand into a_, setting flags as an NMOS 6502 would.
+		*/
+		inline void add_decimal(uint8_t operand);
+
+		/*!
+			Performs a decimal-mode SBC of @c operand from a_, setting flags as an NMOS 6502 would.
+		*/
+		inline void subtract_decimal(uint8_t operand);
+
 		bool is_jammed_ = false;
 		Cycles cycles_left_to_run_;
 
@@ -261,6 +276,39 @@ class ProcessorStorage {
 		uint8_t irq_line_ = 0, irq_request_history_ = 0;
 		bool nmi_line_is_enabled_ = false, set_overflow_line_is_enabled_ = false;
 
+		/*
+			The memory map, as used in instruction-granular mode only.
+		*/
+		uint8_t *const *read_pages_ = nullptr;
+		uint8_t *const *write_pages_ = nullptr;
+		int page_size_shift_ = 8;
+		uint16_t page_offset_mask_ = 0xff;
+
+		/*!
+			Attempts to perform the nominated bus operation via the memory map.
+
+			@returns @c true if the operation was performed; @c false if it must be
+			communicated to the bus handler.
+		*/
+		inline bool perform_direct_access(BusOperation operation, uint16_t address, uint8_t *value);
+
+		/*!
+			Attempts to perform the whole of the next instruction via the memory map. This is possible only
+			for the documented NMOS opcodes, and only if every address the instruction would access, including
+			those of its dummy accesses, is mapped. The caller is responsible for ensuring that no interrupt
+			is pending or could be signalled during the instruction.
+
+			@param has_decimal_mode @c true if ADC and SBC should obey the decimal flag; @c false otherwise.
+			@returns The number of cycles the instruction took, or 0 if it was not performed, in which
+			case no state has been changed.
+		*/
+		int perform_direct_instruction(bool has_decimal_mode);
+
+		/*
+			Idle-loop detection, if enabled.
+		*/
+		IdleLoopDetector idle_loop_detector_;
+
 		/*!
 			Gets the program representing an RST response.
 
@@ -281,6 +329,40 @@ class ProcessorStorage {
 			@returns The program representing an NMI response.
 		*/
 		inline const MicroOp *get_nmi_program();
+
+	private:
+		/*!
+			Describes whether and how perform_direct_instruction may perform an opcode.
+		*/
+		struct DirectInstruction {
+			enum class Mode: uint8_t {
+				None,	// the opcode must be performed cycle by cycle
+
+				Implied, Accumulator, Immediate, Relative,
+				Zero, ZeroX, ZeroY, Absolute, AbsoluteX, AbsoluteY, IndexedIndirect, IndirectIndexed,
+
+				BRK, JSR, RTI, RTS, JMP, JMPIndirect, PHA, PHP, PLA, PLP
+			} mode = Mode::None;
+			enum class Access: uint8_t {
+				None, Read, Write, ReadModifyWrite
+			} access = Access::None;
+			MicroOp operation = OperationMoveToNextProgram;
+		};
+		static const DirectInstruction *direct_instructions();
+
+		inline uint8_t *read_page(uint16_t address) const {
+			return read_pages_[address >> page_size_shift_];
+		}
+		inline uint8_t *write_page(uint16_t address) const {
+			return write_pages_[address >> page_size_shift_];
+		}
+		inline uint8_t read_direct(uint16_t address) const {
+			return read_page(address)[address & page_offset_mask_];
+		}
+		inline void write_direct(uint16_t address, uint8_t value) {
+			write_page(address)[address & page_offset_mask_] = value;
+			idle_loop_detector_.did_write(address, value);
+		}
 };
 
 #endif /* _502Storage_h */
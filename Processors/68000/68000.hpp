@@ -20,6 +20,7 @@
 
 #include "../../ClockReceiver/ForceInline.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../IdleLoopDetector.hpp"
 #include "../RegisterSizes.hpp"
 
 namespace CPU {
@@ -344,11 +345,37 @@ class BusHandler {
 			Provides information about the path of execution if enabled via the template.
 		*/
 		void will_perform(uint32_t address, uint16_t opcode) {}
+
+		/*!
+			Announces that the 68000 is in an idle loop: a short loop that has run at least twice, each time
+			returning to its start in the same state, taking @c iteration_length and making the same writes.
+			This is called only by processors that have had idle-loop detection enabled, at the start of
+			an iteration.
+
+			Machines may skip any whole number of further iterations for which they know that nothing the loop
+			reads will change, e.g. until the next scheduled interrupt or video event, by advancing their
+			components as if that time had been spent within perform_bus_operation. As all IO is memory mapped,
+			machines should decline if the loop accessed anything other than plain memory.
+
+			@returns The amount of time skipped, which should be a multiple of @c iteration_length and no
+			greater than @c available.
+		*/
+		HalfCycles skip_idle_loop(HalfCycles iteration_length, HalfCycles available) {
+			return HalfCycles(0);
+		}
 };
 
 #include "Implementation/68000Storage.hpp"
 
 class ProcessorBase: public ProcessorStorage {
+	public:
+		/*!
+			Enables or disables idle-loop detection; if enabled then the bus handler's @c skip_idle_loop
+			will be called whenever the 68000 appears to be in an idle loop. Detection is disabled by default.
+		*/
+		void set_idle_loop_detection_enabled(bool enabled) {
+			idle_loop_detector_.set_enabled(enabled);
+		}
 };
 
 enum Flag: uint16_t {
@@ -69,6 +69,7 @@
 
 template <class T, bool dtack_is_implicit, bool signal_will_perform> void Processor<T, dtack_is_implicit, signal_will_perform>::run_for(HalfCycles duration) {
 	const HalfCycles remaining_duration = duration + half_cycles_left_to_run_;
+	idle_loop_detector_.did_extend_run(duration.as_integral());
 
 	// This loop counts upwards rather than downwards because it simplifies calculation of
 	// E as and when required.
@@ -87,6 +88,12 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 					}
 
 					if(active_step_->microcycle.data_select_active()) {
+						if(!(active_step_->microcycle.operation & Microcycle::Read)) {
+							idle_loop_detector_.did_write(
+								*active_step_->microcycle.address,
+								uint32_t(active_step_->microcycle.operation << 16) | active_step_->microcycle.value->full);
+						}
+
 						// Check whether the processor needs to await DTack.
 						if(!dtack_is_implicit && !dtack_ && !bus_error_) {
 							execution_state_ = ExecutionState::WaitingForDTack;
@@ -315,6 +322,26 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 								bus_handler_.will_perform(program_counter_.full - 4, decoded_instruction_.full);
 							}
 
+							// If this is the start of an idle loop, offer the bus handler the chance to skip some of it;
+							// there's no such chance if an interrupt is about to be sampled.
+							if(idle_loop_detector_.is_enabled() && bus_interrupt_level_ <= interrupt_level_) {
+								uint64_t signature = IdleLoopDetector::signature({uint32_t(get_status())});
+								for(int c = 0; c < 8; ++c) {
+									signature = IdleLoopDetector::signature({data_[c].full, address_[c].full}, signature);
+								}
+
+								const HalfCycles available = remaining_duration - cycles_run_for;
+								const int64_t iteration_length = idle_loop_detector_.did_begin_instruction(
+									program_counter_.full - 4,
+									signature,
+									available.as_integral());
+								if(iteration_length) {
+									const HalfCycles skipped = bus_handler_.skip_idle_loop(HalfCycles(iteration_length), available);
+									cycles_run_for += skipped;
+									idle_loop_detector_.did_skip(skipped.as_integral());
+								}
+							}
+
 #ifdef LOG_TRACE
 //							const uint32_t fetched_pc = (program_counter_.full - 4)&0xffffff;
 
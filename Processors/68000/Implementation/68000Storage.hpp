@@ -459,6 +459,10 @@ class ProcessorStorage {
 		RegisterPair16 throwaway_value_;
 		uint32_t movem_final_address_;
 
+		// Idle-loop detection, if enabled. This is placed well after the registers and bus latches,
+		// which micro-ops address via single-byte offsets from the start of this storage.
+		IdleLoopDetector idle_loop_detector_;
+
 		/*!
 			Evaluates the conditional described by @c code and returns @c true or @c false to
 			indicate the result of that evaluation.
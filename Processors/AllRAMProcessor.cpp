@@ -35,4 +35,5 @@ void AllRAMProcessor::set_trap_handler(TrapHandler *trap_handler) {
 
 void AllRAMProcessor::add_trap_address(uint16_t address) {
 	traps_[address] = true;
+	did_add_trap_address(address);
 }
@@ -20,6 +20,7 @@ namespace CPU {
 class AllRAMProcessor {
 	public:
 		AllRAMProcessor(std::size_t memory_size);
+		virtual ~AllRAMProcessor() {}
 		HalfCycles get_timestamp();
 		void set_data_at_address(uint16_t startAddress, std::size_t length, const uint8_t *data);
 		void get_data_at_address(uint16_t startAddress, std::size_t length, uint8_t *data);
@@ -41,6 +42,13 @@ class AllRAMProcessor {
 			}
 		}
 
+		/*!
+			Announces that @c address has become a trap address; subclasses that
+			satisfy some accesses without checking for traps can use this to stop
+			doing so for the relevant memory.
+		*/
+		virtual void did_add_trap_address(uint16_t address) {}
+
 	private:
 		TrapHandler *trap_handler_;
 		std::vector<bool> traps_;
@@ -0,0 +1,164 @@
+//
+//  IdleLoopDetector.hpp
+//  Clock Signal
+//
+//  Created by agent on 18/10/2026.
+//  Copyright 2026 agent. All rights reserved.
+//
+
+#ifndef IdleLoopDetector_hpp
+#define IdleLoopDetector_hpp
+
+#include <cstdint>
+#include <initializer_list>
+
+namespace CPU {
+
+/*!
+	Spots idle loops: short sequences of code that return to their starting address
+	with the processor in exactly the state it was in last time, having taken the same
+	amount of time and having made exactly the same writes — e.g. loops that poll a memory
+	or IO location, waiting for it to change, perhaps via a subroutine.
+
+	Such loops are a pure function of whatever they read: once a loop has repeated its writes,
+	further repetitions change nothing. So iterations can be skipped for as long as the bus
+	handler knows that none of the values read will change, and that the writes have no effect
+	beyond storing their values — i.e. that the loop doesn't touch memory-mapped IO.
+
+	Processors inform the detector of every memory write and IO output, and of the start of
+	every instruction via @c did_begin_instruction, supplying a signature of their current state
+	and the time remaining in the current run_for, which is assumed to count down. Time added
+	by each new call to run_for should be reported via @c did_extend_run.
+*/
+class IdleLoopDetector {
+	public:
+		/// The maximum distance, in bytes, between the end and start of a loop.
+		static constexpr uint32_t MaximumLoopSize = 32;
+
+		/// The number of identical iterations required before a loop is considered idle.
+		static constexpr int RequiredIterations = 2;
+
+		/// The number of backward branches into its own body, such as returns from subroutines,
+		/// that a potential loop may contain before it is abandoned in favour of the latest.
+		static constexpr int MaximumInteriorBranches = 4;
+
+		void set_enabled(bool enabled) {
+			is_enabled_ = enabled;
+			loop_start_ = ~0u;
+		}
+
+		bool is_enabled() const {
+			return is_enabled_;
+		}
+
+		/// Records that the processor has written @c value to memory at @c address; any further
+		/// detail that distinguishes writes, such as their size, may be folded into @c value.
+		void did_write(uint32_t address, uint32_t value) {
+			writes_ = signature({address, value}, writes_);
+		}
+
+		/// Records that the processor has performed IO output, which is assumed to have an effect
+		/// however often it is repeated; no loop that performs output is idle.
+		void did_output() {
+			did_output_ = true;
+		}
+
+		/*!
+			Records that the processor is about to begin the instruction at @c address.
+
+			@returns @c 0 if the processor is not in an idle loop; otherwise the length
+			of a single iteration of the loop, which ends here.
+		*/
+		int64_t did_begin_instruction(uint32_t address, uint64_t signature, int64_t time_remaining) {
+			if(address == loop_start_) {
+				const int64_t length = start_time_remaining_ - time_remaining;
+				if(!did_output_ && signature == signature_ && writes_ == previous_writes_ && length > 0 && length == iteration_length_) {
+					if(stable_iterations_ < RequiredIterations) ++stable_iterations_;
+				} else {
+					stable_iterations_ = 0;
+				}
+
+				iteration_length_ = length;
+				signature_ = signature;
+				start_time_remaining_ = time_remaining;
+				previous_writes_ = writes_;
+				writes_ = InitialSignature;
+				did_output_ = false;
+				interior_branches_ = 0;
+				last_address_ = address;
+				return (stable_iterations_ == RequiredIterations) ? length : 0;
+			}
+
+			// A short backward branch, or a branch to self, nominates a new potential loop — unless
+			// it lands within the current potential loop, which keeps recurring.
+			if(address <= last_address_ && last_address_ - address <= MaximumLoopSize) {
+				if(
+					address > loop_start_ && address - loop_start_ <= MaximumLoopSize &&
+					interior_branches_ < MaximumInteriorBranches
+				) {
+					++interior_branches_;
+					last_address_ = address;
+					return 0;
+				}
+
+				loop_start_ = address;
+				signature_ = signature;
+				start_time_remaining_ = time_remaining;
+				iteration_length_ = 0;
+				stable_iterations_ = 0;
+				writes_ = previous_writes_ = InitialSignature;
+				did_output_ = false;
+				interior_branches_ = 0;
+			}
+			last_address_ = address;
+			return 0;
+		}
+
+		/*!
+			Records that @c time has been added to the processor's time remaining,
+			i.e. that a new run_for has begun.
+		*/
+		void did_extend_run(int64_t time) {
+			start_time_remaining_ += time;
+		}
+
+		/*!
+			Records that the processor skipped @c time, having been told that it was
+			in an idle loop; the loop remains idle.
+		*/
+		void did_skip(int64_t time) {
+			start_time_remaining_ -= time;
+		}
+
+		/*!
+			@returns A signature for the processor state described by @c values; signatures
+			may be built up piecemeal by supplying an earlier result as @c seed.
+		*/
+		static uint64_t signature(std::initializer_list<uint32_t> values, uint64_t seed = InitialSignature) {
+			uint64_t result = seed;
+			for(const auto value: values) {
+				result = (result ^ value) * 1099511628211u;
+			}
+			return result;
+		}
+
+	private:
+		static constexpr uint64_t InitialSignature = 14695981039346656037u;
+
+		bool is_enabled_ = false;
+		bool did_output_ = false;
+		uint64_t writes_ = InitialSignature;
+		uint64_t previous_writes_ = InitialSignature;
+
+		uint32_t loop_start_ = ~0u;
+		uint32_t last_address_ = 0;
+		uint64_t signature_ = 0;
+		int64_t start_time_remaining_ = 0;
+		int64_t iteration_length_ = 0;
+		int stable_iterations_ = 0;
+		int interior_branches_ = 0;
+};
+
+}
+
+#endif /* IdleLoopDetector_hpp */
@@ -119,3 +119,16 @@ void ProcessorBase::set_value_of_register(Register r, uint16_t value) {
 		default: break;
 	}
 }
+
+void ProcessorBase::set_memory_map(const uint8_t *const *read_pages, uint8_t *const *write_pages, int page_size_shift, const HalfCycles *wait_states, HalfCycles opcode_wait_states) {
+	read_pages_ = read_pages;
+	write_pages_ = write_pages;
+	page_wait_states_ = wait_states;
+	opcode_wait_states_ = opcode_wait_states;
+	page_size_shift_ = page_size_shift;
+	page_offset_mask_ = static_cast<uint16_t>((1 << page_size_shift) - 1);
+}
+
+void ProcessorBase::set_idle_loop_detection_enabled(bool enabled) {
+	idle_loop_detector_.set_enabled(enabled);
+}
@@ -8,35 +8,49 @@
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_memory_map> Processor <T, uses_bus_request, uses_wait_line, uses_memory_map>
 				::Processor(T &bus_handler) :
 					bus_handler_(bus_handler) {
-	install_default_instruction_set();
+	install_default_instruction_set(uses_wait_line);
 }
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_memory_map> void Processor <T, uses_bus_request, uses_wait_line, uses_memory_map>
 				::run_for(const HalfCycles cycles) {
 #define advance_operation() \
+	flush_direct_cycles();	\
 	pc_increment_ = 1;	\
 	if(last_request_status_) {	\
 		halt_mask_ = 0xff;	\
 		if(last_request_status_ & (Interrupt::PowerOn | Interrupt::Reset)) {	\
 			request_status_ &= ~Interrupt::PowerOn;	\
-			scheduled_program_counter_ = reset_program_.data();	\
+			scheduled_program_counter_ = instruction_set_->reset_program.data();	\
 		} else if(last_request_status_ & Interrupt::NMI) {	\
 			request_status_ &= ~Interrupt::NMI;	\
-			scheduled_program_counter_ = nmi_program_.data();	\
+			scheduled_program_counter_ = instruction_set_->nmi_program.data();	\
 		} else if(last_request_status_ & Interrupt::IRQ) {	\
-			scheduled_program_counter_ = irq_program_[interrupt_mode_].data();	\
+			scheduled_program_counter_ = instruction_set_->irq_program[interrupt_mode_].data();	\
 		}	\
 	} else {	\
-		current_instruction_page_ = &base_page_;	\
-		scheduled_program_counter_ = base_page_.fetch_decode_execute_data;	\
+		current_instruction_page_ = &instruction_set_->base_page;	\
+		scheduled_program_counter_ = instruction_set_->base_page.fetch_decode_execute_data;	\
+	}
+
+	// If a memory map is in use, time spent on cycles that were performed directly is
+	// announced to the bus handler as a single internal cycle; this happens at least at
+	// the end of every instruction, before interrupts are checked for.
+#define flush_direct_cycles()	\
+	if(uses_memory_map && direct_cycles_ > HalfCycles(0)) {	\
+		const PartialMachineCycle direct_cycle(PartialMachineCycle::Internal, direct_cycles_, nullptr, nullptr, false);	\
+		direct_cycles_ = HalfCycles(0);	\
+		number_of_cycles_ -= bus_handler_.perform_machine_cycle(direct_cycle);	\
 	}
 
 	number_of_cycles_ += cycles;
+	idle_loop_detector_.did_extend_run(cycles.as_integral());
 	if(!scheduled_program_counter_) {
 		advance_operation();
 	}
@@ -45,6 +59,7 @@ template <	class T,
 
 		do_bus_acknowledge:
 		while(uses_bus_request && bus_request_line_) {
+			flush_direct_cycles();
 			static PartialMachineCycle bus_acknowledge_cycle = {PartialMachineCycle::BusAcknowledge, HalfCycles(2), nullptr, nullptr, false};
 			number_of_cycles_ -= bus_handler_.perform_machine_cycle(bus_acknowledge_cycle) + HalfCycles(1);
 			if(!number_of_cycles_) {
@@ -54,7 +69,7 @@ template <	class T,
 		}
 
 		while(true) {
-			const MicroOp *const operation = scheduled_program_counter_;
+			const SharedMicroOp *const operation = scheduled_program_counter_;
 			scheduled_program_counter_++;
 
 #define set_did_compute_flags()	\
@@ -70,10 +85,13 @@ template <	class T,
 				case MicroOp::BusOperation:
 					if(number_of_cycles_ < operation->machine_cycle.length) {
 						scheduled_program_counter_--;
+						flush_direct_cycles();
 						bus_handler_.flush();
 						return;
 					}
 					if(uses_wait_line && operation->machine_cycle.was_requested) {
+						// Give the bus handler a chance to update the wait line before it is sampled.
+						flush_direct_cycles();
 						if(wait_line_) {
 							scheduled_program_counter_--;
 						} else {
@@ -81,11 +99,46 @@ template <	class T,
 						}
 					}
 					number_of_cycles_ -= operation->machine_cycle.length;
+					if(operation->machine_cycle.operation == PartialMachineCycle::Write) {
+						idle_loop_detector_.did_write(
+							operand<uint16_t>(operation->machine_cycle.address),
+							operand<uint8_t>(operation->machine_cycle.value));
+					} else if(operation->machine_cycle.operation == PartialMachineCycle::Output) {
+						idle_loop_detector_.did_output();
+					}
+					if(uses_memory_map && perform_direct_access(operation->machine_cycle)) {
+						last_request_status_ = request_status_;
+						break;
+					}
+
+					// Direct time is announced before the interrupt lines are sampled, so that any change that
+					// the bus handler makes in response is seen.
+					flush_direct_cycles();
 					last_request_status_ = request_status_;
-					number_of_cycles_ -= bus_handler_.perform_machine_cycle(operation->machine_cycle);
+					number_of_cycles_ -= bus_handler_.perform_machine_cycle(partial_machine_cycle(operation->machine_cycle));
 					if(uses_bus_request && bus_request_line_) goto do_bus_acknowledge;
 				break;
 				case MicroOp::MoveToNextProgram:
+					flush_direct_cycles();
+
+					// If this is the start of an idle loop, offer the bus handler the chance to skip some of it.
+					if(idle_loop_detector_.is_enabled() && !last_request_status_ && !request_status_) {
+						const int64_t iteration_length = idle_loop_detector_.did_begin_instruction(
+							pc_.full,
+							IdleLoopDetector::signature({
+								uint32_t(a_ << 8) | get_flags(), bc_.full, de_.full, hl_.full,
+								afDash_.full, bcDash_.full, deDash_.full, hlDash_.full,
+								ix_.full, iy_.full, sp_.full, memptr_.full,
+								uint32_t(iff1_)
+							}),
+							number_of_cycles_.as_integral());
+						if(iteration_length) {
+							const HalfCycles skipped = bus_handler_.skip_idle_loop(HalfCycles(iteration_length), number_of_cycles_);
+							number_of_cycles_ -= skipped;
+							idle_loop_detector_.did_skip(skipped.as_integral());
+						}
+					}
+
 					advance_operation();
 				break;
 				case MicroOp::DecodeOperation:
@@ -101,11 +154,11 @@ template <	class T,
 					scheduled_program_counter_ = current_instruction_page_->instructions[operation_ & halt_mask_];
 				break;
 
-				case MicroOp::Increment16:			(*static_cast<uint16_t *>(operation->source))++;		break;
+				case MicroOp::Increment16:			operand<uint16_t>(operation->source)++;		break;
 				case MicroOp::IncrementPC:			pc_.full += pc_increment_;								break;
-				case MicroOp::Decrement16:			(*static_cast<uint16_t *>(operation->source))--;		break;
-				case MicroOp::Move8:				*static_cast<uint8_t *>(operation->destination) = *static_cast<uint8_t *>(operation->source);		break;
-				case MicroOp::Move16:				*static_cast<uint16_t *>(operation->destination) = *static_cast<uint16_t *>(operation->source);		break;
+				case MicroOp::Decrement16:			operand<uint16_t>(operation->source)--;		break;
+				case MicroOp::Move8:				operand<uint8_t>(operation->destination) = operand<uint8_t>(operation->source);		break;
+				case MicroOp::Move16:				operand<uint16_t>(operation->destination) = operand<uint16_t>(operation->source);		break;
 
 				case MicroOp::AssembleAF:
 					temp16_.halves.high = a_;
@@ -127,17 +180,17 @@ template <	class T,
 	set_did_compute_flags();
 
 				case MicroOp::And:
-					a_ &= *static_cast<uint8_t *>(operation->source);
+					a_ &= operand<uint8_t>(operation->source);
 					set_logical_flags(Flag::HalfCarry);
 				break;
 
 				case MicroOp::Or:
-					a_ |= *static_cast<uint8_t *>(operation->source);
+					a_ |= operand<uint8_t>(operation->source);
 					set_logical_flags(0);
 				break;
 
 				case MicroOp::Xor:
-					a_ ^= *static_cast<uint8_t *>(operation->source);
+					a_ ^= operand<uint8_t>(operation->source);
 					set_logical_flags(0);
 				break;
 
@@ -200,7 +253,7 @@ template <	class T,
 	set_did_compute_flags();
 
 				case MicroOp::CP8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = operand<uint8_t>(operation->source);
 					const int result = a_ - value;
 					const int half_result = (a_&0xf) - (value&0xf);
 
@@ -213,7 +266,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::SUB8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = operand<uint8_t>(operation->source);
 					const int result = a_ - value;
 					const int half_result = (a_&0xf) - (value&0xf);
 
@@ -226,7 +279,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::SBC8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = operand<uint8_t>(operation->source);
 					const int result = a_ - value - (carry_result_ & Flag::Carry);
 					const int half_result = (a_&0xf) - (value&0xf) - (carry_result_ & Flag::Carry);
 
@@ -239,7 +292,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::ADD8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = operand<uint8_t>(operation->source);
 					const int result = a_ + value;
 					const int half_result = (a_&0xf) + (value&0xf);
 
@@ -252,7 +305,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::ADC8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = operand<uint8_t>(operation->source);
 					const int result = a_ + value + (carry_result_ & Flag::Carry);
 					const int half_result = (a_&0xf) + (value&0xf) + (carry_result_ & Flag::Carry);
 
@@ -281,7 +334,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::Increment8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = operand<uint8_t>(operation->source);
 					const int result = value + 1;
 
 					// with an increment, overflow occurs if the sign changes from
@@ -289,7 +342,7 @@ template <	class T,
 					const int overflow = (value ^ result) & ~value;
 					const int half_result = (value&0xf) + 1;
 
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>(result);
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>(result);
 
 					// sign, zero and 5 & 3 are set directly from the result
 					bit53_result_ = sign_result_ = zero_result_ = static_cast<uint8_t>(result);
@@ -300,7 +353,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::Decrement8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = operand<uint8_t>(operation->source);
 					const int result = value - 1;
 
 					// with a decrement, overflow occurs if the sign changes from
@@ -308,7 +361,7 @@ template <	class T,
 					const int overflow = (value ^ result) & value;
 					const int half_result = (value&0xf) - 1;
 
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>(result);
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>(result);
 
 					// sign, zero and 5 & 3 are set directly from the result
 					bit53_result_ = sign_result_ = zero_result_ = static_cast<uint8_t>(result);
@@ -364,8 +417,8 @@ template <	class T,
 // MARK: - 16-bit arithmetic
 
 				case MicroOp::ADD16: {
-					memptr_.full = *static_cast<uint16_t *>(operation->destination);
-					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
+					memptr_.full = operand<uint16_t>(operation->destination);
+					const uint16_t sourceValue = operand<uint16_t>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
 					const int result = sourceValue + destinationValue;
 					const int halfResult = (sourceValue&0xfff) + (destinationValue&0xfff);
@@ -376,13 +429,13 @@ template <	class T,
 					subtract_flag_ = 0;
 					set_did_compute_flags();
 
-					*static_cast<uint16_t *>(operation->destination) = static_cast<uint16_t>(result);
+					operand<uint16_t>(operation->destination) = static_cast<uint16_t>(result);
 					memptr_.full++;
 				} break;
 
 				case MicroOp::ADC16: {
-					memptr_.full = *static_cast<uint16_t *>(operation->destination);
-					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
+					memptr_.full = operand<uint16_t>(operation->destination);
+					const uint16_t sourceValue = operand<uint16_t>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
 					const int result = sourceValue + destinationValue + (carry_result_ & Flag::Carry);
 					const int halfResult = (sourceValue&0xfff) + (destinationValue&0xfff) + (carry_result_ & Flag::Carry);
@@ -398,13 +451,13 @@ template <	class T,
 					parity_overflow_result_ = static_cast<uint8_t>(overflow >> 13);
 					set_did_compute_flags();
 
-					*static_cast<uint16_t *>(operation->destination) = static_cast<uint16_t>(result);
+					operand<uint16_t>(operation->destination) = static_cast<uint16_t>(result);
 					memptr_.full++;
 				} break;
 
 				case MicroOp::SBC16: {
-					memptr_.full = *static_cast<uint16_t *>(operation->destination);
-					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
+					memptr_.full = operand<uint16_t>(operation->destination);
+					const uint16_t sourceValue = operand<uint16_t>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
 					const int result = destinationValue - sourceValue - (carry_result_ & Flag::Carry);
 					const int halfResult = (destinationValue&0xfff) - (sourceValue&0xfff) - (carry_result_ & Flag::Carry);
@@ -423,15 +476,15 @@ template <	class T,
 					parity_overflow_result_ = static_cast<uint8_t>(overflow >> 13);
 					set_did_compute_flags();
 
-					*static_cast<uint16_t *>(operation->destination) = static_cast<uint16_t>(result);
+					operand<uint16_t>(operation->destination) = static_cast<uint16_t>(result);
 					memptr_.full++;
 				} break;
 
 // MARK: - Conditionals
 
 #define decline_conditional()	\
-	if(operation->source) {		\
-		scheduled_program_counter_ = (MicroOp *)operation->source;	\
+	if(operation->target) {		\
+		scheduled_program_counter_ = static_cast<const SharedMicroOp *>(operation->target);	\
 	} else {	\
 		advance_operation();	\
 	}
@@ -634,12 +687,12 @@ template <	class T,
 // MARK: - Bit Manipulation
 
 				case MicroOp::BIT: {
-					const uint8_t result = *static_cast<uint8_t *>(operation->source) & (1 << ((operation_ >> 3)&7));
+					const uint8_t result = operand<uint8_t>(operation->source) & (1 << ((operation_ >> 3)&7));
 
 					if(current_instruction_page_->is_indexed || ((operation_&0x07) == 6)) {
 						bit53_result_ = memptr_.halves.high;
 					} else {
-						bit53_result_ = *static_cast<uint8_t *>(operation->source);
+						bit53_result_ = operand<uint8_t>(operation->source);
 					}
 
 					sign_result_ = zero_result_ = result;
@@ -650,11 +703,11 @@ template <	class T,
 				} break;
 
 				case MicroOp::RES:
-					*static_cast<uint8_t *>(operation->source) &= ~(1 << ((operation_ >> 3)&7));
+					operand<uint8_t>(operation->source) &= ~(1 << ((operation_ >> 3)&7));
 				break;
 
 				case MicroOp::SET:
-					*static_cast<uint8_t *>(operation->source) |= (1 << ((operation_ >> 3)&7));
+					operand<uint8_t>(operation->source) |= (1 << ((operation_ >> 3)&7));
 				break;
 
 // MARK: - Rotation and shifting
@@ -692,59 +745,59 @@ template <	class T,
 #undef set_rotate_flags
 
 #define set_shift_flags()	\
-	sign_result_ = zero_result_ = bit53_result_ = *static_cast<uint8_t *>(operation->source);	\
+	sign_result_ = zero_result_ = bit53_result_ = operand<uint8_t>(operation->source);	\
 	set_parity(sign_result_);	\
 	half_carry_result_ = 0;	\
 	subtract_flag_ = 0;	\
 	set_did_compute_flags();
 
 				case MicroOp::RLC:
-					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>((*static_cast<uint8_t *>(operation->source) << 1) | carry_result_);
+					carry_result_ = operand<uint8_t>(operation->source) >> 7;
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>((operand<uint8_t>(operation->source) << 1) | carry_result_);
 					set_shift_flags();
 				break;
 
 				case MicroOp::RRC:
-					carry_result_ = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>((*static_cast<uint8_t *>(operation->source) >> 1) | (carry_result_ << 7));
+					carry_result_ = operand<uint8_t>(operation->source);
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>((operand<uint8_t>(operation->source) >> 1) | (carry_result_ << 7));
 					set_shift_flags();
 				break;
 
 				case MicroOp::RL: {
-					const uint8_t next_carry = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>((*static_cast<uint8_t *>(operation->source) << 1) | (carry_result_ & Flag::Carry));
+					const uint8_t next_carry = operand<uint8_t>(operation->source) >> 7;
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>((operand<uint8_t>(operation->source) << 1) | (carry_result_ & Flag::Carry));
 					carry_result_ = next_carry;
 					set_shift_flags();
 				} break;
 
 				case MicroOp::RR: {
-					const uint8_t next_carry = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>((*static_cast<uint8_t *>(operation->source) >> 1) | (carry_result_ << 7));
+					const uint8_t next_carry = operand<uint8_t>(operation->source);
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>((operand<uint8_t>(operation->source) >> 1) | (carry_result_ << 7));
 					carry_result_ = next_carry;
 					set_shift_flags();
 				} break;
 
 				case MicroOp::SLA:
-					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>(*static_cast<uint8_t *>(operation->source) << 1);
+					carry_result_ = operand<uint8_t>(operation->source) >> 7;
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>(operand<uint8_t>(operation->source) << 1);
 					set_shift_flags();
 				break;
 
 				case MicroOp::SRA:
-					carry_result_ = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>((*static_cast<uint8_t *>(operation->source) >> 1) | (*static_cast<uint8_t *>(operation->source) & 0x80));
+					carry_result_ = operand<uint8_t>(operation->source);
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>((operand<uint8_t>(operation->source) >> 1) | (operand<uint8_t>(operation->source) & 0x80));
 					set_shift_flags();
 				break;
 
 				case MicroOp::SLL:
-					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>(*static_cast<uint8_t *>(operation->source) << 1) | 1;
+					carry_result_ = operand<uint8_t>(operation->source) >> 7;
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>(operand<uint8_t>(operation->source) << 1) | 1;
 					set_shift_flags();
 				break;
 
 				case MicroOp::SRL:
-					carry_result_ = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = static_cast<uint8_t>((*static_cast<uint8_t *>(operation->source) >> 1));
+					carry_result_ = operand<uint8_t>(operation->source);
+					operand<uint8_t>(operation->source) = static_cast<uint8_t>((operand<uint8_t>(operation->source) >> 1));
 					set_shift_flags();
 				break;
 
@@ -778,12 +831,16 @@ template <	class T,
 
 // MARK: - Interrupt state
 
+				// Interrupt changes dated within any pending direct time happened while the old
+				// interrupt flags were in effect, so that time is announced before the flags change.
 				case MicroOp::EI:
+					flush_direct_cycles();
 					iff1_ = iff2_ = true;
 					if(irq_line_) request_status_ |= Interrupt::IRQ;
 				break;
 
 				case MicroOp::DI:
+					flush_direct_cycles();
 					iff1_ = iff2_ = false;
 					request_status_ &= ~Interrupt::IRQ;
 				break;
@@ -801,7 +858,7 @@ template <	class T,
 
 				case MicroOp::SetInFlags:
 					subtract_flag_ = half_carry_result_ = 0;
-					sign_result_ = zero_result_ = bit53_result_ = *static_cast<uint8_t *>(operation->source);
+					sign_result_ = zero_result_ = bit53_result_ = operand<uint8_t>(operation->source);
 					set_parity(sign_result_);
 					set_did_compute_flags();
 				break;
@@ -838,6 +895,7 @@ template <	class T,
 				break;
 
 				case MicroOp::RETN:
+					flush_direct_cycles();
 					iff1_ = iff2_;
 					if(irq_line_ && iff1_) request_status_ |= Interrupt::IRQ;
 				break;
@@ -861,16 +919,16 @@ template <	class T,
 // MARK: - Internal bookkeeping
 
 				case MicroOp::SetInstructionPage:
-					current_instruction_page_ = (InstructionPage *)operation->source;
+					current_instruction_page_ = static_cast<const InstructionPage *>(operation->target);
 					scheduled_program_counter_ = current_instruction_page_->fetch_decode_execute_data;
 				break;
 
 				case MicroOp::CalculateIndexAddress:
-					memptr_.full = static_cast<uint16_t>(*static_cast<uint16_t *>(operation->source) + (int8_t)temp8_);
+					memptr_.full = static_cast<uint16_t>(operand<uint16_t>(operation->source) + (int8_t)temp8_);
 				break;
 
 				case MicroOp::SetAddrAMemptr:
-					memptr_.full = static_cast<uint16_t>(((*static_cast<uint16_t *>(operation->source) + 1)&0xff) + (a_ << 8));
+					memptr_.full = static_cast<uint16_t>(((operand<uint16_t>(operation->source) + 1)&0xff) + (a_ << 8));
 				break;
 
 				case MicroOp::IndexedPlaceHolder:
@@ -880,11 +938,13 @@ template <	class T,
 		}
 
 	}
+#undef flush_direct_cycles
 }
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_memory_map> void Processor <T, uses_bus_request, uses_wait_line, uses_memory_map>
 				::set_bus_request_line(bool value) {
 	assert(uses_bus_request);
 	bus_request_line_ = value;
@@ -892,14 +952,16 @@ template <	class T,
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> bool Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_memory_map> bool Processor <T, uses_bus_request, uses_wait_line, uses_memory_map>
 				::get_bus_request_line() {
 	return bus_request_line_;
 }
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_memory_map> void Processor <T, uses_bus_request, uses_wait_line, uses_memory_map>
 				::set_wait_line(bool value) {
 	assert(uses_wait_line);
 	wait_line_ = value;
@@ -907,98 +969,12 @@ template <	class T,
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> bool Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_memory_map> bool Processor <T, uses_bus_request, uses_wait_line, uses_memory_map>
 				::get_wait_line() {
 	return wait_line_;
 }
 
-#define isTerminal(n)	(n == MicroOp::MoveToNextProgram || n == MicroOp::DecodeOperation || n == MicroOp::DecodeOperationNoRChange)
-
-template <	class T,
-			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
-				::assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets) {
-	std::size_t number_of_micro_ops = 0;
-	std::size_t lengths[256];
-
-	// Count number of micro-ops required.
-	for(int c = 0; c < 256; c++) {
-		std::size_t length = 0;
-		while(!isTerminal(table[c][length].type)) length++;
-		length++;
-		lengths[c] = length;
-		number_of_micro_ops += length;
-	}
-
-	// Allocate a landing area.
-	std::vector<std::size_t> operation_indices;
-	target.all_operations.reserve(number_of_micro_ops);
-	target.instructions.resize(256, nullptr);
-
-	// Copy in all programs, recording where they go.
-	std::size_t destination = 0;
-	for(std::size_t c = 0; c < 256; c++) {
-		operation_indices.push_back(target.all_operations.size());
-		for(std::size_t t = 0; t < lengths[c];) {
-			// Skip zero-length bus cycles.
-			if(table[c][t].type == MicroOp::BusOperation && table[c][t].machine_cycle.length.as_integral() == 0) {
-				t++;
-				continue;
-			}
-
-			// Skip optional waits if this instance doesn't use the wait line.
-			if(table[c][t].machine_cycle.was_requested && !uses_wait_line) {
-				t++;
-				continue;
-			}
-
-			// If an index placeholder is hit then drop it, and if offsets aren't being added,
-			// then also drop the indexing that follows, which is assumed to be everything
-			// up to and including the next ::CalculateIndexAddress. Coupled to the INDEX() macro.
-			if(table[c][t].type == MicroOp::IndexedPlaceHolder) {
-				t++;
-				if(!add_offsets) {
-					while(table[c][t].type != MicroOp::CalculateIndexAddress) t++;
-					t++;
-				}
-			}
-			target.all_operations.emplace_back(table[c][t]);
-			destination++;
-			t++;
-		}
-	}
-
-	// Since the vector won't change again, it's now safe to set pointers.
-	std::size_t c = 0;
-	for(std::size_t index : operation_indices) {
-		target.instructions[c] = &target.all_operations[index];
-		c++;
-	}
-}
-
-template <	class T,
-			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
-		::copy_program(const MicroOp *source, std::vector<MicroOp> &destination) {
-	std::size_t length = 0;
-	while(!isTerminal(source[length].type)) length++;
-	std::size_t pointer = 0;
-	while(true) {
-		// TODO: This test is duplicated from assemble_page; can a better factoring be found?
-		// Skip optional waits if this instance doesn't use the wait line.
-		if(source[pointer].machine_cycle.was_requested && !uses_wait_line) {
-			pointer++;
-			continue;
-		}
-
-		destination.emplace_back(source[pointer]);
-		if(isTerminal(source[pointer].type)) break;
-		pointer++;
-	}
-}
-
-#undef isTerminal
-
 bool ProcessorBase::get_halt_line() {
 	return halt_mask_ == 0x00;
 }
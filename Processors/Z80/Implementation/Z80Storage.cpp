@@ -8,6 +8,7 @@
 
 #include "../Z80.hpp"
 #include <cstring>
+#include <mutex>
 
 using namespace CPU::Z80;
 
@@ -105,7 +106,7 @@ ProcessorStorage::ProcessorStorage() {
 #define NOP						Sequence(BusOp(Refresh(4)))
 
 #define JP(cc)					StdInstr(Read16Inc(pc_, temp16_), {MicroOp::cc, nullptr}, {MicroOp::Move16, &temp16_.full, &pc_.full})
-#define CALL(cc)				StdInstr(ReadInc(pc_, temp16_.halves.low), {MicroOp::cc, conditional_call_untaken_program_.data()}, Read4Inc(pc_, temp16_.halves.high), Push(pc_), {MicroOp::Move16, &temp16_.full, &pc_.full})
+#define CALL(cc)				StdInstr(ReadInc(pc_, temp16_.halves.low), {MicroOp::cc, set.conditional_call_untaken_program.data()}, Read4Inc(pc_, temp16_.halves.high), Push(pc_), {MicroOp::Move16, &temp16_.full, &pc_.full})
 #define RET(cc)					Instr(6, {MicroOp::cc, nullptr}, Pop(memptr_), {MicroOp::Move16, &memptr_.full, &pc_.full})
 #define JR(cc)					StdInstr(ReadInc(pc_, temp8_), {MicroOp::cc, nullptr}, InternalOperation(10), {MicroOp::CalculateIndexAddress, &pc_.full}, {MicroOp::Move16, &memptr_.full, &pc_.full})
 #define RST()					Instr(6, {MicroOp::CalculateRSTDestination}, Push(pc_), {MicroOp::Move16, &memptr_.full, &pc_.full})
@@ -165,31 +166,46 @@ ProcessorStorage::ProcessorStorage() {
 #define ADC16(d, s) StdInstr(InternalOperation(8), InternalOperation(6), {MicroOp::ADC16, &s.full, &d.full})
 #define SBC16(d, s) StdInstr(InternalOperation(8), InternalOperation(6), {MicroOp::SBC16, &s.full, &d.full})
 
-void ProcessorStorage::install_default_instruction_set() {
+void ProcessorStorage::install_default_instruction_set(bool uses_wait_line) {
+	// The instruction sets contain no pointers into any particular instance, so are built
+	// only once per process by whichever Z80 is constructed first and thereafter shared.
+	static InstructionSet instruction_sets[2];
+	static std::once_flag assembly_flags[2];
+
+	const int index = uses_wait_line ? 1 : 0;
+	std::call_once(assembly_flags[index], [this, index, uses_wait_line] {
+		assemble_instruction_set(instruction_sets[index], uses_wait_line);
+	});
+
+	instruction_set_ = &instruction_sets[index];
+	current_instruction_page_ = &instruction_set_->base_page;
+}
+
+void ProcessorStorage::assemble_instruction_set(InstructionSet &set, bool uses_wait_line) {
 	MicroOp conditional_call_untaken_program[] = Sequence(ReadInc(pc_, temp16_.halves.high));
-	copy_program(conditional_call_untaken_program, conditional_call_untaken_program_);
+	copy_program(conditional_call_untaken_program, set.conditional_call_untaken_program, uses_wait_line);
 
-	assemble_base_page(base_page_, hl_, false, cb_page_);
-	assemble_base_page(dd_page_, ix_, true, ddcb_page_);
-	assemble_base_page(fd_page_, iy_, true, fdcb_page_);
-	assemble_ed_page(ed_page_);
+	assemble_base_page(set, set.base_page, hl_, false, set.cb_page, uses_wait_line);
+	assemble_base_page(set, set.dd_page, ix_, true, set.ddcb_page, uses_wait_line);
+	assemble_base_page(set, set.fd_page, iy_, true, set.fdcb_page, uses_wait_line);
+	assemble_ed_page(set.ed_page, uses_wait_line);
 
-	fdcb_page_.r_step = 0;
-	fd_page_.is_indexed = true;
-	fdcb_page_.is_indexed = true;
+	set.fdcb_page.r_step = 0;
+	set.fd_page.is_indexed = true;
+	set.fdcb_page.is_indexed = true;
 
-	ddcb_page_.r_step = 0;
-	dd_page_.is_indexed = true;
-	ddcb_page_.is_indexed = true;
+	set.ddcb_page.r_step = 0;
+	set.dd_page.is_indexed = true;
+	set.ddcb_page.is_indexed = true;
 
-	assemble_fetch_decode_execute(base_page_, 4);
-	assemble_fetch_decode_execute(dd_page_, 4);
-	assemble_fetch_decode_execute(fd_page_, 4);
-	assemble_fetch_decode_execute(ed_page_, 4);
-	assemble_fetch_decode_execute(cb_page_, 4);
+	assemble_fetch_decode_execute(set.base_page, 4, uses_wait_line);
+	assemble_fetch_decode_execute(set.dd_page, 4, uses_wait_line);
+	assemble_fetch_decode_execute(set.fd_page, 4, uses_wait_line);
+	assemble_fetch_decode_execute(set.ed_page, 4, uses_wait_line);
+	assemble_fetch_decode_execute(set.cb_page, 4, uses_wait_line);
 
-	assemble_fetch_decode_execute(fdcb_page_, 3);
-	assemble_fetch_decode_execute(ddcb_page_, 3);
+	assemble_fetch_decode_execute(set.fdcb_page, 3, uses_wait_line);
+	assemble_fetch_decode_execute(set.ddcb_page, 3, uses_wait_line);
 
 	MicroOp reset_program[] = Sequence(InternalOperation(6), {MicroOp::Reset});
 
@@ -235,14 +251,14 @@ void ProcessorStorage::install_default_instruction_set() {
 		{ MicroOp::MoveToNextProgram }
 	};
 
-	copy_program(reset_program, reset_program_);
-	copy_program(nmi_program, nmi_program_);
-	copy_program(irq_mode0_program, irq_program_[0]);
-	copy_program(irq_mode1_program, irq_program_[1]);
-	copy_program(irq_mode2_program, irq_program_[2]);
+	copy_program(reset_program, set.reset_program, uses_wait_line);
+	copy_program(nmi_program, set.nmi_program, uses_wait_line);
+	copy_program(irq_mode0_program, set.irq_program[0], uses_wait_line);
+	copy_program(irq_mode1_program, set.irq_program[1], uses_wait_line);
+	copy_program(irq_mode2_program, set.irq_program[2], uses_wait_line);
 }
 
-void ProcessorStorage::assemble_ed_page(InstructionPage &target) {
+void ProcessorStorage::assemble_ed_page(InstructionPage &target, bool uses_wait_line) {
 #define IN_C(r)		StdInstr(Input(bc_, r), {MicroOp::SetInFlags, &r})
 #define OUT_C(r)	StdInstr(Output(bc_, r))
 #define IN_OUT(r)	IN_C(r), OUT_C(r)
@@ -312,11 +328,11 @@ void ProcessorStorage::assemble_ed_page(InstructionPage &target) {
 		NOP_ROW(),	/* 0xe0 */
 		NOP_ROW(),	/* 0xf0 */
 	};
-	assemble_page(target, ed_program_table, false);
+	assemble_page(target, ed_program_table, false, uses_wait_line);
 #undef NOP_ROW
 }
 
-void ProcessorStorage::assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets) {
+void ProcessorStorage::assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, bool uses_wait_line) {
 #define OCTO_OP_GROUP(m, x)	m(x),	m(x),	m(x),	m(x),	m(x),	m(x),	m(x),	m(x)
 #define CB_PAGE(m, p)	m(RLC), m(RRC),	m(RL),	m(RR),	m(SLA),	m(SRA),	m(SLL),	m(SRL),	OCTO_OP_GROUP(p, BIT),	OCTO_OP_GROUP(m, RES),	OCTO_OP_GROUP(m, SET)
 
@@ -337,13 +353,13 @@ void ProcessorStorage::assemble_cb_page(InstructionPage &target, RegisterPair16
 	InstructionTable offsets_cb_program_table = {
 		CB_PAGE(IX_MODIFY_OP_GROUP, IX_READ_OP_GROUP)
 	};
-	assemble_page(target, add_offsets ? offsets_cb_program_table : cb_program_table, add_offsets);
+	assemble_page(target, add_offsets ? offsets_cb_program_table : cb_program_table, add_offsets, uses_wait_line);
 
 #undef OCTO_OP_GROUP
 #undef CB_PAGE
 }
 
-void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page) {
+void ProcessorStorage::assemble_base_page(InstructionSet &set, InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page, bool uses_wait_line) {
 #define INC_DEC_LD(r)	\
 				StdInstr({MicroOp::Increment8, &r}),	\
 				StdInstr({MicroOp::Decrement8, &r}),	\
@@ -488,7 +504,7 @@ void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair1
 		/* 0xd7 RST 10h */	RST(),
 		/* 0xd8 RET C */	RET(TestC),								/* 0xd9 EXX */		StdInstr({MicroOp::EXX}),
 		/* 0xda JP C */		JP(TestC),								/* 0xdb IN A, (n) */StdInstr(ReadInc(pc_, temp16_.halves.low), {MicroOp::Move8, &a_, &temp16_.halves.high}, Input(temp16_, a_)),
-		/* 0xdc CALL C */	CALL(TestC),							/* 0xdd [DD page] */StdInstr({MicroOp::SetInstructionPage, &dd_page_}),
+		/* 0xdc CALL C */	CALL(TestC),							/* 0xdd [DD page] */StdInstr({MicroOp::SetInstructionPage, &set.dd_page}),
 		/* 0xde SBC A, n */	StdInstr(ReadInc(pc_, temp8_), {MicroOp::SBC8, &temp8_}),
 		/* 0xdf RST 18h */	RST(),
 		/* 0xe0 RET PO */	RET(TestPO),							/* 0xe1 POP HL */	StdInstr(Pop(index)),
@@ -498,7 +514,7 @@ void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair1
 		/* 0xe7 RST 20h */	RST(),
 		/* 0xe8 RET PE */	RET(TestPE),							/* 0xe9 JP (HL) */	StdInstr({MicroOp::Move16, &index.full, &pc_.full}),
 		/* 0xea JP PE */	JP(TestPE),								/* 0xeb EX DE, HL */StdInstr({MicroOp::ExDEHL}),
-		/* 0xec CALL PE */	CALL(TestPE),							/* 0xed [ED page] */StdInstr({MicroOp::SetInstructionPage, &ed_page_}),
+		/* 0xec CALL PE */	CALL(TestPE),							/* 0xed [ED page] */StdInstr({MicroOp::SetInstructionPage, &set.ed_page}),
 		/* 0xee XOR n */	StdInstr(ReadInc(pc_, temp8_), {MicroOp::Xor, &temp8_}),
 		/* 0xef RST 28h */	RST(),
 		/* 0xf0 RET p */	RET(TestP),								/* 0xf1 POP AF */	StdInstr(Pop(temp16_), {MicroOp::DisassembleAF}),
@@ -508,7 +524,7 @@ void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair1
 		/* 0xf7 RST 30h */	RST(),
 		/* 0xf8 RET M */	RET(TestM),								/* 0xf9 LD SP, HL */Instr(8, {MicroOp::Move16, &index.full, &sp_.full}),
 		/* 0xfa JP M */		JP(TestM),								/* 0xfb EI */		StdInstr({MicroOp::EI}),
-		/* 0xfc CALL M */	CALL(TestM),							/* 0xfd [FD page] */StdInstr({MicroOp::SetInstructionPage, &fd_page_}),
+		/* 0xfc CALL M */	CALL(TestM),							/* 0xfd [FD page] */StdInstr({MicroOp::SetInstructionPage, &set.fd_page}),
 		/* 0xfe CP n */		StdInstr(ReadInc(pc_, temp8_), {MicroOp::CP8, &temp8_}),
 		/* 0xff RST 38h */	RST(),
 	};
@@ -522,11 +538,11 @@ void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair1
 		std::memcpy(&base_program_table[0x36], &copy_table[0], sizeof(copy_table[0]));
 	}
 
-	assemble_cb_page(cb_page, index, add_offsets);
-	assemble_page(target, base_program_table, add_offsets);
+	assemble_cb_page(cb_page, index, add_offsets, uses_wait_line);
+	assemble_page(target, base_program_table, add_offsets, uses_wait_line);
 }
 
-void ProcessorStorage::assemble_fetch_decode_execute(InstructionPage &target, int length) {
+void ProcessorStorage::assemble_fetch_decode_execute(InstructionPage &target, int length, bool uses_wait_line) {
 	const MicroOp normal_fetch_decode_execute[] = {
 		BusOp(ReadOpcodeStart()),
 		BusOp(ReadOpcodeWait(true)),
@@ -540,6 +556,125 @@ void ProcessorStorage::assemble_fetch_decode_execute(InstructionPage &target, in
 		BusOp(ReadOpcodeEnd()),
 		{ MicroOp::DecodeOperation }
 	};
-	copy_program((length == 4) ? normal_fetch_decode_execute : short_fetch_decode_execute, target.fetch_decode_execute);
+	copy_program((length == 4) ? normal_fetch_decode_execute : short_fetch_decode_execute, target.fetch_decode_execute, uses_wait_line);
 	target.fetch_decode_execute_data = target.fetch_decode_execute.data();
 }
+
+uint16_t ProcessorStorage::offset_of(const void *pointer) {
+	if(!pointer) return NoOperand;
+
+	const auto offset = static_cast<const uint8_t *>(pointer) - reinterpret_cast<const uint8_t *>(this);
+	assert(offset >= 0 && offset < NoOperand && std::size_t(offset) < sizeof(ProcessorStorage));
+	return static_cast<uint16_t>(offset);
+}
+
+ProcessorStorage::SharedMicroOp ProcessorStorage::share(const MicroOp &op) {
+	SharedMicroOp result;
+	result.type = op.type;
+
+	switch(op.type) {
+		// Conditionals and page changes refer to other parts of the shared instruction set
+		// rather than to this instance's state, so retain their pointers as-is.
+		case MicroOp::TestNZ:	case MicroOp::TestZ:
+		case MicroOp::TestNC:	case MicroOp::TestC:
+		case MicroOp::TestPO:	case MicroOp::TestPE:
+		case MicroOp::TestP:	case MicroOp::TestM:
+		case MicroOp::SetInstructionPage:
+			result.target = op.source;
+		break;
+
+		default:
+			result.source = offset_of(op.source);
+			result.destination = offset_of(op.destination);
+		break;
+	}
+
+	if(op.type == MicroOp::BusOperation) {
+		result.machine_cycle.operation = op.machine_cycle.operation;
+		result.machine_cycle.length = op.machine_cycle.length;
+		result.machine_cycle.address = offset_of(op.machine_cycle.address);
+		result.machine_cycle.value = offset_of(op.machine_cycle.value);
+		result.machine_cycle.was_requested = op.machine_cycle.was_requested;
+	}
+
+	return result;
+}
+
+#define isTerminal(n)	(n == MicroOp::MoveToNextProgram || n == MicroOp::DecodeOperation || n == MicroOp::DecodeOperationNoRChange)
+
+bool ProcessorStorage::is_omitted_wait(const MicroOp &op, bool uses_wait_line) {
+	// Optional waits are omitted if this instance doesn't use the wait line.
+	return op.machine_cycle.was_requested && !uses_wait_line;
+}
+
+void ProcessorStorage::assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets, bool uses_wait_line) {
+	std::size_t number_of_micro_ops = 0;
+	std::size_t lengths[256];
+
+	// Count number of micro-ops required.
+	for(int c = 0; c < 256; c++) {
+		std::size_t length = 0;
+		while(!isTerminal(table[c][length].type)) length++;
+		length++;
+		lengths[c] = length;
+		number_of_micro_ops += length;
+	}
+
+	// Allocate a landing area.
+	std::vector<std::size_t> operation_indices;
+	target.all_operations.reserve(number_of_micro_ops);
+	target.instructions.resize(256, nullptr);
+
+	// Copy in all programs, recording where they go.
+	for(std::size_t c = 0; c < 256; c++) {
+		operation_indices.push_back(target.all_operations.size());
+		for(std::size_t t = 0; t < lengths[c];) {
+			// Skip zero-length bus cycles.
+			if(table[c][t].type == MicroOp::BusOperation && table[c][t].machine_cycle.length.as_integral() == 0) {
+				t++;
+				continue;
+			}
+
+			if(is_omitted_wait(table[c][t], uses_wait_line)) {
+				t++;
+				continue;
+			}
+
+			// If an index placeholder is hit then drop it, and if offsets aren't being added,
+			// then also drop the indexing that follows, which is assumed to be everything
+			// up to and including the next ::CalculateIndexAddress. Coupled to the INDEX() macro.
+			if(table[c][t].type == MicroOp::IndexedPlaceHolder) {
+				t++;
+				if(!add_offsets) {
+					while(table[c][t].type != MicroOp::CalculateIndexAddress) t++;
+					t++;
+				}
+			}
+			target.all_operations.emplace_back(share(table[c][t]));
+			t++;
+		}
+	}
+
+	// Since the vector won't change again, it's now safe to set pointers.
+	std::size_t c = 0;
+	for(std::size_t index : operation_indices) {
+		target.instructions[c] = &target.all_operations[index];
+		c++;
+	}
+}
+
+void ProcessorStorage::copy_program(const MicroOp *source, std::vector<SharedMicroOp> &destination, bool uses_wait_line) {
+	std::size_t pointer = 0;
+	while(true) {
+		if(is_omitted_wait(source[pointer], uses_wait_line)) {
+			pointer++;
+			continue;
+		}
+
+		destination.emplace_back(share(source[pointer]));
+		if(isTerminal(source[pointer].type)) break;
+		pointer++;
+	}
+}
+
+#undef isTerminal
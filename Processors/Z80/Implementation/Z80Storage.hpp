@@ -101,21 +101,71 @@ class ProcessorStorage {
 			PartialMachineCycle machine_cycle;
 		};
 
+		static constexpr uint16_t NoOperand = 0xffff;
+
+		/*!
+			A partial machine cycle as retained in the shared program tables: the address and value
+			are byte offsets from the start of the owning ProcessorStorage rather than pointers, or
+			@c NoOperand if the cycle has no address or value.
+		*/
+		struct MachineCycle {
+			PartialMachineCycle::Operation operation = PartialMachineCycle::Internal;
+			HalfCycles length;
+			uint16_t address = NoOperand;
+			uint16_t value = NoOperand;
+			bool was_requested = false;
+		};
+
+		/*!
+			The form in which micro-ops are actually retained and executed. A MicroOp is written in terms of
+			pointers to the registers of whichever instance assembled it; a SharedMicroOp instead records register
+			operands as offsets from the start of the ProcessorStorage so that one set of tables can serve every
+			Z80 in the process.
+		*/
+		struct SharedMicroOp {
+			MicroOp::Type type;
+			uint16_t source = NoOperand;
+			uint16_t destination = NoOperand;
+
+			/// For conditionals, the program to switch to if the condition fails; for SetInstructionPage, the new page.
+			const void *target = nullptr;
+
+			MachineCycle machine_cycle;
+		};
+
 		struct InstructionPage {
-			std::vector<MicroOp *> instructions;
-			std::vector<MicroOp> all_operations;
-			std::vector<MicroOp> fetch_decode_execute;
-			MicroOp *fetch_decode_execute_data;
-			uint8_t r_step;
-			bool is_indexed;
-
-			InstructionPage() : r_step(1), is_indexed(false) {}
+			std::vector<const SharedMicroOp *> instructions;
+			std::vector<SharedMicroOp> all_operations;
+			std::vector<SharedMicroOp> fetch_decode_execute;
+			const SharedMicroOp *fetch_decode_execute_data = nullptr;
+			uint8_t r_step = 1;
+			bool is_indexed = false;
+		};
+
+		/*!
+			All the programs a Z80 may run. Exactly two of these are built per process, one for processors that
+			observe the wait line and one for those that don't, and are then shared by every instance.
+		*/
+		struct InstructionSet {
+			InstructionPage base_page;
+			InstructionPage ed_page;
+			InstructionPage fd_page;
+			InstructionPage dd_page;
+
+			InstructionPage cb_page;
+			InstructionPage fdcb_page;
+			InstructionPage ddcb_page;
+
+			std::vector<SharedMicroOp> conditional_call_untaken_program;
+			std::vector<SharedMicroOp> reset_program;
+			std::vector<SharedMicroOp> irq_program[3];
+			std::vector<SharedMicroOp> nmi_program;
 		};
 
 		typedef MicroOp InstructionTable[256][30];
 
 		ProcessorStorage();
-		void install_default_instruction_set();
+		void install_default_instruction_set(bool uses_wait_line);
 
 		uint8_t a_;
 		RegisterPair16 bc_, de_, hl_;
@@ -140,6 +190,23 @@ class ProcessorStorage {
 
 		HalfCycles number_of_cycles_;
 
+		/*
+			The memory map, as used only by processors that use a memory map; direct_cycles_
+			accumulates time spent on cycles that were performed without the bus handler.
+		*/
+		const uint8_t *const *read_pages_ = nullptr;
+		uint8_t *const *write_pages_ = nullptr;
+		const HalfCycles *page_wait_states_ = nullptr;
+		HalfCycles opcode_wait_states_;
+		int page_size_shift_ = 14;
+		uint16_t page_offset_mask_ = 0x3fff;
+		HalfCycles direct_cycles_;
+
+		/*
+			Idle-loop detection, if enabled.
+		*/
+		IdleLoopDetector idle_loop_detector_;
+
 		enum Interrupt: uint8_t {
 			IRQ			= 0x01,
 			NMI			= 0x02,
@@ -156,22 +223,89 @@ class ProcessorStorage {
 		RegisterPair16 temp16_, memptr_;
 		uint8_t temp8_;
 
-		const MicroOp *scheduled_program_counter_ = nullptr;
+		const SharedMicroOp *scheduled_program_counter_ = nullptr;
 
-		std::vector<MicroOp> conditional_call_untaken_program_;
-		std::vector<MicroOp> reset_program_;
-		std::vector<MicroOp> irq_program_[3];
-		std::vector<MicroOp> nmi_program_;
-		InstructionPage *current_instruction_page_;
+		const InstructionSet *instruction_set_ = nullptr;
+		const InstructionPage *current_instruction_page_ = nullptr;
 
-		InstructionPage base_page_;
-		InstructionPage ed_page_;
-		InstructionPage fd_page_;
-		InstructionPage dd_page_;
+		/*!
+			@returns A reference to the register or other piece of processor state at @c offset bytes
+			from the start of this ProcessorStorage.
+		*/
+		template <typename IntT> forceinline IntT &operand(uint16_t offset) {
+			return *reinterpret_cast<IntT *>(reinterpret_cast<uint8_t *>(this) + offset);
+		}
 
-		InstructionPage cb_page_;
-		InstructionPage fdcb_page_;
-		InstructionPage ddcb_page_;
+		/*!
+			@returns The PartialMachineCycle described by @c cycle, with register offsets resolved
+			against this instance.
+		*/
+		forceinline PartialMachineCycle partial_machine_cycle(const MachineCycle &cycle) {
+			return PartialMachineCycle(
+				cycle.operation,
+				cycle.length,
+				(cycle.address == NoOperand) ? nullptr : &operand<uint16_t>(cycle.address),
+				(cycle.value == NoOperand) ? nullptr : &operand<uint8_t>(cycle.value),
+				cycle.was_requested);
+		}
+
+		/*!
+			Attempts to perform @c cycle without involving the bus handler, which is possible for memory accesses
+			to pages that are present in the memory map and for any cycle that doesn't expect action other than
+			a wait state. Time spent is added to direct_cycles_, and any wait states for the page accessed or for
+			an opcode fetch are also deducted from number_of_cycles_.
+
+			@returns @c true if the cycle was performed; @c false if it must be communicated to the bus handler.
+		*/
+		forceinline bool perform_direct_access(const MachineCycle &cycle) {
+			if(cycle.was_requested || !read_pages_) return false;
+
+			switch(cycle.operation) {
+				case PartialMachineCycle::ReadOpcode:
+				case PartialMachineCycle::Read: {
+					const uint16_t address = operand<uint16_t>(cycle.address);
+					const uint8_t *const page = read_pages_[address >> page_size_shift_];
+					if(!page) return false;
+
+					operand<uint8_t>(cycle.value) = page[address & page_offset_mask_];
+					add_direct_cycles(cycle.length, address);
+					if(cycle.operation == PartialMachineCycle::ReadOpcode) {
+						add_wait_states(opcode_wait_states_);
+					}
+				} return true;
+
+				case PartialMachineCycle::Write: {
+					const uint16_t address = operand<uint16_t>(cycle.address);
+					uint8_t *const page = write_pages_[address >> page_size_shift_];
+					if(!page) return false;
+
+					page[address & page_offset_mask_] = operand<uint8_t>(cycle.value);
+					add_direct_cycles(cycle.length, address);
+				} return true;
+
+				case PartialMachineCycle::Input:
+				case PartialMachineCycle::Output:
+				case PartialMachineCycle::Interrupt:
+				case PartialMachineCycle::BusAcknowledge:
+				return false;
+
+				default:
+					direct_cycles_ += cycle.length;
+				return true;
+			}
+		}
+
+		forceinline void add_direct_cycles(HalfCycles length, uint16_t address) {
+			direct_cycles_ += length;
+			if(page_wait_states_) {
+				add_wait_states(page_wait_states_[address >> page_size_shift_]);
+			}
+		}
+
+		forceinline void add_wait_states(HalfCycles wait_states) {
+			direct_cycles_ += wait_states;
+			number_of_cycles_ -= wait_states;
+		}
 
 		/*!
 			Gets the flags register.
@@ -209,12 +343,17 @@ class ProcessorStorage {
 			carry_result_			= flags;
 		}
 
-		virtual void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets) = 0;
-		virtual void copy_program(const MicroOp *source, std::vector<MicroOp> &destination) = 0;
-
-		void assemble_fetch_decode_execute(InstructionPage &target, int length);
-		void assemble_ed_page(InstructionPage &target);
-		void assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets);
-		void assemble_base_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page);
+	private:
+		void assemble_instruction_set(InstructionSet &set, bool uses_wait_line);
+		void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets, bool uses_wait_line);
+		void copy_program(const MicroOp *source, std::vector<SharedMicroOp> &destination, bool uses_wait_line);
+		static bool is_omitted_wait(const MicroOp &op, bool uses_wait_line);
+		SharedMicroOp share(const MicroOp &op);
+		uint16_t offset_of(const void *pointer);
+
+		void assemble_fetch_decode_execute(InstructionPage &target, int length, bool uses_wait_line);
+		void assemble_ed_page(InstructionPage &target, bool uses_wait_line);
+		void assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, bool uses_wait_line);
+		void assemble_base_page(InstructionSet &set, InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page, bool uses_wait_line);
 
 };
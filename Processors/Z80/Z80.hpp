@@ -13,6 +13,7 @@
 #include <vector>
 #include <cstdint>
 
+#include "../IdleLoopDetector.hpp"
 #include "../RegisterSizes.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../ClockReceiver/ForceInline.hpp"
@@ -126,7 +127,8 @@ struct PartialMachineCycle {
 	}
 
 	PartialMachineCycle(const PartialMachineCycle &rhs) noexcept;
-	PartialMachineCycle(Operation operation, HalfCycles length, uint16_t *address, uint8_t *value, bool was_requested) noexcept;
+	PartialMachineCycle(Operation operation, HalfCycles length, uint16_t *address, uint8_t *value, bool was_requested) noexcept :
+		operation(operation), length(length), address(address), value(value), was_requested(was_requested) {}
 	PartialMachineCycle() noexcept;
 };
 
@@ -149,6 +151,24 @@ class BusHandler {
 			return HalfCycles(0);
 		}
 
+		/*!
+			Announces that the Z80 is in an idle loop: a short loop that has run at least twice, each time
+			returning to its start in the same state, taking @c iteration_length, performing no output and
+			making the same memory writes. This is called only by processors that have had idle-loop detection
+			enabled, at the start of an iteration.
+
+			Machines may skip any whole number of further iterations for which they know that nothing the loop
+			reads will change, e.g. until the next scheduled interrupt or video event, by advancing their
+			components as if that time had been spent within perform_machine_cycle. Any machine on which a
+			memory write may have a side effect should decline if the loop made such a write.
+
+			@returns The amount of time skipped, which should be a multiple of @c iteration_length and no
+			greater than @c available.
+		*/
+		HalfCycles skip_idle_loop(HalfCycles iteration_length, HalfCycles available) {
+			return HalfCycles(0);
+		}
+
 		/*!
 			Announces completion of all the cycles supplied to a .run_for request on the Z80. Intended to allow
 			bus handlers to perform any deferred output work.
@@ -224,6 +244,33 @@ class ProcessorBase: public ProcessorStorage {
 			reset at the first opportunity. Use @c reset_power_on to disable that behaviour.
 		*/
 		void reset_power_on();
+
+		/*!
+			Supplies the memory map that a processor which uses a memory map will consult in order to perform
+			ordinary memory accesses itself, without calling the bus handler. Each array should contain one pointer
+			per page; a pointer is to the memory that should be accessed for that page or nullptr if accesses to
+			that page must instead be communicated to the bus handler, e.g. because it is paged by writes to it.
+			The arrays are retained rather than copied, so subsequent changes to their contents take effect immediately.
+			Supplying a nullptr @c read_pages disables the memory map, so that every partial machine cycle is again
+			communicated to the bus handler.
+
+			Processors that do not use a memory map ignore it.
+
+			@param read_pages The table that is consulted for reads, including opcode fetches.
+			@param write_pages The table that is consulted for writes.
+			@param page_size_shift The base-2 logarithm of the page size, e.g. 14 for 16kb pages.
+			@param wait_states If not nullptr, a table containing the number of additional HalfCycles that
+			should be added to every access to each page that is performed via the memory map.
+			@param opcode_wait_states The number of additional HalfCycles that should be added to every
+			opcode fetch that is performed via the memory map, e.g. to model a wait state inserted during M1.
+		*/
+		void set_memory_map(const uint8_t *const *read_pages, uint8_t *const *write_pages, int page_size_shift = 14, const HalfCycles *wait_states = nullptr, HalfCycles opcode_wait_states = HalfCycles(0));
+
+		/*!
+			Enables or disables idle-loop detection; if enabled then the bus handler's @c skip_idle_loop
+			will be called whenever the Z80 appears to be in an idle loop. Detection is disabled by default.
+		*/
+		void set_idle_loop_detection_enabled(bool enabled);
 };
 
 /*!
@@ -233,8 +280,17 @@ class ProcessorBase: public ProcessorStorage {
 	will announce its activity via the bus handler, which is responsible for marrying it to a bus. Users
 	can also nominate whether the processor includes support for the bus request and/or wait lines. Declining to
 	support either can produce a minor runtime performance improvement.
+
+	Users may also nominate that the processor uses a memory map, as supplied via @c set_memory_map. If so then
+	reads and writes to mapped pages, and all partial machine cycles that do not expect action, are performed
+	without calling the bus handler; the time they take is instead announced as a single Internal partial machine
+	cycle at the end of each instruction and before any other call to the bus handler. If the processor also
+	observes the wait line then that time is also announced before each point at which the wait line is sampled,
+	giving the bus handler the opportunity to update it. This is appropriate only for machines that do not observe
+	refresh cycles or otherwise need to see the individual phases of memory accesses, and that date any change
+	to the interrupt lines that they make during an announcement of direct time.
 */
-template <class T, bool uses_bus_request, bool uses_wait_line> class Processor: public ProcessorBase {
+template <class T, bool uses_bus_request, bool uses_wait_line, bool uses_memory_map = false> class Processor: public ProcessorBase {
 	public:
 		Processor(T &bus_handler);
 
@@ -271,9 +327,6 @@ template <class T, bool uses_bus_request, bool uses_wait_line> class Processor:
 
 	private:
 		T &bus_handler_;
-
-		void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets);
-		void copy_program(const MicroOp *source, std::vector<MicroOp> &destination);
 };
 
 #include "Implementation/Z80Implementation.hpp"
@@ -9,8 +9,12 @@
 #ifndef DiskImage_hpp
 #define DiskImage_hpp
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "../Disk.hpp"
 #include "../Track/Track.hpp"
@@ -70,16 +74,84 @@ class DiskImage {
 };
 
 class DiskImageHolderBase: public Disk {
+	public:
+		/// The number of tracks that a holder will cache unless told otherwise.
+		static constexpr size_t DefaultMaximumCachedTracks = 64;
+
+		/*!
+			Sets the maximum number of tracks that will be cached, or 0 for no limit. Once the limit
+			is reached, the least-recently used track is discarded, to be decoded again if it is needed again.
+			Tracks that have been modified but not yet written back to the disk image are always retained.
+		*/
+		void set_maximum_cached_tracks(size_t maximum) {
+			std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+			maximum_cached_tracks_ = maximum;
+			evict();
+		}
+
+		/*!
+			Enables or disables prefetching: the decoding of tracks adjacent to the one most recently requested,
+			on a background thread. Prefetching is enabled by default if there is more than one core.
+		*/
+		void set_prefetching_enabled(bool enabled) {
+			prefetching_enabled_ = enabled;
+		}
+
 	protected:
 		std::set<Track::Address> unwritten_tracks_;
-		std::map<Track::Address, std::shared_ptr<Track>> cached_tracks_;
 		std::unique_ptr<Concurrency::AsyncTaskQueue> update_queue_;
+
+		// Tracks are cached along with the time they were last used; a track that the disk image
+		// reported as absent is cached as nullptr. All access is guarded by cache_mutex_.
+		struct CachedTrack {
+			std::shared_ptr<Track> track;
+			uint64_t last_use = 0;
+		};
+		std::map<Track::Address, CachedTrack> cached_tracks_;
+		std::set<Track::Address> pending_tracks_;	// Tracks that are queued to be written to the disk image.
+		uint64_t use_count_ = 0;
+		size_t maximum_cached_tracks_ = DefaultMaximumCachedTracks;
+		std::mutex cache_mutex_;
+
+		// Prefetching may occur concurrently with other use of the disk image, so all access
+		// to it is guarded by image_mutex_; cache_mutex_ may be acquired while holding it but not vice versa.
+		std::mutex image_mutex_;
+		std::atomic<bool> prefetching_enabled_ = std::thread::hardware_concurrency() > 1;
+		bool has_last_address_ = false;
+		Track::Address last_address_ = Track::Address(0, HeadPosition(0));
+
+		/// Adds or replaces a track in the cache, then evicts as necessary. cache_mutex_ must be held.
+		void cache(Track::Address address, const std::shared_ptr<Track> &track) {
+			auto &entry = cached_tracks_[address];
+			entry.track = track;
+			entry.last_use = ++use_count_;
+			evict();
+		}
+
+		/// Discards least-recently used tracks until the cache is within its limit. cache_mutex_ must be held.
+		void evict() {
+			if(!maximum_cached_tracks_) return;
+			while(cached_tracks_.size() > maximum_cached_tracks_) {
+				auto victim = cached_tracks_.end();
+				for(auto iterator = cached_tracks_.begin(); iterator != cached_tracks_.end(); ++iterator) {
+					if(unwritten_tracks_.count(iterator->first) || pending_tracks_.count(iterator->first)) continue;
+					if(victim == cached_tracks_.end() || iterator->second.last_use < victim->second.last_use) {
+						victim = iterator;
+					}
+				}
+				if(victim == cached_tracks_.end()) return;
+				cached_tracks_.erase(victim);
+			}
+		}
 };
 
 /*!
 	Provides a wrapper that wraps a DiskImage to make it into a Disk, providing caching and,
 	thereby, an intermediate store for modified tracks so that mutable disk images can either
 	update on the fly or perform a block update on closure, as appropriate.
+
+	Tracks adjacent to each newly-requested track are decoded in advance on a background queue,
+	so that stepping the head needn't wait for decoding.
 */
 template <typename T> class DiskImageHolder: public DiskImageHolderBase {
 	public:
@@ -96,6 +168,8 @@ template <typename T> class DiskImageHolder: public DiskImageHolderBase {
 
 	private:
 		T disk_image_;
+
+		void prefetch(Track::Address address);
 };
 
 #include "DiskImageImplementation.hpp"
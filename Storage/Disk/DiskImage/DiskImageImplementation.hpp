@@ -19,42 +19,128 @@ template <typename T> bool DiskImageHolder<T>::get_is_read_only() {
 }
 
 template <typename T> void DiskImageHolder<T>::flush_tracks() {
-	if(!unwritten_tracks_.empty()) {
-		if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue>();
+	using TrackMap = std::map<Track::Address, std::shared_ptr<Track>>;
+	std::shared_ptr<TrackMap> track_copies;
+	{
+		std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+		if(unwritten_tracks_.empty()) return;
 
-		using TrackMap = std::map<Track::Address, std::shared_ptr<Track>>;
-		std::shared_ptr<TrackMap> track_copies(new TrackMap);
+		track_copies = std::make_shared<TrackMap>();
 		for(const auto &address : unwritten_tracks_) {
-			track_copies->insert(std::make_pair(address, std::shared_ptr<Track>(cached_tracks_[address]->clone())));
+			track_copies->insert(std::make_pair(address, std::shared_ptr<Track>(cached_tracks_[address].track->clone())));
+			pending_tracks_.insert(address);
 		}
 		unwritten_tracks_.clear();
+	}
 
-		update_queue_->enqueue([this, track_copies]() {
+	if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue>();
+	update_queue_->enqueue([this, track_copies]() {
+		{
+			std::lock_guard<std::mutex> lock_guard(image_mutex_);
 			disk_image_.set_tracks(*track_copies);
-		});
-	}
+		}
+
+		// The disk image is now up to date, so these tracks may be evicted if necessary.
+		std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+		for(const auto &track: *track_copies) {
+			pending_tracks_.erase(track.first);
+		}
+		evict();
+	});
 }
 
 template <typename T> void DiskImageHolder<T>::set_track_at_position(Track::Address address, const std::shared_ptr<Track> &track) {
 	if(disk_image_.get_is_read_only()) return;
 
+	std::lock_guard<std::mutex> lock_guard(cache_mutex_);
 	unwritten_tracks_.insert(address);
-	cached_tracks_[address] = track;
+	cache(address, track);
 }
 
 template <typename T> std::shared_ptr<Track> DiskImageHolder<T>::get_track_at_position(Track::Address address) {
 	if(address.head >= get_head_count()) return nullptr;
 	if(address.position >= get_maximum_head_position()) return nullptr;
 
+	// Upon any movement, start decoding whatever is nearby.
+	if(prefetching_enabled_ && (!has_last_address_ || address.head != last_address_.head || address.position != last_address_.position)) {
+		has_last_address_ = true;
+		last_address_ = address;
+		prefetch(address);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+		auto cached_track = cached_tracks_.find(address);
+		if(cached_track != cached_tracks_.end()) {
+			cached_track->second.last_use = ++use_count_;
+			return cached_track->second.track;
+		}
+	}
+
+	// Decode the track now; check the cache again once the disk image is available
+	// in case it has been decoded in the meantime.
+	std::lock_guard<std::mutex> image_lock_guard(image_mutex_);
+	std::lock_guard<std::mutex> lock_guard(cache_mutex_);
 	auto cached_track = cached_tracks_.find(address);
-	if(cached_track != cached_tracks_.end()) return cached_track->second;
+	if(cached_track != cached_tracks_.end()) {
+		cached_track->second.last_use = ++use_count_;
+		return cached_track->second.track;
+	}
 
 	std::shared_ptr<Track> track = disk_image_.get_track_at_position(address);
-	if(!track) return nullptr;
-	cached_tracks_[address] = track;
+	cache(address, track);
 	return track;
 }
 
+template <typename T> void DiskImageHolder<T>::prefetch(Track::Address address) {
+	// Nominate the other heads at this position, then all heads on the neighbouring tracks.
+	std::vector<Track::Address> addresses;
+	const int head_count = get_head_count();
+	const HeadPosition maximum_position = get_maximum_head_position();
+	for(int head = 0; head < head_count; ++head) {
+		if(head != address.head) addresses.emplace_back(head, address.position);
+	}
+	for(int offset: {1, -1}) {
+		HeadPosition position = address.position;
+		position += HeadPosition(offset);
+		if(position < HeadPosition(0) || position >= maximum_position) continue;
+		for(int head = 0; head < head_count; ++head) {
+			addresses.emplace_back(head, position);
+		}
+	}
+
+	// Discard anything already cached, and don't let prefetching evict anything still likely to be useful.
+	{
+		std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+		addresses.erase(std::remove_if(addresses.begin(), addresses.end(), [this] (const Track::Address &address) {
+			return cached_tracks_.find(address) != cached_tracks_.end();
+		}), addresses.end());
+		if(maximum_cached_tracks_ && addresses.size() >= maximum_cached_tracks_) return;
+	}
+	if(addresses.empty()) return;
+
+	if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue>();
+	update_queue_->enqueue([this, addresses = std::move(addresses)] {
+		for(const auto &address: addresses) {
+			if(!prefetching_enabled_) return;
+			std::lock_guard<std::mutex> image_lock_guard(image_mutex_);
+			{
+				std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+				if(cached_tracks_.find(address) != cached_tracks_.end()) continue;
+			}
+
+			std::shared_ptr<Track> track = disk_image_.get_track_at_position(address);
+
+			std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+			if(cached_tracks_.find(address) == cached_tracks_.end()) {
+				cache(address, track);
+			}
+		}
+	});
+}
+
 template <typename T> DiskImageHolder<T>::~DiskImageHolder() {
+	// Abandon any outstanding prefetches, but make sure all writes are complete.
+	prefetching_enabled_ = false;
 	if(update_queue_) update_queue_->flush();
 }
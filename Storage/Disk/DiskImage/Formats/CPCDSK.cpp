@@ -13,6 +13,8 @@
 #include "../../Encodings/MFM/SegmentParser.hpp"
 #include "../../Track/TrackSerialiser.hpp"
 
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 
 using namespace Storage::Disk;
@@ -167,7 +169,8 @@ CPCDSK::CPCDSK(const std::string &file_name) :
 			}
 
 			// Sector contents are at offset 0x100 into the track.
-			file.seek(file_offset + 0x100, SEEK_SET);
+			track->file_offset = file_offset + 0x100;
+			file.seek(track->file_offset, SEEK_SET);
 			for(auto &sector: track->sectors) {
 				for(auto &data : sector.samples) {
 					file.read(data.data(), data.size());
@@ -218,6 +221,40 @@ std::shared_ptr<Track> CPCDSK::get_track_at_position(::Storage::Disk::Track::Add
 }
 
 void CPCDSK::set_tracks(const std::map<::Storage::Disk::Track::Address, std::shared_ptr<::Storage::Disk::Track>> &tracks) {
+	// A track can be patched in place if it is already in the file and has kept its layout, i.e. every
+	// sector has the same address, size and status as before; in that case only sector contents have changed.
+	const auto can_patch = [] (const Track &track, const std::map<std::size_t, Storage::Encodings::MFM::Sector> &sectors) {
+		if(track.file_offset < 0 || track.sectors.size() != sectors.size()) return false;
+
+		auto source = sectors.begin();
+		for(const auto &sector: track.sectors) {
+			const auto &source_sector = source->second;
+			++source;
+
+			if(
+				sector.address.track != source_sector.address.track ||
+				sector.address.side != source_sector.address.side ||
+				sector.address.sector != source_sector.address.sector ||
+				sector.size != source_sector.size ||
+				sector.has_data_crc_error != source_sector.has_data_crc_error ||
+				sector.has_header_crc_error != source_sector.has_header_crc_error ||
+				sector.is_deleted != source_sector.is_deleted
+			) return false;
+
+			if(
+				sector.samples.size() != 1 ||
+				source_sector.samples.size() != 1 ||
+				sector.samples[0].size() != source_sector.samples[0].size()
+			) return false;
+		}
+		return true;
+	};
+
+	// Changed sector contents to write into the existing file, as runs of bytes keyed by file offset;
+	// sectors are stored contiguously so adjacent changes are coalesced into single writes.
+	std::vector<std::pair<long, std::vector<uint8_t>>> patches;
+	bool requires_rewrite = false;
+
 	// Patch changed tracks into the disk image.
 	for(auto &pair: tracks) {
 		// Assume MFM for now; with extensions DSK can contain FM tracks.
@@ -249,6 +286,27 @@ void CPCDSK::set_tracks(const std::map<::Storage::Disk::Track::Address, std::sha
 			tracks_[chronological_track] = std::unique_ptr<Track>(track);
 		}
 
+		if(!requires_rewrite && can_patch(*track, sectors)) {
+			long offset = track->file_offset;
+			auto source = sectors.begin();
+			for(auto &sector: track->sectors) {
+				auto &data = source->second.samples[0];
+				++source;
+
+				if(data != sector.samples[0]) {
+					if(!patches.empty() && patches.back().first + static_cast<long>(patches.back().second.size()) == offset) {
+						patches.back().second.insert(patches.back().second.end(), data.begin(), data.end());
+					} else {
+						patches.emplace_back(offset, data);
+					}
+					sector.samples[0] = std::move(data);
+				}
+				offset += static_cast<long>(sector.samples[0].size());
+			}
+			continue;
+		}
+		requires_rewrite = true;
+
 		// Store sectors.
 		track->sectors.clear();
 		for(auto &source_sector: sectors) {
@@ -271,8 +329,51 @@ void CPCDSK::set_tracks(const std::map<::Storage::Disk::Track::Address, std::sha
 		}
 	}
 
-	// Rewrite the entire disk image, in extended form.
-	Storage::FileHolder output(file_name_, Storage::FileHolder::FileMode::Rewrite);
+	if(requires_rewrite) {
+		rewrite();
+		return;
+	}
+
+	if(patches.empty()) return;
+	Storage::FileHolder output(file_name_);
+	for(const auto &patch: patches) {
+		output.seek(patch.first, SEEK_SET);
+		output.write(patch.second);
+	}
+}
+
+void CPCDSK::rewrite() {
+	// Rewrite the entire disk image. This is done to a temporary file that then replaces the original,
+	// so that the original remains intact if the process is interrupted.
+	const std::string temporary_file_name = file_name_ + ".tmp";
+	std::vector<long> file_offsets;
+	bool rewrite_in_place = false;
+	try {
+		file_offsets = write_image(temporary_file_name);
+
+		// If the original couldn't be replaced, e.g. on platforms where rename won't overwrite an existing file,
+		// write to it directly so that the change isn't lost.
+		if(std::rename(temporary_file_name.c_str(), file_name_.c_str())) {
+			std::remove(temporary_file_name.c_str());
+			rewrite_in_place = true;
+		}
+	} catch(Storage::FileHolder::Error) {
+		// The temporary file couldn't be created, e.g. because the enclosing directory isn't writeable.
+		rewrite_in_place = true;
+	}
+	if(rewrite_in_place) {
+		file_offsets = write_image(file_name_);
+	}
+
+	for(std::size_t index = 0; index < tracks_.size(); ++index) {
+		if(tracks_[index]) tracks_[index]->file_offset = file_offsets[index];
+	}
+}
+
+std::vector<long> CPCDSK::write_image(const std::string &file_name) {
+	// Output the entire disk image, in extended form.
+	std::vector<long> file_offsets(tracks_.size(), -1);
+	Storage::FileHolder output(file_name, Storage::FileHolder::FileMode::Rewrite);
 	output.write(reinterpret_cast<const uint8_t *>("EXTENDED CPC DSK File\r\nDisk-Info\r\n"), 34);
 	output.write(reinterpret_cast<const uint8_t *>("Clock Signal  "), 14);
 	output.put8(static_cast<uint8_t>(head_position_count_));
@@ -369,6 +470,7 @@ void CPCDSK::set_tracks(const std::map<::Storage::Disk::Track::Address, std::sha
 		output.putn(static_cast<std::size_t>(distance), 0);
 
 		// Output sector contents.
+		file_offsets[index] = output.tell();
 		for(auto &sector: track->sectors) {
 			for(auto &sample: sector.samples) {
 				output.write(sample);
@@ -379,6 +481,7 @@ void CPCDSK::set_tracks(const std::map<::Storage::Disk::Track::Address, std::sha
 		distance = (256 - (output.tell()&255))&255;
 		output.putn(static_cast<std::size_t>(distance), 0);
 	}
+	return file_offsets;
 }
 
 bool CPCDSK::get_is_read_only() {
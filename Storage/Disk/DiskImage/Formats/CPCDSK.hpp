@@ -60,10 +60,19 @@ class CPCDSK: public DiskImage {
 			};
 
 			std::vector<Sector> sectors;
+
+			// The offset within the file of this track's sector contents, or -1 if the track is not yet in the file.
+			long file_offset = -1;
 		};
 		std::string file_name_;
 		std::vector<std::unique_ptr<Track>> tracks_;
 		std::size_t index_for_track(::Storage::Disk::Track::Address address);
+		void rewrite();
+
+		/// Writes the entire disk image to @c file_name, in extended form.
+		/// @returns The file offset of each track's sector contents, as per @c Track::file_offset.
+		/// @throws Storage::FileHolder::Error::CantOpen if the file can't be opened for writing.
+		std::vector<long> write_image(const std::string &file_name);
 
 		int head_count_;
 		int head_position_count_;
@@ -28,6 +28,14 @@ G64::G64(const std::string &file_name) :
 	// get the number of tracks and track size
 	number_of_tracks_ = file_.get8();
 	maximum_track_size_ = file_.get16le();
+
+	// read the track offset table and then the speed zone table, which immediately follows it
+	for(auto table: {&track_offsets_, &speed_zone_offsets_}) {
+		for(uint8_t c = 0; c < number_of_tracks_; ++c) {
+			table->push_back(file_.get32le());
+		}
+	}
+	if(file_.eof()) throw Error::InvalidFormat;
 }
 
 HeadPosition G64::get_maximum_head_position() {
@@ -39,11 +47,10 @@ HeadPosition G64::get_maximum_head_position() {
 std::shared_ptr<Track> G64::get_track_at_position(Track::Address address) {
 	std::shared_ptr<Track> resulting_track;
 
-	// seek to this track's entry in the track table
-	file_.seek(static_cast<long>((address.position.as_half() * 4) + 0xc), SEEK_SET);
-
-	// read the track offset
-	const uint32_t track_offset = file_.get32le();
+	// look up the track offset
+	const auto table_position = static_cast<std::size_t>(address.position.as_half());
+	if(table_position >= track_offsets_.size()) return nullptr;
+	const uint32_t track_offset = track_offsets_[table_position];
 
 	// if the track offset is zero, this track doesn't exist, so...
 	if(!track_offset) return nullptr;
@@ -57,11 +64,8 @@ std::shared_ptr<Track> G64::get_track_at_position(Track::Address address) {
 	// grab the byte contents of this track
 	const std::vector<uint8_t> track_contents = file_.read(track_length);
 
-	// seek to this track's entry in the speed zone table
-	file_.seek(static_cast<long>((address.position.as_half() * 4) + 0x15c), SEEK_SET);
-
-	// read the speed zone offsrt
-	const uint32_t speed_zone_offset = file_.get32le();
+	// look up the speed zone offset
+	const uint32_t speed_zone_offset = speed_zone_offsets_[table_position];
 
 	// if the speed zone is not constant, create a track based on the whole table; otherwise create one that's constant
 	if(speed_zone_offset > 3) {
@@ -13,6 +13,7 @@
 #include "../../../FileHolder.hpp"
 
 #include <string>
+#include <vector>
 
 namespace Storage {
 namespace Disk {
@@ -40,6 +41,10 @@ class G64: public DiskImage {
 		Storage::FileHolder file_;
 		uint8_t number_of_tracks_;
 		uint16_t maximum_track_size_;
+
+		// The track offset and speed zone tables, which are read in full upon opening.
+		std::vector<uint32_t> track_offsets_;
+		std::vector<uint32_t> speed_zone_offsets_;
 };
 
 }
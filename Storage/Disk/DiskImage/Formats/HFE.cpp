@@ -23,7 +23,19 @@ HFE::HFE(const std::string &file_name) :
 	head_count_ = file_.get8();
 
 	file_.seek(7, SEEK_CUR);
-	track_list_offset_ = static_cast<long>(file_.get16le()) << 9;
+	const long track_list_offset = static_cast<long>(file_.get16le()) << 9;
+
+	// Read the track list, which gives the position and length of each track.
+	file_.seek(track_list_offset, SEEK_SET);
+	const std::vector<uint8_t> track_list = file_.read(static_cast<std::size_t>(track_count_ * 4));
+	if(track_list.size() != static_cast<std::size_t>(track_count_ * 4)) throw Error::InvalidFormat;
+
+	for(std::size_t c = 0; c < track_list.size(); c += 4) {
+		track_locations_.push_back(TrackLocation{
+			static_cast<long>(track_list[c] | (track_list[c+1] << 8)) << 9,	// Track offset, in units of 512 bytes.
+			static_cast<uint16_t>(track_list[c+2] | (track_list[c+3] << 8))
+		});
+	}
 }
 
 HeadPosition HFE::get_maximum_head_position() {
@@ -42,59 +54,49 @@ int HFE::get_head_count() {
 	skip 256 bytes, read 256 bytes, skip 256 bytes, etc.
 */
 uint16_t HFE::seek_track(Track::Address address) {
-	// Get track position and length from the lookup table; data is then always interleaved
-	// based on an assumption of two heads.
-	file_.seek(track_list_offset_ + address.position.as_int() * 4, SEEK_SET);
-
-	long track_offset = static_cast<long>(file_.get16le()) << 9;	// Track offset, in units of 512 bytes.
-	uint16_t track_length = file_.get16le();						// Track length, in bytes, containing both the front and back track.
+	// Data is always interleaved based on an assumption of two heads.
+	const auto &location = track_locations_[static_cast<std::size_t>(address.position.as_int())];
 
-	file_.seek(track_offset, SEEK_SET);
+	file_.seek(location.offset, SEEK_SET);
 	if(address.head) file_.seek(256, SEEK_CUR);
 
-	return track_length / 2;	// Divide by two to give the track length for a single side.
+	return location.length / 2;	// Divide by two to give the track length for a single side.
 }
 
 std::shared_ptr<Track> HFE::get_track_at_position(Track::Address address) {
-	PCMSegment segment;
+	if(address.position.as_int() >= track_count_) return nullptr;
+
+	// HFE tracks are stored as 256 bytes for side 1, then 256 bytes for side 2,
+	// then 256 bytes for side 1, then 256 bytes for side 2, etc, until the final
+	// 512-byte segment which will contain less than the full 256 bytes.
+	//
+	// Both sides are read with a single access and then separated.
+	const auto &location = track_locations_[static_cast<std::size_t>(address.position.as_int())];
+	const uint16_t track_length = location.length / 2;
+	std::vector<uint8_t> track_contents((static_cast<std::size_t>(track_length + 255) >> 8) << 9);
 	{
 		std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
-		uint16_t track_length = seek_track(address);
-
-		segment.data.resize(track_length * 8);
+		file_.seek(location.offset, SEEK_SET);
+		file_.read(track_contents.data(), track_contents.size());
+	}
 
-		// HFE tracks are stored as 256 bytes for side 1, then 256 bytes for side 2,
-		// then 256 bytes for side 1, then 256 bytes for side 2, etc, until the final
-		// 512-byte segment which will contain less than the full 256 bytes.
-		//
-		// seek_track will have advanced an extra initial 256 bytes if the address
-		// refers to side 2, so the loop below can act ass though it were definitely
-		// dealing with side 1.
-		uint16_t c = 0;
-		while(c < track_length) {
-			// Decide how many bytes of at most 256 to read, and read them.
-			uint16_t length = static_cast<uint16_t>(std::min(256, track_length - c));
-			std::vector<uint8_t> section = file_.read(length);
-
-			// Push those into the PCMSegment. In HFE the least-significant bit is
-			// serialised first. TODO: move this logic to PCMSegment.
-			for(uint16_t byte = 0; byte < length; ++byte) {
-				const size_t base = static_cast<size_t>(c + byte) << 3;
-				segment.data[base + 0] = !!(section[byte] & 0x01);
-				segment.data[base + 1] = !!(section[byte] & 0x02);
-				segment.data[base + 2] = !!(section[byte] & 0x04);
-				segment.data[base + 3] = !!(section[byte] & 0x08);
-				segment.data[base + 4] = !!(section[byte] & 0x10);
-				segment.data[base + 5] = !!(section[byte] & 0x20);
-				segment.data[base + 6] = !!(section[byte] & 0x40);
-				segment.data[base + 7] = !!(section[byte] & 0x80);
-			}
-
-			// Advance the target pointer, and skip the next 256 bytes of the file
-			// (which will be for the other side of the disk).
-			c += length;
-			file_.seek(256, SEEK_CUR);
-		}
+	// Push the selected side into a PCMSegment. In HFE the least-significant bit is
+	// serialised first. TODO: move this logic to PCMSegment.
+	PCMSegment segment;
+	segment.data.resize(track_length * 8);
+
+	const std::size_t side_offset = address.head ? 256 : 0;
+	for(std::size_t c = 0; c < track_length; ++c) {
+		const uint8_t source = track_contents[((c >> 8) << 9) + side_offset + (c & 255)];
+		const size_t base = c << 3;
+		segment.data[base + 0] = !!(source & 0x01);
+		segment.data[base + 1] = !!(source & 0x02);
+		segment.data[base + 2] = !!(source & 0x04);
+		segment.data[base + 3] = !!(source & 0x08);
+		segment.data[base + 4] = !!(source & 0x10);
+		segment.data[base + 5] = !!(source & 0x20);
+		segment.data[base + 6] = !!(source & 0x40);
+		segment.data[base + 7] = !!(source & 0x80);
 	}
 
 	return std::make_shared<PCMTrack>(segment);
@@ -102,6 +104,8 @@ std::shared_ptr<Track> HFE::get_track_at_position(Track::Address address) {
 
 void HFE::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
 	for(auto &track : tracks) {
+		if(track.first.position.as_int() >= track_count_) continue;
+
 		std::unique_lock<std::mutex> lock_guard(file_.get_file_access_mutex());
 		uint16_t track_length = seek_track(track.first);
 		lock_guard.unlock();
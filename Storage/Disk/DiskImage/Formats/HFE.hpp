@@ -13,6 +13,7 @@
 #include "../../../FileHolder.hpp"
 
 #include <string>
+#include <vector>
 
 namespace Storage {
 namespace Disk {
@@ -44,7 +45,13 @@ class HFE: public DiskImage {
 
 		int head_count_;
 		int track_count_;
-		long track_list_offset_;
+
+		// The track list, which is read in full upon opening.
+		struct TrackLocation {
+			long offset;		// In bytes.
+			uint16_t length;	// In bytes, containing both the front and back track.
+		};
+		std::vector<TrackLocation> track_locations_;
 };
 
 }
@@ -10,6 +10,8 @@
 
 #include "Utility/ImplicitSectors.hpp"
 
+#include <cstring>
+
 using namespace Storage::Disk;
 
 MFMSectorDump::MFMSectorDump(const std::string &file_name) : file_(file_name) {}
@@ -38,20 +40,51 @@ std::shared_ptr<Track> MFMSectorDump::get_track_at_position(Track::Address addre
 }
 
 void MFMSectorDump::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
-	uint8_t parsed_track[(128 << sector_size_)*sectors_per_track_];
-
-	// TODO: it would be more efficient from a file access and locking point of view to parse the sectors
-	// in one loop, then write in another.
+	const std::size_t sector_length = static_cast<std::size_t>(128 << sector_size_);
+	const std::size_t track_length = sector_length * static_cast<std::size_t>(sectors_per_track_);
+	uint8_t original_track[track_length];
+	uint8_t parsed_track[track_length];
 
 	for(const auto &track : tracks) {
+		const long file_offset = get_file_offset_for_position(track.first);
+
+		// Start from the track as currently stored, so that any sector that can't be decoded
+		// retains its existing contents, and so that unchanged sectors can be identified.
+		std::size_t stored_length;
+		{
+			std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
+			file_.seek(file_offset, SEEK_SET);
+			stored_length = file_.read(original_track, track_length);
+		}
+		std::memset(&original_track[stored_length], 0, track_length - stored_length);
+		std::memcpy(parsed_track, original_track, track_length);
+
 		// Assumption here: sector IDs will run from 0.
 		decode_sectors(*track.second, parsed_track, first_sector_, first_sector_ + static_cast<uint8_t>(sectors_per_track_-1), sector_size_, is_double_density_);
-		const long file_offset = get_file_offset_for_position(track.first);
+
+		// Write only those sectors that have changed, coalescing runs of adjacent sectors;
+		// any part of the track that lies beyond the current end of file counts as changed.
+		const auto is_dirty = [&] (std::size_t index) {
+			const std::size_t offset = index * sector_length;
+			return offset + sector_length > stored_length || std::memcmp(&original_track[offset], &parsed_track[offset], sector_length);
+		};
 
 		std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
-		file_.ensure_is_at_least_length(file_offset);
-		file_.seek(file_offset, SEEK_SET);
-		file_.write(parsed_track, sizeof(parsed_track));
+		std::size_t sector = 0;
+		while(sector < static_cast<std::size_t>(sectors_per_track_)) {
+			if(!is_dirty(sector)) {
+				++sector;
+				continue;
+			}
+
+			const std::size_t first_dirty_sector = sector;
+			while(sector < static_cast<std::size_t>(sectors_per_track_) && is_dirty(sector)) ++sector;
+
+			const long run_offset = file_offset + static_cast<long>(first_dirty_sector * sector_length);
+			file_.ensure_is_at_least_length(run_offset);
+			file_.seek(run_offset, SEEK_SET);
+			file_.write(&parsed_track[first_dirty_sector * sector_length], (sector - first_dirty_sector) * sector_length);
+		}
 	}
 	file_.flush();
 }
@@ -11,6 +11,7 @@
 #include "../../Track/PCMTrack.hpp"
 #include "../../Track/TrackSerialiser.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace Storage::Disk;
@@ -106,32 +107,33 @@ std::shared_ptr<Track> WOZ::get_track_at_position(Track::Address address) {
 	long offset = file_offset(address);
 	if(offset == NoSuchTrack) return nullptr;
 
-	// Seek to the real track.
-	std::vector<uint8_t> track_contents;
-	size_t number_of_bits;
-	{
-		std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
-		file_.seek(offset, SEEK_SET);
-
-		// In WOZ a track is up to 6646 bytes of data, followed by a two-byte record of the
-		// number of bytes that actually had data in them, then a two-byte count of the number
-		// of bits that were used. Other information follows but is not intended for emulation.
-		track_contents = file_.read(6646);
-		file_.seek(2, SEEK_CUR);
-		number_of_bits = std::min(file_.get16le(), static_cast<uint16_t>(6646*8));
-	}
+	// The whole file other than its header is already in memory, having been read in order to
+	// test the CRC, so the track is built directly from there.
+	//
+	// In WOZ a track is up to 6646 bytes of data, followed by a two-byte record of the
+	// number of bytes that actually had data in them, then a two-byte count of the number
+	// of bits that were used. Other information follows but is not intended for emulation.
+	const auto track_offset = static_cast<std::size_t>(offset - 12);
+	if(track_offset + 6650 > post_crc_contents_.size()) return nullptr;
+
+	const uint8_t *const track_contents = &post_crc_contents_[track_offset];
+	const size_t number_of_bits = std::min(static_cast<size_t>(track_contents[6648] | (track_contents[6649] << 8)), static_cast<size_t>(6646*8));
 
 	return std::make_shared<PCMTrack>(PCMSegment(number_of_bits, track_contents));
 }
 
 void WOZ::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
 	for(const auto &pair: tracks) {
+		// Tracks can't be added to a WOZ, only modified.
+		const long track_offset = file_offset(pair.first);
+		if(track_offset == NoSuchTrack) continue;
+
 		// Decode the track and store, patching into the post_crc_contents_.
 		auto segment = Storage::Disk::track_serialisation(*pair.second, Storage::Time(1, 50000));
 
-		auto offset = static_cast<std::size_t>(file_offset(pair.first) - 12);
+		auto offset = static_cast<std::size_t>(track_offset - 12);
 		std::vector<uint8_t> segment_bytes = segment.byte_data();
-		memcpy(&post_crc_contents_[offset - 12], segment_bytes.data(), segment_bytes.size());
+		memcpy(&post_crc_contents_[offset], segment_bytes.data(), std::min(segment_bytes.size(), static_cast<std::size_t>(6646)));
 
 		// Write number of bytes and number of bits.
 		post_crc_contents_[offset + 6646] = static_cast<uint8_t>(segment.data.size() >> 3);
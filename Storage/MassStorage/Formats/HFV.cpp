@@ -8,12 +8,16 @@
 
 #include "HFV.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace Storage::MassStorage;
 
 HFV::HFV(const std::string &file_name) : file_(file_name) {
 	// Is the file a multiple of 512 bytes in size and larger than a floppy disk?
 	const auto file_size = file_.stats().st_size;
 	if(file_size & 511 || file_size <= 800*1024) throw std::exception();
+	file_blocks_ = size_t(file_size) / get_block_size();
 
 	// TODO: check filing system for MFS, HFS or HFS+.
 }
@@ -26,15 +30,19 @@ size_t HFV::get_number_of_blocks() {
 	return mapper_.get_number_of_blocks();
 }
 
+bool HFV::is_in_file(ssize_t source_address) const {
+	return source_address >= 0 && size_t(source_address) < file_blocks_;
+}
+
 std::vector<uint8_t> HFV::get_block(size_t address) {
 	const auto written = writes_.find(address);
 	if(written != writes_.end()) return written->second;
 
 	const auto source_address = mapper_.to_source_address(address);
-	if(source_address >= 0 && size_t(source_address)*get_block_size() < size_t(file_.stats().st_size)) {
-		const long file_offset = long(get_block_size()) * long(source_address);
-		file_.seek(file_offset, SEEK_SET);
-		return mapper_.convert_source_block(source_address, file_.read(get_block_size()));
+	if(is_in_file(source_address)) {
+		std::vector<uint8_t> contents(get_block_size());
+		read(size_t(source_address), 1, contents.data());
+		return mapper_.convert_source_block(source_address, std::move(contents));
 	} else {
 		return mapper_.convert_source_block(source_address);
 	}
@@ -42,15 +50,97 @@ std::vector<uint8_t> HFV::get_block(size_t address) {
 
 void HFV::set_block(size_t address, const std::vector<uint8_t> &contents) {
 	const auto source_address = mapper_.to_source_address(address);
-	if(source_address >= 0 && size_t(source_address)*get_block_size() < size_t(file_.stats().st_size)) {
-		const long file_offset = long(get_block_size()) * long(source_address);
-		file_.seek(file_offset, SEEK_SET);
-		file_.write(contents);
+	if(is_in_file(source_address)) {
+		write(size_t(source_address), 1, contents.data());
 	} else {
 		writes_[address] = contents;
  	}
 }
 
+void HFV::get_blocks(size_t address, size_t count, uint8_t *target) {
+	const size_t block_size = get_block_size();
+	while(count) {
+		// Blocks outside of the file are either synthesised by the mapper or were written
+		// after the fact; fetch those individually.
+		const auto source_address = mapper_.to_source_address(address);
+		if(!is_in_file(source_address)) {
+			MassStorageDevice::get_blocks(address, 1, target);
+			++address;
+			--count;
+			target += block_size;
+			continue;
+		}
+
+		// Otherwise fetch as much as is contiguous within the file in one go.
+		const size_t run = std::min(count, file_blocks_ - size_t(source_address));
+		read(size_t(source_address), run, target);
+		address += run;
+		count -= run;
+		target += run * block_size;
+	}
+}
+
+void HFV::set_blocks(size_t address, size_t count, const uint8_t *source) {
+	const size_t block_size = get_block_size();
+	while(count) {
+		const auto source_address = mapper_.to_source_address(address);
+		if(!is_in_file(source_address)) {
+			MassStorageDevice::set_blocks(address, 1, source);
+			++address;
+			--count;
+			source += block_size;
+			continue;
+		}
+
+		const size_t run = std::min(count, file_blocks_ - size_t(source_address));
+		write(size_t(source_address), run, source);
+		address += run;
+		count -= run;
+		source += run * block_size;
+	}
+}
+
+void HFV::read(size_t source_address, size_t count, uint8_t *target) {
+	const size_t block_size = get_block_size();
+	const size_t read_ahead_blocks = read_ahead_.size() / block_size;
+	const bool is_sequential = source_address == next_sequential_address_;
+	next_sequential_address_ = source_address + count;
+
+	// Serve from the read-ahead buffer if possible.
+	if(source_address >= read_ahead_address_ && source_address + count <= read_ahead_address_ + read_ahead_blocks) {
+		std::memcpy(target, &read_ahead_[(source_address - read_ahead_address_) * block_size], count * block_size);
+		return;
+	}
+
+	// If this continues the previous read and is short enough, refill the read-ahead buffer
+	// from here on the assumption that reading will continue.
+	if(is_sequential && count < ReadAheadBlocks) {
+		read_ahead_address_ = source_address;
+		read_ahead_.resize(std::min(ReadAheadBlocks, file_blocks_ - source_address) * block_size);
+		file_.seek(long(source_address * block_size), SEEK_SET);
+		file_.read(read_ahead_.data(), read_ahead_.size());
+		std::memcpy(target, read_ahead_.data(), count * block_size);
+		return;
+	}
+
+	file_.seek(long(source_address * block_size), SEEK_SET);
+	file_.read(target, count * block_size);
+}
+
+void HFV::write(size_t source_address, size_t count, const uint8_t *source) {
+	const size_t block_size = get_block_size();
+	file_.seek(long(source_address * block_size), SEEK_SET);
+	file_.write(source, count * block_size);
+
+	// Keep the read-ahead buffer coherent.
+	const size_t read_ahead_end = read_ahead_address_ + read_ahead_.size() / block_size;
+	const size_t start = std::max(source_address, read_ahead_address_);
+	const size_t end = std::min(source_address + count, read_ahead_end);
+	if(start < end) {
+		std::memcpy(&read_ahead_[(start - read_ahead_address_) * block_size], &source[(start - source_address) * block_size], (end - start) * block_size);
+	}
+}
+
 void HFV::set_drive_type(Encodings::Macintosh::DriveType drive_type) {
-	mapper_.set_drive_type(drive_type, size_t(file_.stats().st_size) / get_block_size());
+	mapper_.set_drive_type(drive_type, file_blocks_);
 }
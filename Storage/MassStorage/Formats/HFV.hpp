@@ -41,11 +41,27 @@ class HFV: public MassStorageDevice, public Encodings::Macintosh::Volume {
 		size_t get_number_of_blocks() final;
 		std::vector<uint8_t> get_block(size_t address) final;
 		void set_block(size_t address, const std::vector<uint8_t> &) final;
+		void get_blocks(size_t address, size_t count, uint8_t *target) final;
+		void set_blocks(size_t address, size_t count, const uint8_t *source) final;
 
 		/* Encodings::Macintosh::Volume overrides. */
 		void set_drive_type(Encodings::Macintosh::DriveType) final;
 
 		std::map<size_t, std::vector<uint8_t>> writes_;
+
+		// The number of blocks in the file; blocks beyond this are held in writes_.
+		size_t file_blocks_ = 0;
+		bool is_in_file(ssize_t source_address) const;
+
+		// Transfers @c count blocks from or to the file, starting at @c source_address.
+		void read(size_t source_address, size_t count, uint8_t *target);
+		void write(size_t source_address, size_t count, const uint8_t *source);
+
+		// Sequential reads are served from a read-ahead buffer of up to ReadAheadBlocks blocks.
+		static constexpr size_t ReadAheadBlocks = 64;
+		std::vector<uint8_t> read_ahead_;
+		size_t read_ahead_address_ = 0;
+		size_t next_sequential_address_ = 0;
 };
 
 }
@@ -7,3 +7,31 @@
 //
 
 #include "MassStorageDevice.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Storage::MassStorage;
+
+void MassStorageDevice::get_blocks(size_t address, size_t count, uint8_t *target) {
+	const size_t block_size = get_block_size();
+	while(count--) {
+		const auto block = get_block(address);
+		const size_t length = std::min(block.size(), block_size);
+		std::memcpy(target, block.data(), length);
+		std::memset(&target[length], 0, block_size - length);
+
+		++address;
+		target += block_size;
+	}
+}
+
+void MassStorageDevice::set_blocks(size_t address, size_t count, const uint8_t *source) {
+	const size_t block_size = get_block_size();
+	while(count--) {
+		set_block(address, std::vector<uint8_t>(source, source + block_size));
+
+		++address;
+		source += block_size;
+	}
+}
@@ -53,6 +53,24 @@ class MassStorageDevice {
 			Sets new contents for the block at @c address.
 		*/
 		virtual void set_block(size_t address, const std::vector<uint8_t> &) {}
+
+		/*!
+			Copies the current contents of the @c count blocks starting at @c address
+			to @c target, which should have room for @c count * get_block_size() bytes.
+
+			The default implementation makes a call to @c get_block for each block;
+			devices that can fetch a contiguous range more efficiently should override it.
+		*/
+		virtual void get_blocks(size_t address, size_t count, uint8_t *target);
+
+		/*!
+			Sets new contents for the @c count blocks starting at @c address
+			from the @c count * get_block_size() bytes at @c source.
+
+			The default implementation makes a call to @c set_block for each block;
+			devices that can store a contiguous range more efficiently should override it.
+		*/
+		virtual void set_blocks(size_t address, size_t count, const uint8_t *source);
 };
 
 }
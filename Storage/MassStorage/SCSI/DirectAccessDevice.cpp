@@ -9,6 +9,8 @@
 #include "DirectAccessDevice.hpp"
 #include "../../../Outputs/Log.hpp"
 
+#include <algorithm>
+
 using namespace SCSI;
 
 void DirectAccessDevice::set_storage(const std::shared_ptr<Storage::MassStorage::MassStorageDevice> &device) {
@@ -21,11 +23,8 @@ bool DirectAccessDevice::read(const Target::CommandState &state, Target::Respond
 	const auto specs = state.read_write_specs();
 	LOG("Read: " << specs.number_of_blocks << " from " << specs.address);
 
-	std::vector<uint8_t> output = device_->get_block(specs.address);
-	for(uint32_t offset = 1; offset < specs.number_of_blocks; ++offset) {
-		const auto next_block = device_->get_block(specs.address + offset);
-		std::copy(next_block.begin(), next_block.end(), std::back_inserter(output));
-	}
+	std::vector<uint8_t> output(device_->get_block_size() * specs.number_of_blocks);
+	device_->get_blocks(specs.address, specs.number_of_blocks, output.data());
 
 	responder.send_data(std::move(output), [] (const Target::CommandState &state, Target::Responder &responder) {
 		responder.terminate_command(Target::Responder::Status::Good);
@@ -40,13 +39,9 @@ bool DirectAccessDevice::write(const Target::CommandState &state, Target::Respon
 	const auto specs = state.read_write_specs();
 
 	responder.receive_data(device_->get_block_size() * specs.number_of_blocks, [this, specs] (const Target::CommandState &state, Target::Responder &responder) {
-		const auto received_data = state.received_data();
-		const auto block_size = ssize_t(device_->get_block_size());
-		for(uint32_t offset = 0; offset < specs.number_of_blocks; ++offset) {
-			// TODO: clean up this gross inefficiency when std::span is standard.
-			std::vector<uint8_t> sub_vector(received_data.begin() + ssize_t(offset)*block_size, received_data.begin() + ssize_t(offset+1)*block_size);
-			this->device_->set_block(specs.address + offset, sub_vector);
-		}
+		const auto &received_data = state.received_data();
+		const size_t number_of_blocks = std::min(size_t(specs.number_of_blocks), received_data.size() / this->device_->get_block_size());
+		this->device_->set_blocks(specs.address, number_of_blocks, received_data.data());
 		responder.terminate_command(Target::Responder::Status::Good);
 	});
 
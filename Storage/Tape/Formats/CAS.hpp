@@ -35,12 +35,10 @@ class CAS: public Tape {
 			ErrorNotCAS
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		bool virtual_is_at_end();
 
 		// Storage for the array of data blobs to transcribe into audio;
 		// each chunk is preceded by a header which may be long, and is optionally
@@ -84,11 +84,14 @@ CSW::CSW(const std::string &file_name) :
 	}
 
 	invert_pulse();
+	initial_type_ = pulse_.type;
 }
 
-CSW::CSW(const std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate) {
+CSW::CSW(const std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate) :
+	source_data_pointer_(0) {
 	pulse_.length.clock_rate = sampling_rate;
 	pulse_.type = initial_level ? Pulse::High : Pulse::Low;
+	initial_type_ = pulse_.type;
 	source_data_ = std::move(data);
 }
 
@@ -114,12 +117,15 @@ void CSW::invert_pulse() {
 	pulse_.type = (pulse_.type == Pulse::High) ? Pulse::Low : Pulse::High;
 }
 
-bool CSW::is_at_end() {
+bool CSW::virtual_is_at_end() {
 	return source_data_pointer_ == source_data_.size();
 }
 
 void CSW::virtual_reset() {
 	source_data_pointer_ = 0;
+
+	// Pulses may have been read ahead of the reset point, so the level can't be assumed to be where it started.
+	pulse_.type = initial_type_;
 }
 
 Tape::Pulse CSW::virtual_get_next_pulse() {
@@ -128,3 +134,12 @@ Tape::Pulse CSW::virtual_get_next_pulse() {
 	if(!pulse_.length.length) pulse_.length.length = get_next_int32le();
 	return pulse_;
 }
+
+size_t CSW::virtual_get_next_pulses(Pulse *pulses, size_t maximum) {
+	size_t count = 0;
+	do {
+		pulses[count] = CSW::virtual_get_next_pulse();
+		++count;
+	} while(count < maximum && source_data_pointer_ != source_data_.size());
+	return count;
+}
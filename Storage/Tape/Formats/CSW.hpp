@@ -44,14 +44,14 @@ class CSW: public Tape {
 			ErrorNotCSW
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		bool virtual_is_at_end();
+		size_t virtual_get_next_pulses(Pulse *pulses, size_t maximum);
 
 		Pulse pulse_;
+		Pulse::Type initial_type_;
 		CompressionType compression_type_;
 
 		uint8_t get_next_byte();
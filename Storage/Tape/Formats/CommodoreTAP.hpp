@@ -34,13 +34,11 @@ class CommodoreTAP: public Tape {
 			ErrorNotCommodoreTAP
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		Storage::FileHolder file_;
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		bool virtual_is_at_end();
 
 		bool updated_layout_;
 		uint32_t file_size_;
@@ -148,6 +148,6 @@ Tape::Pulse OricTAP::virtual_get_next_pulse() {
 	return pulse;
 }
 
-bool OricTAP::is_at_end() {
+bool OricTAP::virtual_is_at_end() {
 	return phase_ == End;
 }
@@ -34,13 +34,11 @@ class OricTAP: public Tape {
 			ErrorNotOricTAP
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		Storage::FileHolder file_;
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		bool virtual_is_at_end();
 
 		// byte serialisation and output
 		uint16_t current_value_;
@@ -35,12 +35,10 @@ class PRG: public Tape {
 			ErrorBadFormat
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		FileHolder file_;
 		Pulse virtual_get_next_pulse();
+		bool virtual_is_at_end();
 		void virtual_reset();
 
 		uint16_t load_address_;
@@ -46,7 +46,7 @@ bool ZX80O81P::has_finished_data() {
 	return (data_pointer_ == data_.size()) && !wave_pointer_ && !bit_pointer_;
 }
 
-bool ZX80O81P::is_at_end() {
+bool ZX80O81P::virtual_is_at_end() {
 	return has_finished_data() && has_ended_final_byte_;
 }
 
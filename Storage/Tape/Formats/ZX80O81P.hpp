@@ -39,7 +39,7 @@ class ZX80O81P: public Tape, public TargetPlatform::TypeDistinguisher {
 
 	private:
 		// implemented to satisfy @c Tape
-		bool is_at_end();
+		bool virtual_is_at_end();
 
 		// implemented to satisfy TargetPlatform::TypeDistinguisher
 		TargetPlatform::Type target_platform_type();
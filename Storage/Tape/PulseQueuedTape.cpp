@@ -8,11 +8,13 @@
 
 #include "PulseQueuedTape.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Tape;
 
 PulseQueuedTape::PulseQueuedTape() : pulse_pointer_(0), is_at_end_(false) {}
 
-bool PulseQueuedTape::is_at_end() {
+bool PulseQueuedTape::virtual_is_at_end() {
 	return is_at_end_;
 }
 
@@ -63,3 +65,17 @@ Tape::Pulse PulseQueuedTape::virtual_get_next_pulse() {
 	pulse_pointer_++;
 	return queued_pulses_[read_pointer];
 }
+
+size_t PulseQueuedTape::virtual_get_next_pulses(Pulse *pulses, size_t maximum) {
+	// Supply whatever is already queued en bloc; refills and the end of the tape
+	// are left to the one-at-a-time path.
+	if(!is_at_end_ && pulse_pointer_ < queued_pulses_.size()) {
+		const std::size_t count = std::min(maximum, queued_pulses_.size() - pulse_pointer_);
+		std::copy(&queued_pulses_[pulse_pointer_], &queued_pulses_[pulse_pointer_] + count, pulses);
+		pulse_pointer_ += count;
+		return count;
+	}
+
+	pulses[0] = virtual_get_next_pulse();
+	return 1;
+}
@@ -28,7 +28,6 @@ namespace Tape {
 class PulseQueuedTape: public Tape {
 	public:
 		PulseQueuedTape();
-		bool is_at_end();
 
 	protected:
 		void emplace_back(Tape::Pulse::Type type, Time length);
@@ -41,6 +40,8 @@ class PulseQueuedTape: public Tape {
 
 	private:
 		Pulse virtual_get_next_pulse();
+		size_t virtual_get_next_pulses(Pulse *pulses, size_t maximum);
+		bool virtual_is_at_end();
 		Pulse silence();
 
 		std::vector<Pulse> queued_pulses_;
@@ -40,13 +40,17 @@ Storage::Time Tape::get_current_time() {
 
 void Storage::Tape::Tape::reset() {
 	offset_ = 0;
+	buffer_pointer_ = buffer_length_ = 0;
 	virtual_reset();
 }
 
-Tape::Pulse Tape::get_next_pulse() {
-	pulse_ = virtual_get_next_pulse();
-	offset_++;
-	return pulse_;
+size_t Tape::virtual_get_next_pulses(Pulse *pulses, size_t maximum) {
+	size_t count = 0;
+	do {
+		pulses[count] = virtual_get_next_pulse();
+		++count;
+	} while(count < maximum && !virtual_is_at_end());
+	return count;
 }
 
 uint64_t Tape::get_offset() {
@@ -29,6 +29,9 @@ namespace Tape {
 	Subclasses should implement at least @c get_next_pulse and @c reset to provide a serial feeding
 	of pulses and the ability to return to the start of the feed. They may also implement @c seek if
 	a better implementation than a linear search from the @c reset time can be implemented.
+
+	Pulses are requested from subclasses in blocks, which subclasses may supply natively via
+	@c virtual_get_next_pulses; they are then handed out singly, without further virtual calls.
 */
 class Tape {
 	public:
@@ -48,13 +51,24 @@ class Tape {
 
 			@returns the pulse that begins at the current cursor position.
 		*/
-		Pulse get_next_pulse();
+		Pulse get_next_pulse() {
+			if(buffer_pointer_ == buffer_length_) {
+				buffer_length_ = virtual_get_next_pulses(buffer_, BufferSize);
+				buffer_pointer_ = 0;
+			}
+			pulse_ = buffer_[buffer_pointer_];
+			++buffer_pointer_;
+			++offset_;
+			return pulse_;
+		}
 
 		/// Returns the tape to the beginning.
 		void reset();
 
 		/// @returns @c true if the tape has progressed beyond all recorded content; @c false otherwise.
-		virtual bool is_at_end() = 0;
+		bool is_at_end() {
+			return buffer_pointer_ == buffer_length_ && virtual_is_at_end();
+		}
 
 		/*!
 			Returns a numerical representation of progression into the tape. Precision is arbitrary but
@@ -81,11 +95,26 @@ class Tape {
 		virtual ~Tape() {};
 
 	private:
-		uint64_t offset_;
+		uint64_t offset_ = 0;
 		Tape::Pulse pulse_;
 
+		static constexpr size_t BufferSize = 256;
+		Pulse buffer_[BufferSize];
+		size_t buffer_pointer_ = 0, buffer_length_ = 0;
+
 		virtual Pulse virtual_get_next_pulse() = 0;
+		virtual bool virtual_is_at_end() = 0;
 		virtual void virtual_reset() = 0;
+
+		/*!
+			Supplies up to @c maximum pulses in @c pulses, stopping early only if the tape reaches its end.
+			At least one pulse should always be supplied, even if the tape is already at its end.
+
+			The default implementation repeatedly calls @c virtual_get_next_pulse; subclasses may be able to do better.
+
+			@returns The number of pulses supplied.
+		*/
+		virtual size_t virtual_get_next_pulses(Pulse *pulses, size_t maximum);
 };
 
 /*!